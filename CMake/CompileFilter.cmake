@@ -11,6 +11,10 @@ macro(current_config_compile_filter SRC_LIST INC_DIR SRC_DIR)
 		file(GLOB_RECURSE OS_SRC_LIST
 			"${SRC_DIR}/Platform/WinAPI/*.cpp"
 			"${INC_DIR}/Platform/WinAPI/*.h")
+	elseif(${ZE_PLATFORM_LINUX})
+		file(GLOB_RECURSE OS_SRC_LIST
+			"${SRC_DIR}/Platform/Linux/*.cpp"
+			"${INC_DIR}/Platform/Linux/*.h")
 	else()
 		message(FATAL_ERROR "Building for unsupported platform!")
 	endif()
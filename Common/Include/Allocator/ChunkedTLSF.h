@@ -1,7 +1,9 @@
 #pragma once
 #include "Pool.h"
 #include "Intrinsics.h"
+#include <algorithm>
 #include <bitset>
+#include <vector>
 
 // Helper template header for ChunkedTLSF methods (Warning! Causes problems with auto formatters)
 #define ZE_CHUNKED_TLSF_TEMPLATE template<typename Memory, U8 SECOND_LEVEL_INDEX, U8 MEMORY_CLASS_SHIFT>
@@ -26,6 +28,24 @@ namespace ZE::Allocator
 		static void DestroyMemory(TLSFMemoryChunk* chunk, void* userData) noexcept { typename Memory::Destroy(chunk->MemChunk, userData); }
 	};
 
+	// Statistics of single memory chunk used to decide when defragmentation is needed, all sizes are in bytes
+	struct TLSFChunkStats
+	{
+		U64 Size = 0;
+		U64 FreeSize = 0;
+		U64 LargestFreeBlock = 0;
+		U32 AllocationCount = 0;
+
+		constexpr float GetFreeRatio() const noexcept { return Size ? static_cast<float>(FreeSize) / static_cast<float>(Size) : 0.0f; }
+	};
+
+	// Relocation of single allocation proposed by defragmentation, contents of source have to be copied into destination
+	struct TLSFDefragMove
+	{
+		AllocHandle Source;
+		AllocHandle Destination;
+	};
+
 	// TLSF algorithm with distinction between regions of memory (chunk) that aren't continuous in adress space.
 	// According to original paper, SECOND_LEVEL_INDEX should be preferable 4 or 5.
 	// To avoid over-division of adress space, MEMORY_CLASS_SHIFT controls the max size that segregates memory region to first "memory class" (bucket for memory blocks)
@@ -99,6 +119,8 @@ namespace ZE::Allocator
 		void RemoveFreeBlock(Block* block) noexcept;
 		void InsertFreeBlock(Block* block) noexcept;
 		void MergeBlock(Block* block, Block* prev) noexcept;
+		// Finds free block that can hold allocation outside of given chunk, without using completely empty chunks
+		Block* FindMoveDestination(U64 size, U64 alignment, const TLSFMemoryChunk<Memory>* excludedChunk) noexcept;
 
 	public:
 		constexpr ChunkedTLSF(BlockAllocator& blockAllocator, ChunkAllocator& chunkAllocator, bool singleChunk = false) noexcept
@@ -127,6 +149,15 @@ namespace ZE::Allocator
 		void Free(AllocHandle allocation, void* memoryUserData) noexcept;
 		// Delete allocated chunks not used by any allocation (only by null block), required to call before destruction of allocator
 		void DestroyFreeChunks(void* memoryUserData) noexcept;
+
+		// Gathers usage of every created chunk in order of their creation
+		void GetChunkStats(std::vector<TLSFChunkStats>& stats) const noexcept;
+		// Proposes moves of allocations out of the least used chunk into free space of other chunks so it can be released later.
+		// Moved data is limited by maxBytes, new placement preserves alignment of old one up to maxAlignment (in chunk granularity units).
+		// Destination blocks are already allocated, returns false when there is nothing to compact
+		bool Defragment(U64 maxBytes, U64 maxAlignment, std::vector<TLSFDefragMove>& moves) noexcept;
+		// Frees source blocks of all moves after their contents have been copied and users switched to destination allocations
+		void CommitDefragmentation(const std::vector<TLSFDefragMove>& moves, void* memoryUserData) noexcept;
 	};
 
 #pragma region Functions
@@ -170,6 +201,9 @@ namespace ZE::Allocator
 		if (memoryClass == 0)
 			return Utils::SafeCast<U16>(((size - 1) * firstListSize) / SMALL_BUFFER_SIZE);
 
+		// Lowest memory classes can hold less sizes than there are second level lists (when MEMORY_CLASS_SHIFT < SECOND_LEVEL_INDEX)
+		if (memoryClass + MEMORY_CLASS_SHIFT < SECOND_LEVEL_INDEX)
+			return Utils::SafeCast<U16>((size << (SECOND_LEVEL_INDEX - MEMORY_CLASS_SHIFT - memoryClass)) ^ (1U << SECOND_LEVEL_INDEX));
 		return Utils::SafeCast<U16>((size >> (memoryClass + MEMORY_CLASS_SHIFT - SECOND_LEVEL_INDEX)) ^ (1U << SECOND_LEVEL_INDEX));
 	}
 
@@ -405,6 +439,31 @@ namespace ZE::Allocator
 		blockAllocator.Free(prev);
 	}
 
+	ZE_CHUNKED_TLSF_TEMPLATE
+	typename ZE_CHUNKED_TLSF_TYPE::Block* ZE_CHUNKED_TLSF_TYPE::FindMoveDestination(U64 size, U64 alignment, const TLSFMemoryChunk<Memory>* excludedChunk) noexcept
+	{
+		U32 listIndex = 0;
+		Block* block = FindFreeBlock(size, listIndex);
+		if (block)
+		{
+			// Every list starting from first one that can hold the size is checked since blocks can belong to excluded chunk
+			do
+			{
+				for (; block; block = block->NextFree)
+					if (block->ChunkHandle != excludedChunk && block->Size != chunkSize && CheckBlock(*block, size, alignment))
+						return block;
+
+				while (++listIndex < listsCount && freeList[listIndex] == nullptr);
+				if (listIndex < listsCount)
+					block = freeList[listIndex];
+			} while (listIndex < listsCount);
+		}
+
+		if (nullBlock->ChunkHandle && nullBlock->ChunkHandle != excludedChunk && nullBlock->Size != chunkSize && CheckBlock(*nullBlock, size, alignment))
+			return nullBlock;
+		return nullptr;
+	}
+
 	ZE_CHUNKED_TLSF_TEMPLATE
 	constexpr ZE_CHUNKED_TLSF_TYPE::~ChunkedTLSF()
 	{
@@ -559,9 +618,11 @@ namespace ZE::Allocator
 			MergeBlock(block, prev);
 		}
 
-		if (!next->IsFree())
+		// Last block of the chunk cannot be merged with free block starting next chunk
+		Ptr<Block> freeBlock = block;
+		if (!next->IsFree() || next->ChunkHandle != block->ChunkHandle)
 			InsertFreeBlock(block);
-		else if (next->ChunkHandle == block->ChunkHandle)
+		else
 		{
 			if (next == nullBlock)
 				MergeBlock(nullBlock, block);
@@ -571,44 +632,56 @@ namespace ZE::Allocator
 				MergeBlock(next, block);
 				InsertFreeBlock(next);
 			}
-			if (!IsSingleChunk())
+			freeBlock = next;
+		}
+
+		// Check if chunk can be destroyed, freed block can span whole chunk also when it was the last one in it
+		if (!IsSingleChunk() && freeBlock->Size == chunkSize)
+		{
+			if (IsFreeChunk())
 			{
-				// Check if chunk can be destroyed
-				if (next->Size == chunkSize)
+				TLSFMemoryChunk<Memory>::DestroyMemory(freeBlock->ChunkHandle, memoryUserData);
+				chunkAllocator.Free(freeBlock->ChunkHandle);
+				freeBlock->ChunkHandle = nullptr;
+
+				// Previous block could have been merged already, use last block of previous chunk instead
+				Block* prevChunkEnd = freeBlock->PrevPhysical;
+
+				// Delete whole block
+				if (prevChunkEnd)
+					prevChunkEnd->NextPhysical = freeBlock->NextPhysical;
+				if (freeBlock->NextPhysical)
+					freeBlock->NextPhysical->PrevPhysical = prevChunkEnd;
+
+				// Setup new null block
+				if (freeBlock == nullBlock)
 				{
-					if (IsFreeChunk())
+					ZE_ASSERT(prevChunkEnd, "Trying to remove chunk when there is no more left!");
+
+					if (prevChunkEnd->IsFree())
 					{
-						TLSFMemoryChunk<Memory>::DestroyMemory(next->ChunkHandle, memoryUserData);
-						chunkAllocator.Free(next->ChunkHandle);
-						next->ChunkHandle = nullptr;
-
-						// Delete whole block
-						if (prev)
-							prev->NextPhysical = next->NextPhysical;
-						if (next->NextPhysical)
-							next->NextPhysical->PrevPhysical = prev;
-
-						// Setup new null block
-						if (next == nullBlock)
-						{
-							ZE_ASSERT(prev, "Trying to remove chunk when there is no more left!");
-
-							if (prev->IsFree())
-							{
-								RemoveFreeBlock(prev);
-								nullBlock = prev;
-							}
-							else
-							{
-								nullBlock->Size = 0;
-								nullBlock->ChunkHandle = prev->ChunkHandle;
-							}
-						}
+						RemoveFreeBlock(prevChunkEnd);
+						nullBlock = prevChunkEnd;
+						nullBlock->MarkFree();
+						blockAllocator.Free(freeBlock);
 					}
 					else
-						SetFreeChunk(true);
+					{
+						nullBlock->Offset = prevChunkEnd->Offset + prevChunkEnd->Size;
+						nullBlock->Size = 0;
+						nullBlock->ChunkHandle = prevChunkEnd->ChunkHandle;
+						prevChunkEnd->NextPhysical = nullBlock;
+					}
+				}
+				else
+				{
+					// Whole chunk have been inserted into free list already
+					RemoveFreeBlock(freeBlock);
+					blockAllocator.Free(freeBlock);
 				}
 			}
+			else
+				SetFreeChunk(true);
 		}
 	}
 
@@ -622,6 +695,112 @@ namespace ZE::Allocator
 			nullBlock->ChunkHandle = nullptr;
 		}
 	}
+
+	ZE_CHUNKED_TLSF_TEMPLATE
+	void ZE_CHUNKED_TLSF_TYPE::GetChunkStats(std::vector<TLSFChunkStats>& stats) const noexcept
+	{
+		stats.clear();
+		if (chunkSizeDivisor == 0)
+			return;
+
+		// Blocks of all chunks are kept in single physical list ending with null block
+		const TLSFMemoryChunk<Memory>* chunk = nullptr;
+		for (const Block* block = nullBlock; block; block = block->PrevPhysical)
+		{
+			if (block->ChunkHandle == nullptr)
+				continue;
+
+			if (block->ChunkHandle != chunk)
+			{
+				chunk = block->ChunkHandle;
+				stats.emplace_back().Size = GetChunkSize();
+			}
+			TLSFChunkStats& chunkStats = stats.back();
+			if (block->IsFree())
+			{
+				const U64 size = block->Size * chunkSizeDivisor;
+				chunkStats.FreeSize += size;
+				chunkStats.LargestFreeBlock = std::max(chunkStats.LargestFreeBlock, size);
+			}
+			else
+				++chunkStats.AllocationCount;
+		}
+		std::reverse(stats.begin(), stats.end());
+	}
+
+	ZE_CHUNKED_TLSF_TEMPLATE
+	bool ZE_CHUNKED_TLSF_TYPE::Defragment(U64 maxBytes, U64 maxAlignment, std::vector<TLSFDefragMove>& moves) noexcept
+	{
+		ZE_ASSERT(Math::IsPower2(maxAlignment), "Alignment have to be power of 2!");
+
+		moves.clear();
+		if (IsSingleChunk() || chunkSizeDivisor == 0)
+			return false;
+
+		// Select chunk with least amount of used memory that could fit into other chunks
+		const TLSFMemoryChunk<Memory>* sourceChunk = nullptr;
+		U64 sourceUsed = UINT64_MAX;
+		U64 chunkUsed = 0;
+		U64 totalFree = 0;
+		U32 chunkCount = 0;
+		for (const Block* block = nullBlock; block; block = block->PrevPhysical)
+		{
+			if (block->ChunkHandle == nullptr)
+				continue;
+
+			if (!block->IsFree())
+				chunkUsed += block->Size;
+
+			// Block starting the chunk, whole chunk have been already visited.
+			// Completely empty chunks are skipped since moving data into them doesn't release any memory
+			if (block->Offset == 0 && chunkUsed)
+			{
+				totalFree += chunkSize - chunkUsed;
+				if (chunkUsed < sourceUsed)
+				{
+					sourceUsed = chunkUsed;
+					sourceChunk = block->ChunkHandle;
+				}
+				chunkUsed = 0;
+				++chunkCount;
+			}
+		}
+		if (chunkCount < 2 || sourceUsed > totalFree - (chunkSize - sourceUsed))
+			return false;
+
+		// Gather allocations first since creating destinations changes physical list
+		std::vector<Block*> sourceBlocks;
+		for (Block* block = nullBlock; block; block = block->PrevPhysical)
+			if (block->ChunkHandle == sourceChunk && !block->IsFree())
+				sourceBlocks.emplace_back(block);
+
+		U64 movedBytes = 0;
+		for (auto it = sourceBlocks.rbegin(); it != sourceBlocks.rend(); ++it)
+		{
+			Block* source = *it;
+			const U64 size = source->Size * chunkSizeDivisor;
+			if (movedBytes + size > maxBytes)
+				break;
+
+			// Keep at least the same alignment as current placement guarantees
+			const U64 alignment = source->Offset ? std::min(maxAlignment, source->Offset & (~source->Offset + 1)) : maxAlignment;
+			Block* destination = FindMoveDestination(source->Size, alignment, sourceChunk);
+			if (destination == nullptr)
+				break;
+
+			moves.emplace_back(source, CreateAlloc(destination, source->Size, alignment));
+			movedBytes += size;
+		}
+		return moves.size() != 0;
+	}
+
+	ZE_CHUNKED_TLSF_TEMPLATE
+	void ZE_CHUNKED_TLSF_TYPE::CommitDefragmentation(const std::vector<TLSFDefragMove>& moves, void* memoryUserData) noexcept
+	{
+		// When source chunk becomes empty it is released the same way as during regular free
+		for (const TLSFDefragMove& move : moves)
+			Free(move.Source, memoryUserData);
+	}
 #pragma endregion
 }
 
@@ -0,0 +1,337 @@
+#pragma once
+#include "ChunkedTLSF.h"
+#include <array>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Helper template header for ConcurrentTLSF methods (Warning! Causes problems with auto formatters)
+#define ZE_CONCURRENT_TLSF_TEMPLATE template<typename Memory, U8 SECOND_LEVEL_INDEX, U8 MEMORY_CLASS_SHIFT>
+// Helper template type for ConcurrentTLSF methods and inner types (Warning! Causes problems with auto formatters)
+#define ZE_CONCURRENT_TLSF_TYPE ConcurrentTLSF<Memory, SECOND_LEVEL_INDEX, MEMORY_CLASS_SHIFT>
+
+namespace ZE::Allocator
+{
+	// Thread-safe front-end for ChunkedTLSF. Small allocations are rounded up to size classes (4 steps between every power of 2)
+	// and every thread keeps magazines of recently freed blocks for each class, locked TLSF core is used only
+	// when magazine is empty (or full on free) and for bigger allocations. Blocks cached by exited threads are returned
+	// to the core during next locked operation and their slots are reused by new threads.
+	// Since block and chunk pools can be shared between multiple allocators, lock guarding them is passed from outside
+	template<typename Memory, U8 SECOND_LEVEL_INDEX = 5, U8 MEMORY_CLASS_SHIFT = 7>
+	class ConcurrentTLSF final
+	{
+		typedef ChunkedTLSF<Memory, SECOND_LEVEL_INDEX, MEMORY_CLASS_SHIFT> Core;
+
+	public:
+		typedef typename Core::BlockAllocator BlockAllocator;
+		typedef typename Core::ChunkAllocator ChunkAllocator;
+
+	private:
+		// Biggest allocation in bytes that goes through thread caches
+		static constexpr U64 MAX_CACHED_SIZE = 64 * 1024;
+		// Every power of 2 is divided into 4 size classes so rounding wastes at most 25% of allocation
+		static constexpr U8 SIZE_CLASS_STEPS = 4;
+		static constexpr U8 MAX_SIZE_CLASSES = 64;
+		static constexpr U32 MAGAZINE_SIZE = 16;
+		// Threads above this limit always use core allocator
+		static constexpr U32 MAX_CACHED_THREADS = 64;
+
+		struct Magazine
+		{
+			U32 Count = 0;
+			std::array<AllocHandle, MAGAZINE_SIZE> Blocks;
+		};
+		// Accessed only by owning thread (or under core lock after it exits), aligned to avoid false sharing
+		struct alignas(64) ThreadCache
+		{
+			// Set when owning thread exits, cache can be then flushed by any thread holding core lock
+			BoolAtom Orphaned = false;
+			std::array<Magazine, MAX_SIZE_CLASSES> Magazines;
+		};
+		// Slot of the thread in caches of every allocator, released on thread exit
+		struct ThreadSlot
+		{
+			U32 Index = UINT32_MAX;
+			// Caches created by this thread, kept alive even when allocator is destroyed first
+			std::vector<std::shared_ptr<ThreadCache>> Caches;
+
+			~ThreadSlot();
+		};
+
+		static inline std::mutex slotMutex;
+		static inline std::vector<U32> freeSlots;
+		static inline U32 slotCounter = 0;
+		// Number of exited threads that left some caches behind
+		static inline UA32 exitedThreads = 0;
+		static inline thread_local ThreadSlot threadSlot;
+
+		std::mutex& coreMutex;
+		Core core;
+		U8 sizeClasses = 0;
+		// Number of exited threads when orphaned caches have been checked for the last time, guarded by core lock
+		U32 reclaimedThreads = 0;
+		std::unique_ptr<std::shared_ptr<ThreadCache>[]> caches;
+
+		static constexpr U8 GetSizeClass(U64 units) noexcept;
+		static constexpr U64 GetSizeClassUnits(U8 sizeClass) noexcept;
+		static U32 GetThreadSlot() noexcept;
+
+		// Returns nullptr when allocations of given size are not cached
+		Magazine* GetMagazine(U64 allocSize, U8& sizeClass, void* memoryUserData) noexcept;
+		// Core lock have to be held by the caller
+		void FlushCache(ThreadCache& cache, void* memoryUserData) noexcept;
+		// Returns blocks from caches of exited threads to the core, core lock have to be held by the caller
+		void ReclaimOrphanedCaches(void* memoryUserData) noexcept;
+		// Cannot be called while other threads are using the allocator
+		void FlushAllCaches(void* memoryUserData) noexcept;
+
+	public:
+		ConcurrentTLSF(BlockAllocator& blockAllocator, ChunkAllocator& chunkAllocator, std::mutex& coreMutex, bool singleChunk = false) noexcept
+			: coreMutex(coreMutex), core(blockAllocator, chunkAllocator, singleChunk), caches(std::make_unique<std::shared_ptr<ThreadCache>[]>(MAX_CACHED_THREADS)) {}
+		ZE_CLASS_MOVE(ConcurrentTLSF);
+		~ConcurrentTLSF() = default;
+
+		// Size of cached allocations is reported as size of their class
+		constexpr U64 GetOffset(AllocHandle alloc) const noexcept { return core.GetOffset(alloc); }
+		constexpr U64 GetSize(AllocHandle alloc) const noexcept { return core.GetSize(alloc); }
+
+		constexpr U64 GetChunkSize() const noexcept { return core.GetChunkSize(); }
+		constexpr U32 GetChunkSizeGranularity() const noexcept { return core.GetChunkSizeGranularity(); }
+		constexpr TLSFMemoryChunkFlags GetChunkCreationFlags() const noexcept { return core.GetChunkCreationFlags(); }
+		// Blocks held in thread caches are not counted as free memory
+		U64 GetSumFreeMemory() const noexcept { std::lock_guard<std::mutex> lock(coreMutex); return core.GetSumFreeMemory(); }
+
+		constexpr Memory GetMemory(AllocHandle alloc) const noexcept { return core.GetMemory(alloc); }
+
+		// Same as ChunkedTLSF::Init(), have to be called before any other thread uses the allocator
+		void Init(TLSFMemoryChunkFlags memoryFlags, U64 initialChunkSize, U32 chunkSizeGranularity = 1, U8 firstListSizePower = 0, void* memoryUserData = nullptr);
+		AllocHandle Alloc(U64 allocSize, U64 alignment, void* memoryUserData);
+		void Free(AllocHandle allocation, void* memoryUserData) noexcept;
+		// Returns blocks cached by calling thread back to the core, ex. when streaming thread finishes it's work
+		void FlushThreadCache(void* memoryUserData) noexcept;
+		// Returns blocks from caches of all threads and deletes unused chunks, required to call before destruction of allocator.
+		// Cannot be called while other threads are using the allocator
+		void DestroyFreeChunks(void* memoryUserData) noexcept;
+
+		void GetChunkStats(std::vector<TLSFChunkStats>& stats) const noexcept { std::lock_guard<std::mutex> lock(coreMutex); core.GetChunkStats(stats); }
+		// Same as ChunkedTLSF::Defragment(), blocks cached by threads are returned to the core first so they are not moved.
+		// Cannot be called while other threads are using the allocator
+		bool Defragment(U64 maxBytes, U64 maxAlignment, std::vector<TLSFDefragMove>& moves, void* memoryUserData) noexcept;
+		void CommitDefragmentation(const std::vector<TLSFDefragMove>& moves, void* memoryUserData) noexcept { std::lock_guard<std::mutex> lock(coreMutex); core.CommitDefragmentation(moves, memoryUserData); }
+	};
+
+#pragma region Functions
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	ZE_CONCURRENT_TLSF_TYPE::ThreadSlot::~ThreadSlot()
+	{
+		// Blocks are returned by allocators themselves as only they know how to free memory of their chunks
+		for (std::shared_ptr<ThreadCache>& cache : Caches)
+			cache->Orphaned.store(true, std::memory_order_release);
+		if (Caches.size())
+			exitedThreads.fetch_add(1, std::memory_order_release);
+
+		if (Index < MAX_CACHED_THREADS)
+		{
+			std::lock_guard<std::mutex> lock(slotMutex);
+			freeSlots.emplace_back(Index);
+		}
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	constexpr U8 ZE_CONCURRENT_TLSF_TYPE::GetSizeClass(U64 units) noexcept
+	{
+		if (units <= SIZE_CLASS_STEPS)
+			return Utils::SafeCast<U8>(units - 1);
+
+		// Top 3 bits of size select class inside current power of 2
+		const U8 shift = Utils::SafeCast<U8>(std::bit_width(units - 1) - std::bit_width(SIZE_CLASS_STEPS));
+		return Utils::SafeCast<U8>(SIZE_CLASS_STEPS * shift + ((units - 1) >> shift));
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	constexpr U64 ZE_CONCURRENT_TLSF_TYPE::GetSizeClassUnits(U8 sizeClass) noexcept
+	{
+		if (sizeClass < SIZE_CLASS_STEPS)
+			return sizeClass + 1;
+		return static_cast<U64>(sizeClass % SIZE_CLASS_STEPS + SIZE_CLASS_STEPS + 1) << (sizeClass / SIZE_CLASS_STEPS - 1);
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	U32 ZE_CONCURRENT_TLSF_TYPE::GetThreadSlot() noexcept
+	{
+		ThreadSlot& slot = threadSlot;
+		if (slot.Index == UINT32_MAX)
+		{
+			std::lock_guard<std::mutex> lock(slotMutex);
+			if (freeSlots.size())
+			{
+				slot.Index = freeSlots.back();
+				freeSlots.pop_back();
+			}
+			else if (slotCounter < MAX_CACHED_THREADS)
+				slot.Index = slotCounter++;
+			else
+				slot.Index = MAX_CACHED_THREADS;
+		}
+		return slot.Index;
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	typename ZE_CONCURRENT_TLSF_TYPE::Magazine* ZE_CONCURRENT_TLSF_TYPE::GetMagazine(U64 allocSize, U8& sizeClass, void* memoryUserData) noexcept
+	{
+		sizeClass = GetSizeClass(Math::DivideRoundUp(allocSize, static_cast<U64>(core.GetChunkSizeGranularity())));
+		if (sizeClass >= sizeClasses)
+			return nullptr;
+
+		const U32 slot = GetThreadSlot();
+		if (slot >= MAX_CACHED_THREADS)
+			return nullptr;
+
+		// Only owning thread creates and uses it's cache, one left by previous owner of the slot is flushed first
+		std::shared_ptr<ThreadCache>& cache = caches[slot];
+		if (cache == nullptr || cache->Orphaned.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(coreMutex);
+			if (cache)
+				FlushCache(*cache, memoryUserData);
+			cache = std::make_shared<ThreadCache>();
+
+			// Forget caches of already destroyed allocators
+			std::erase_if(threadSlot.Caches, [](const std::shared_ptr<ThreadCache>& entry) { return entry.use_count() == 1; });
+			threadSlot.Caches.emplace_back(cache);
+		}
+		return &cache->Magazines.at(sizeClass);
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	void ZE_CONCURRENT_TLSF_TYPE::FlushCache(ThreadCache& cache, void* memoryUserData) noexcept
+	{
+		for (Magazine& magazine : cache.Magazines)
+		{
+			for (U32 i = 0; i < magazine.Count; ++i)
+				core.Free(magazine.Blocks.at(i), memoryUserData);
+			magazine.Count = 0;
+		}
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	void ZE_CONCURRENT_TLSF_TYPE::ReclaimOrphanedCaches(void* memoryUserData) noexcept
+	{
+		// Caches are checked only when some thread exited since last time
+		const U32 exited = exitedThreads.load(std::memory_order_acquire);
+		if (exited != reclaimedThreads)
+		{
+			reclaimedThreads = exited;
+			for (U32 i = 0; i < MAX_CACHED_THREADS; ++i)
+				if (caches[i] && caches[i]->Orphaned.load(std::memory_order_acquire))
+					FlushCache(*caches[i], memoryUserData);
+		}
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	void ZE_CONCURRENT_TLSF_TYPE::Init(TLSFMemoryChunkFlags memoryFlags, U64 initialChunkSize, U32 chunkSizeGranularity, U8 firstListSizePower, void* memoryUserData)
+	{
+		std::lock_guard<std::mutex> lock(coreMutex);
+		core.Init(memoryFlags, initialChunkSize, chunkSizeGranularity, firstListSizePower, memoryUserData);
+
+		// Classes start at size of single chunk and stop at maximal cached size
+		const U64 maxCachedUnits = MAX_CACHED_SIZE / chunkSizeGranularity;
+		if (maxCachedUnits)
+		{
+			U8 lastClass = GetSizeClass(maxCachedUnits);
+			if (GetSizeClassUnits(lastClass) > maxCachedUnits)
+				--lastClass;
+			sizeClasses = std::min(MAX_SIZE_CLASSES, static_cast<U8>(lastClass + 1));
+		}
+		else
+			sizeClasses = 0;
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	AllocHandle ZE_CONCURRENT_TLSF_TYPE::Alloc(U64 allocSize, U64 alignment, void* memoryUserData)
+	{
+		U8 sizeClass = 0;
+		Magazine* magazine = GetMagazine(allocSize, sizeClass, memoryUserData);
+
+		// Most recently freed block is checked first, offsets of blocks are in granularity units same as alignment
+		if (magazine && magazine->Count)
+		{
+			const AllocHandle block = magazine->Blocks.at(magazine->Count - 1);
+			if ((GetOffset(block) / core.GetChunkSizeGranularity()) % alignment == 0)
+			{
+				--magazine->Count;
+				return block;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(coreMutex);
+		ReclaimOrphanedCaches(memoryUserData);
+		if (magazine)
+			allocSize = GetSizeClassUnits(sizeClass) * core.GetChunkSizeGranularity();
+		return core.Alloc(allocSize, alignment, memoryUserData);
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	void ZE_CONCURRENT_TLSF_TYPE::Free(AllocHandle allocation, void* memoryUserData) noexcept
+	{
+		ZE_ASSERT(allocation, "Invalid allocation!");
+
+		// Only blocks with exact size of their class can be reused by the magazine
+		const U64 size = GetSize(allocation);
+		U8 sizeClass = 0;
+		Magazine* magazine = GetMagazine(size, sizeClass, memoryUserData);
+		if (magazine && magazine->Count < MAGAZINE_SIZE && size == GetSizeClassUnits(sizeClass) * core.GetChunkSizeGranularity())
+		{
+			magazine->Blocks.at(magazine->Count++) = allocation;
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(coreMutex);
+		ReclaimOrphanedCaches(memoryUserData);
+		core.Free(allocation, memoryUserData);
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	void ZE_CONCURRENT_TLSF_TYPE::FlushThreadCache(void* memoryUserData) noexcept
+	{
+		const U32 slot = GetThreadSlot();
+		if (slot < MAX_CACHED_THREADS && caches[slot])
+		{
+			std::lock_guard<std::mutex> lock(coreMutex);
+			FlushCache(*caches[slot], memoryUserData);
+		}
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	void ZE_CONCURRENT_TLSF_TYPE::FlushAllCaches(void* memoryUserData) noexcept
+	{
+		if (caches)
+		{
+			std::lock_guard<std::mutex> lock(coreMutex);
+			for (U32 i = 0; i < MAX_CACHED_THREADS; ++i)
+				if (caches[i])
+					FlushCache(*caches[i], memoryUserData);
+		}
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	void ZE_CONCURRENT_TLSF_TYPE::DestroyFreeChunks(void* memoryUserData) noexcept
+	{
+		FlushAllCaches(memoryUserData);
+		std::lock_guard<std::mutex> lock(coreMutex);
+		core.DestroyFreeChunks(memoryUserData);
+	}
+
+	ZE_CONCURRENT_TLSF_TEMPLATE
+	bool ZE_CONCURRENT_TLSF_TYPE::Defragment(U64 maxBytes, U64 maxAlignment, std::vector<TLSFDefragMove>& moves, void* memoryUserData) noexcept
+	{
+		FlushAllCaches(memoryUserData);
+		std::lock_guard<std::mutex> lock(coreMutex);
+		return core.Defragment(maxBytes, maxAlignment, moves);
+	}
+#pragma endregion
+}
+
+#undef ZE_CONCURRENT_TLSF_TEMPLATE
+#undef ZE_CONCURRENT_TLSF_TYPE
\ No newline at end of file
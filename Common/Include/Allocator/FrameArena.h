@@ -0,0 +1,192 @@
+#pragma once
+#include "MathExt.h"
+#include "Utils.h"
+#include <charconv>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ZE::Allocator
+{
+	// Linear allocator for transient data that lives only during single frame.
+	// Every thread takes it's own page and allocates from it without locking, pages are released all at once on Reset() and kept for next frames.
+	// Single thread should not interleave allocations from multiple arenas as it's current page is dropped on every switch
+	class FrameArena final
+	{
+		static constexpr U64 DEFAULT_PAGE_SIZE = 256ULL << 10;
+		static constexpr U64 PAGE_ALIGNMENT = 64;
+
+		struct Page
+		{
+			U8* Memory = nullptr;
+			U64 Size = 0;
+			// Written only by thread owning the page during current frame
+			U64 Used = 0;
+		};
+		// Page of the calling thread, valid only in the generation of arena it was taken from
+		struct ThreadCursor
+		{
+			U64 Generation;
+			Page* Current;
+		};
+
+		// Every arena receives unique generation after each reset so stale thread pages are never reused
+		static inline UA64 generationCounter = 0;
+		// Zero initialized, generation 0 is never assigned to any arena
+		static inline thread_local ThreadCursor cursor;
+
+		U64 pageSize;
+		U64 generation;
+		std::mutex pageMutex;
+		// Deque keeps pages in place when new ones are added while other threads are using theirs
+		std::deque<Page> pages;
+		U64 usedPages = 0;
+		U64 lastFrameUsage = 0;
+		U64 peakUsage = 0;
+
+		Page* AcquirePage(U64 minSize) noexcept;
+
+	public:
+		FrameArena(U64 pageSize = DEFAULT_PAGE_SIZE) noexcept : pageSize(pageSize), generation(++generationCounter) {}
+		ZE_CLASS_DELETE(FrameArena);
+		~FrameArena();
+
+		// Bytes allocated during last finished frame (including padding)
+		constexpr U64 GetLastFrameUsage() const noexcept { return lastFrameUsage; }
+		// Highest usage of single frame since creation of the arena
+		constexpr U64 GetPeakUsage() const noexcept { return peakUsage; }
+		// Bytes held by all pages of the arena
+		U64 GetCapacity() const noexcept;
+
+		// Returns memory valid till next call to Reset(), can be called from multiple threads
+		void* Alloc(U64 size, U64 alignment) noexcept;
+		// Allocates uninitialized array of trivial objects, no destructors are called on reset
+		template<typename T>
+		T* Alloc(U64 count) noexcept;
+		// Creates null terminated string consisting of prefix followed by number, ex. for debug tags of draw calls
+		std::string_view Concat(std::string_view prefix, U64 number) noexcept;
+		// Makes all allocations from previous frame invalid, cannot be called while other threads are allocating
+		void Reset() noexcept;
+	};
+
+	// Adapter for using frame arena with STL containers, memory is never returned before arena reset
+	template<typename T>
+	class FrameAllocator
+	{
+		template<typename U>
+		friend class FrameAllocator;
+
+		FrameArena* arena;
+
+	public:
+		typedef T value_type;
+
+		constexpr FrameAllocator(FrameArena& arena) noexcept : arena(&arena) {}
+		template<typename U>
+		constexpr FrameAllocator(const FrameAllocator<U>& allocator) noexcept : arena(allocator.arena) {}
+		ZE_CLASS_DEFAULT(FrameAllocator);
+		~FrameAllocator() = default;
+
+		T* allocate(U64 count) noexcept { return reinterpret_cast<T*>(arena->Alloc(sizeof(T) * count, alignof(T))); }
+		constexpr void deallocate(T* ptr, U64 count) noexcept {}
+
+		template<typename U>
+		constexpr bool operator==(const FrameAllocator<U>& allocator) const noexcept { return arena == allocator.arena; }
+	};
+
+	// Vector with memory valid only during current frame
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#pragma region Functions
+	inline FrameArena::Page* FrameArena::AcquirePage(U64 minSize) noexcept
+	{
+		std::lock_guard lock(pageMutex);
+
+		// Place first free page big enough to fit allocation at the end of used ones
+		U64 index = usedPages;
+		while (index < pages.size() && pages.at(index).Size < minSize)
+			++index;
+		if (index == pages.size())
+		{
+			Page& page = pages.emplace_back();
+			page.Size = Math::AlignUp(std::max(pageSize, minSize), PAGE_ALIGNMENT);
+			page.Memory = reinterpret_cast<U8*>(Utils::AlignedAlloc(page.Size, PAGE_ALIGNMENT));
+			ZE_ASSERT(page.Memory, "Cannot allocate new page for frame arena!");
+		}
+		if (index != usedPages)
+			std::swap(pages.at(index), pages.at(usedPages));
+		return &pages.at(usedPages++);
+	}
+
+	inline FrameArena::~FrameArena()
+	{
+		for (Page& page : pages)
+			Utils::AlignedFree(page.Memory);
+	}
+
+	inline U64 FrameArena::GetCapacity() const noexcept
+	{
+		U64 capacity = 0;
+		for (const Page& page : pages)
+			capacity += page.Size;
+		return capacity;
+	}
+
+	inline void* FrameArena::Alloc(U64 size, U64 alignment) noexcept
+	{
+		ZE_ASSERT(Math::IsPower2(alignment) && alignment <= PAGE_ALIGNMENT, "Incorrect alignment for frame arena allocation!");
+
+		ThreadCursor& local = cursor;
+		U64 offset = 0;
+		if (local.Generation == generation)
+			offset = Math::AlignUp(local.Current->Used, alignment);
+
+		// Rest of current page is skipped when allocation doesn't fit
+		if (local.Generation != generation || offset + size > local.Current->Size)
+		{
+			local.Generation = generation;
+			local.Current = AcquirePage(size);
+			offset = 0;
+		}
+		local.Current->Used = offset + size;
+		return local.Current->Memory + offset;
+	}
+
+	template<typename T>
+	T* FrameArena::Alloc(U64 count) noexcept
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "Frame arena cannot hold objects requiring destruction!");
+		return reinterpret_cast<T*>(Alloc(sizeof(T) * count, alignof(T)));
+	}
+
+	inline std::string_view FrameArena::Concat(std::string_view prefix, U64 number) noexcept
+	{
+		// Enough space for prefix, every digit of the number and null terminator
+		const U64 size = prefix.size() + 21;
+		char* str = reinterpret_cast<char*>(Alloc(size, 1));
+		std::memcpy(str, prefix.data(), prefix.size());
+
+		char* end = std::to_chars(str + prefix.size(), str + size - 1, number).ptr;
+		*end = '\0';
+		return { str, Utils::SafeCast<U64>(end - str) };
+	}
+
+	inline void FrameArena::Reset() noexcept
+	{
+		std::lock_guard lock(pageMutex);
+
+		lastFrameUsage = 0;
+		for (U64 i = 0; i < usedPages; ++i)
+		{
+			lastFrameUsage += pages.at(i).Used;
+			pages.at(i).Used = 0;
+		}
+		peakUsage = std::max(peakUsage, lastFrameUsage);
+		usedPages = 0;
+		generation = ++generationCounter;
+	}
+#pragma endregion
+}
\ No newline at end of file
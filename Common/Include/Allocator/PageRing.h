@@ -0,0 +1,152 @@
+#pragma once
+#include "MathExt.h"
+#include "Utils.h"
+#include <array>
+#include <bit>
+#include <memory>
+#include <mutex>
+
+namespace ZE::Allocator
+{
+	// Ring of fixed size pages with persistently mapped memory for data uploaded during single frame.
+	// Every thread reserves whole page with single atomic operation and then sub-allocates from it without any locking.
+	// Pages are created on demand and reused after Reset(), so every frame in flight should use separate ring
+	template<typename T, U32 PAGE_SIZE>
+	class PageRing final
+	{
+		// Pages are stored in segments of growing size that are never moved, so ring can grow while other threads access it
+		static constexpr U32 FIRST_SEGMENT_SIZE = 64;
+		static constexpr U32 MAX_SEGMENT_COUNT = 26;
+		// Number of pages left unused during frame that are still kept for later frames
+		static constexpr U32 PAGE_SHRINK_STEP = 2;
+
+		// Position of allocations made by single thread, valid only in the generation of ring it was created for
+		struct ThreadCursor
+		{
+			U64 Generation = 0;
+			U32 Page = 0;
+			U32 Offset = 0;
+		};
+		struct PageData
+		{
+			T Page;
+			U8* Memory = nullptr;
+		};
+
+		// Every ring receives unique generation after each reset so stale cursors are never reused
+		static inline UA64 generationCounter = 0;
+		static inline thread_local ThreadCursor cursor = {};
+
+		std::array<std::unique_ptr<PageData[]>, MAX_SEGMENT_COUNT> segments;
+		UA32 reservedPages = 0;
+		UA32 createdPages = 0;
+		std::mutex createMutex;
+		U64 generation;
+
+		static constexpr U32 GetSegment(U32 page) noexcept { return Utils::SafeCast<U32>(std::bit_width(page / FIRST_SEGMENT_SIZE + 1)) - 1; }
+		static constexpr U32 GetSegmentStart(U32 segment) noexcept { return FIRST_SEGMENT_SIZE * ((1U << segment) - 1); }
+
+		PageData& GetPageData(U32 page) const noexcept { const U32 segment = GetSegment(page); return segments[segment][page - GetSegmentStart(segment)]; }
+		template<typename CreateFunc>
+		U32 ReservePage(CreateFunc&& createPage);
+
+	public:
+		// Location of allocated data inside the ring
+		struct Allocation
+		{
+			U32 Page;
+			U32 Offset;
+		};
+
+		PageRing() noexcept : generation(++generationCounter) {}
+		ZE_CLASS_DELETE(PageRing);
+		~PageRing() { ZE_ASSERT_FREED(createdPages == 0); }
+
+		U32 GetPageCount() const noexcept { return createdPages.load(std::memory_order_acquire); }
+		const T& GetPage(U32 index) const noexcept { ZE_ASSERT(index < GetPageCount(), "Accessing page outside of the ring!"); return GetPageData(index).Page; }
+
+		// Copies data into current page of calling thread. When it doesn't have enough space then new page is reserved,
+		// creating it with createPage(T&) -> U8* returning mapped memory of the page if all existing ones are already in use
+		template<typename CreateFunc>
+		Allocation Alloc(const void* data, U32 bytes, U32 alignment, CreateFunc&& createPage);
+		// Invalidates all allocations and frees pages that were not needed during last frame with freePage(T&).
+		// Cannot be called while any other thread is allocating
+		template<typename FreeFunc>
+		void Reset(FreeFunc&& freePage) noexcept;
+		template<typename FreeFunc>
+		void Free(FreeFunc&& freePage) noexcept;
+	};
+
+#pragma region Functions
+	template<typename T, U32 PAGE_SIZE> template<typename CreateFunc>
+	U32 PageRing<T, PAGE_SIZE>::ReservePage(CreateFunc&& createPage)
+	{
+		const U32 page = reservedPages.fetch_add(1, std::memory_order_relaxed);
+		ZE_ASSERT(GetSegment(page) < MAX_SEGMENT_COUNT, "Exceeded maximal number of pages in the ring!");
+
+		// Only when ring have to grow other threads are blocked
+		if (page >= createdPages.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(createMutex);
+			for (U32 i = createdPages.load(std::memory_order_relaxed); i <= page; ++i)
+			{
+				// New segment is published together with first page created in it
+				const U32 segment = GetSegment(i);
+				if (segments[segment] == nullptr)
+					segments[segment] = std::make_unique<PageData[]>(FIRST_SEGMENT_SIZE << segment);
+
+				PageData& data = GetPageData(i);
+				data.Memory = createPage(data.Page);
+				createdPages.store(i + 1, std::memory_order_release);
+			}
+		}
+		return page;
+	}
+
+	template<typename T, U32 PAGE_SIZE> template<typename CreateFunc>
+	typename PageRing<T, PAGE_SIZE>::Allocation PageRing<T, PAGE_SIZE>::Alloc(const void* data, U32 bytes, U32 alignment, CreateFunc&& createPage)
+	{
+		ZE_ASSERT(bytes <= PAGE_SIZE, "Allocation too large for single page!");
+		ZE_ASSERT(Math::IsPower2(alignment), "Alignment have to be power of 2!");
+
+		ThreadCursor& local = cursor;
+		const U32 offset = Math::AlignUp(local.Offset, alignment);
+		Allocation alloc = { local.Page, offset };
+		if (local.Generation != generation || offset + bytes > PAGE_SIZE)
+		{
+			local.Generation = generation;
+			alloc = { ReservePage(std::forward<CreateFunc>(createPage)), 0 };
+			local.Page = alloc.Page;
+		}
+		local.Offset = alloc.Offset + bytes;
+
+		std::memcpy(GetPageData(alloc.Page).Memory + alloc.Offset, data, bytes);
+		return alloc;
+	}
+
+	template<typename T, U32 PAGE_SIZE> template<typename FreeFunc>
+	void PageRing<T, PAGE_SIZE>::Reset(FreeFunc&& freePage) noexcept
+	{
+		const U32 created = createdPages.load(std::memory_order_acquire);
+		const U32 used = std::min(reservedPages.load(std::memory_order_relaxed), created);
+		if (used + PAGE_SHRINK_STEP < created)
+		{
+			for (U32 i = used; i < created; ++i)
+				freePage(GetPageData(i).Page);
+			createdPages.store(used, std::memory_order_release);
+		}
+		reservedPages.store(0, std::memory_order_relaxed);
+		generation = ++generationCounter;
+	}
+
+	template<typename T, U32 PAGE_SIZE> template<typename FreeFunc>
+	void PageRing<T, PAGE_SIZE>::Free(FreeFunc&& freePage) noexcept
+	{
+		for (U32 i = 0, count = createdPages.load(std::memory_order_acquire); i < count; ++i)
+			freePage(GetPageData(i).Page);
+		createdPages.store(0, std::memory_order_release);
+		reservedPages.store(0, std::memory_order_relaxed);
+		generation = ++generationCounter;
+	}
+#pragma endregion
+}
\ No newline at end of file
@@ -1,37 +1,63 @@
 #pragma once
 #include "BasicTypes.h"
+#include "Utils.h"
+#include <bit>
+#include <utility>
 #include <vector>
 
 namespace ZE::Allocator
 {
-	// Allocator for objects of type T using a list of arrays to speed up allocation.
-	// Number of elements that can be allocated is not bounded because allocator can create multiple blocks
+	// Allocator for objects of type T using a list of equally sized slabs to speed up allocation.
+	// Number of elements that can be allocated is not bounded because allocator can create multiple slabs.
+	// Every slab is aligned to it's size so owner of an item is found directly from it's address
 	template<typename T>
 	class Pool final
 	{
+		static constexpr U64 MIN_SLAB_SIZE = 4096;
+		static constexpr U32 INVALID_INDEX = UINT32_MAX;
+
 		union Item
 		{
-			// UINT64_MAX means end of list
-			U64 NextFreeIndex;
+			// INVALID_INDEX means end of list
+			U32 NextFreeIndex;
 			alignas(T) U8 Data[sizeof(T)];
 		};
-		struct ItemBlock
+		// Header placed at the start of slab memory, followed by array of items
+		struct Slab
 		{
-			std::unique_ptr<Item[]> Items;
-			U64 Capacity;
-			U64 FirstFreeIndex;
-			U64 Allocated;
+			// Intrusive list of slabs that still have some free items
+			Slab* PrevFree;
+			Slab* NextFree;
+			// Position in the list of all slabs
+			U64 Index;
+			U32 FirstFreeIndex;
+			// Items above this index were never used so they are not present on the free list yet
+			U32 Initialized;
+			U32 Allocated;
 		};
+		static constexpr U64 ITEMS_OFFSET = (sizeof(Slab) + alignof(Item) - 1) & ~static_cast<U64>(alignof(Item) - 1);
+
+		U64 slabSize;
+		U32 slabCapacity;
+		std::vector<Slab*> slabs;
+		Slab* freeSlabs = nullptr;
+		// Single empty slab is kept alive to avoid creating new one on every alloc/free pair at slab boundary
+		Slab* emptySlab = nullptr;
 
-		const U64 firstBlockCapacity;
-		bool freeBlock = false;
-		std::vector<ItemBlock> itemBlocks;
+		static constexpr Item* GetItems(Slab* slab) noexcept { return reinterpret_cast<Item*>(reinterpret_cast<U8*>(slab) + ITEMS_OFFSET); }
+		constexpr Slab* GetSlab(T* ptr) const noexcept { return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(slabSize - 1)); }
 
-		ItemBlock& CreateNewBlock() noexcept;
+		void PushFree(Slab* slab) noexcept;
+		void RemoveFree(Slab* slab) noexcept;
+		Slab* CreateNewSlab() noexcept;
+		void DeleteSlab(Slab* slab) noexcept;
 
 	public:
-		Pool(U64 firstBlockCapacity) noexcept : firstBlockCapacity(firstBlockCapacity) {}
-		ZE_CLASS_MOVE(Pool);
+		Pool(U64 firstBlockCapacity) noexcept;
+		Pool(Pool&& pool) noexcept;
+		Pool(const Pool&) = delete;
+		Pool& operator=(Pool&& pool) noexcept;
+		Pool& operator=(const Pool&) = delete;
 		~Pool() { Clear(); }
 
 		template<typename... Types>
@@ -43,50 +69,110 @@ namespace ZE::Allocator
 
 #pragma region Functions
 	template<typename T>
-	typename Pool<T>::ItemBlock& Pool<T>::CreateNewBlock() noexcept
+	void Pool<T>::PushFree(Slab* slab) noexcept
 	{
-		U64 newBlockCapacity = itemBlocks.size() ? itemBlocks.back().Capacity * 3 / 2 : firstBlockCapacity;
-		ItemBlock& newBlock = itemBlocks.emplace_back(std::make_unique<Item[]>(newBlockCapacity), newBlockCapacity, 0, 0);
-		--newBlockCapacity;
+		slab->PrevFree = nullptr;
+		slab->NextFree = freeSlabs;
+		if (freeSlabs)
+			freeSlabs->PrevFree = slab;
+		freeSlabs = slab;
+	}
 
-		// Setup singly-linked list of all free items in this block
-		for (U64 i = 0; i < newBlockCapacity; ++i)
-			newBlock.Items[i].NextFreeIndex = i + 1;
+	template<typename T>
+	void Pool<T>::RemoveFree(Slab* slab) noexcept
+	{
+		if (slab->PrevFree)
+			slab->PrevFree->NextFree = slab->NextFree;
+		else
+		{
+			ZE_ASSERT(freeSlabs == slab, "Slab is not present on the free list!");
+			freeSlabs = slab->NextFree;
+		}
+		if (slab->NextFree)
+			slab->NextFree->PrevFree = slab->PrevFree;
+		slab->PrevFree = slab->NextFree = nullptr;
+	}
 
-		newBlock.Items[newBlockCapacity].NextFreeIndex = UINT64_MAX;
-		freeBlock = false;
-		return newBlock;
+	template<typename T>
+	typename Pool<T>::Slab* Pool<T>::CreateNewSlab() noexcept
+	{
+		Slab* slab = reinterpret_cast<Slab*>(Utils::AlignedAlloc(slabSize, slabSize));
+		ZE_ASSERT(slab, "Cannot allocate new slab for memory pool!");
+
+		slab->Index = slabs.size();
+		slab->FirstFreeIndex = INVALID_INDEX;
+		slab->Initialized = 0;
+		slab->Allocated = 0;
+		slabs.emplace_back(slab);
+		PushFree(slab);
+		return slab;
 	}
 
-	template<typename T> template<typename... Types>
-	T* Pool<T>::Alloc(Types&&... args) noexcept
+	template<typename T>
+	void Pool<T>::DeleteSlab(Slab* slab) noexcept
 	{
-		for (U64 i = itemBlocks.size(); i;)
-		{
-			ItemBlock& block = itemBlocks.at(--i);
+		// Keep list of all slabs dense by moving last one into the gap
+		Slab* last = slabs.back();
+		last->Index = slab->Index;
+		slabs.at(slab->Index) = last;
+		slabs.pop_back();
+		Utils::AlignedFree(slab);
+	}
 
-			// This block has some free items, use first one
-			if (block.FirstFreeIndex != UINT64_MAX)
-			{
-				ZE_ASSERT(block.FirstFreeIndex < block.Capacity, "Incorrect index!");
-				ZE_ASSERT(block.Allocated < block.Capacity, "Block is already full!");
-				if (block.Allocated++ == 0)
-					freeBlock = false;
+	template<typename T>
+	Pool<T>::Pool(U64 firstBlockCapacity) noexcept
+	{
+		// Single slab should fit at least requested number of items
+		slabSize = std::bit_ceil(std::max(MIN_SLAB_SIZE, ITEMS_OFFSET + firstBlockCapacity * sizeof(Item)));
+		slabCapacity = Utils::SafeCast<U32>((slabSize - ITEMS_OFFSET) / sizeof(Item));
+	}
 
-				Item* item = &block.Items[block.FirstFreeIndex];
-				block.FirstFreeIndex = item->NextFreeIndex;
+	template<typename T>
+	Pool<T>::Pool(Pool&& pool) noexcept
+		: slabSize(pool.slabSize), slabCapacity(pool.slabCapacity), slabs(std::exchange(pool.slabs, {})),
+		freeSlabs(std::exchange(pool.freeSlabs, nullptr)), emptySlab(std::exchange(pool.emptySlab, nullptr))
+	{
+	}
 
-				T* result = reinterpret_cast<T*>(&item->Data);
-				new(result) T(std::forward<Types>(args)...);
-				return result;
-			}
+	template<typename T>
+	Pool<T>& Pool<T>::operator=(Pool&& pool) noexcept
+	{
+		// Slabs are owned by single pool so current ones have to be released first
+		if (this != &pool)
+		{
+			Clear();
+			slabSize = pool.slabSize;
+			slabCapacity = pool.slabCapacity;
+			slabs = std::exchange(pool.slabs, {});
+			freeSlabs = std::exchange(pool.freeSlabs, nullptr);
+			emptySlab = std::exchange(pool.emptySlab, nullptr);
 		}
+		return *this;
+	}
+
+	template<typename T> template<typename... Types>
+	T* Pool<T>::Alloc(Types&&... args) noexcept
+	{
+		Slab* slab = freeSlabs ? freeSlabs : CreateNewSlab();
+		if (slab == emptySlab)
+			emptySlab = nullptr;
 
-		// No block has free item, create new one
-		ItemBlock& newBlock = CreateNewBlock();
-		Item* item = &newBlock.Items[0];
-		newBlock.FirstFreeIndex = item->NextFreeIndex;
-		++newBlock.Allocated;
+		Item* item;
+		if (slab->FirstFreeIndex != INVALID_INDEX)
+		{
+			ZE_ASSERT(slab->FirstFreeIndex < slab->Initialized, "Incorrect index!");
+			item = GetItems(slab) + slab->FirstFreeIndex;
+			slab->FirstFreeIndex = item->NextFreeIndex;
+		}
+		else
+		{
+			ZE_ASSERT(slab->Initialized < slabCapacity, "Slab is already full!");
+			item = GetItems(slab) + slab->Initialized++;
+		}
+
+		// Full slabs are not considered for next allocations
+		if (++slab->Allocated == slabCapacity)
+			RemoveFree(slab);
 
 		T* result = reinterpret_cast<T*>(&item->Data);
 		new(result) T(std::forward<Types>(args)...);
@@ -98,67 +184,54 @@ namespace ZE::Allocator
 	{
 		ZE_ASSERT(ptr, "Invalid pointer!");
 
+		Slab* slab = GetSlab(ptr);
+		ZE_ASSERT(slab->Index < slabs.size() && slabs.at(slab->Index) == slab, "Pointer doesn't belong to this memory pool!");
+		ZE_ASSERT(slab->Allocated > 0, "Trying to dealocate on empty list!");
+
+		ptr->~T();
 		Item* item = reinterpret_cast<Item*>(ptr);
-		// Search all memory blocks to find ptr
-		for (U64 i = itemBlocks.size(); i;)
-		{
-			ItemBlock& block = itemBlocks.at(--i);
+		item->NextFreeIndex = slab->FirstFreeIndex;
+		slab->FirstFreeIndex = Utils::SafeCast<U32>(item - GetItems(slab));
 
-			// Check if item is in address range of this block
-			if (item >= block.Items.get() && item < block.Items.get() + block.Capacity)
+		if (slab->Allocated-- == slabCapacity)
+			PushFree(slab);
+		if (slab->Allocated == 0)
+		{
+			if (emptySlab)
 			{
-				ptr->~T();
-
-				item->NextFreeIndex = block.FirstFreeIndex;
-				block.FirstFreeIndex = static_cast<U64>(item - block.Items.get());
-
-				ZE_ASSERT(block.Allocated > 0, "Trying to dealocate on empty list!");
-				if (--block.Allocated == 0)
-				{
-					if (freeBlock)
-						itemBlocks.erase(itemBlocks.begin() + i, itemBlocks.begin() + i + 1);
-					else
-						freeBlock = true;
-				}
-				return;
+				RemoveFree(slab);
+				DeleteSlab(slab);
 			}
+			else
+				emptySlab = slab;
 		}
-		ZE_FAIL("Pointer doesn't belong to this memory pool!");
 	}
 
 	template<typename T>
 	void Pool<T>::Clear(bool fastClear) noexcept
 	{
-		if (!fastClear)
+		for (Slab* slab : slabs)
 		{
-			for (auto& block : itemBlocks)
+			if (!fastClear && slab->Allocated)
 			{
-				// No need to gather free elements
-				if (block.FirstFreeIndex == UINT64_MAX)
+				// Traverse free list to know which element to delete
+				std::vector<bool> isInUse(slab->Initialized, true);
+				for (U32 i = slab->FirstFreeIndex; i != INVALID_INDEX; i = GetItems(slab)[i].NextFreeIndex)
 				{
-					for (U64 i = 0; i < block.Capacity; ++i)
-						reinterpret_cast<T*>(block.Items[i].Data)->~T();
-				}
-				else
-				{
-					// Traverse free list to know which element to delete
-					std::vector<bool> isInUse(block.Capacity, true);
-					do
-					{
-						ZE_ASSERT(block.FirstFreeIndex < block.Capacity, "Incorrect index!");
-
-						isInUse.at(block.FirstFreeIndex) = false;
-						block.FirstFreeIndex = block.Items[block.FirstFreeIndex].NextFreeIndex;
-					} while (block.FirstFreeIndex != UINT64_MAX);
-
-					// Delete remaining elements
-					for (U64 i = 0; i < block.Capacity; ++i)
-						if (isInUse.at(i))
-							reinterpret_cast<T*>(block.Items[i].Data)->~T();
+					ZE_ASSERT(i < slab->Initialized, "Incorrect index!");
+					isInUse.at(i) = false;
 				}
+
+				// Delete remaining elements
+				for (U32 i = 0; i < slab->Initialized; ++i)
+					if (isInUse.at(i))
+						reinterpret_cast<T*>(GetItems(slab)[i].Data)->~T();
 			}
+			Utils::AlignedFree(slab);
 		}
-		itemBlocks.clear();
+		slabs.clear();
+		freeSlabs = nullptr;
+		emptySlab = nullptr;
 	}
 #pragma endregion
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include "BasicTypes.h"
+#include <array>
+#include <type_traits>
+
+namespace ZE::Allocator
+{
+	// Lock-free bounded double-ended queue where single owner thread pushes and pops elements from the bottom
+	// while any number of other threads can steal elements from the top.
+	// Stored type have to be trivially copyable as stealing threads can read element concurrently with it's owner
+	template<typename T, U32 CAPACITY>
+	class WorkStealingQueue final
+	{
+		// Algorithm source: N. M. Le, A. Pop, A. Cohen, F. Zappa Nardelli "Correct and Efficient Work-Stealing for Weak Memory Models"
+		// https://fzn.fr/readings/ppopp13.pdf
+		static_assert(std::is_trivially_copyable_v<T>, "Work stealing queue can only hold trivially copyable types!");
+		static_assert(CAPACITY > 1 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity of work stealing queue have to be power of 2!");
+
+		static constexpr U32 INDEX_MASK = CAPACITY - 1;
+
+		alignas(64) std::atomic_int64_t top = 0;
+		alignas(64) std::atomic_int64_t bottom = 0;
+		std::array<std::atomic<T>, CAPACITY> items;
+
+	public:
+		WorkStealingQueue() = default;
+		ZE_CLASS_DELETE(WorkStealingQueue);
+		~WorkStealingQueue() = default;
+
+		static constexpr U32 GetCapacity() noexcept { return CAPACITY; }
+
+		// Approximate check, exact state can change in meantime when accessed by multiple threads
+		bool IsEmpty() const noexcept { return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed); }
+
+		// Only owner thread can push new elements, returns false when queue is full
+		bool Push(T item) noexcept;
+		// Only owner thread can pop elements (in LIFO order)
+		bool Pop(T& item) noexcept;
+		// Can be called from any thread to take element from the opposite end of the queue (in FIFO order)
+		bool Steal(T& item) noexcept;
+	};
+
+#pragma region Functions
+	template<typename T, U32 CAPACITY>
+	bool WorkStealingQueue<T, CAPACITY>::Push(T item) noexcept
+	{
+		const S64 currentBottom = bottom.load(std::memory_order_relaxed);
+		const S64 currentTop = top.load(std::memory_order_acquire);
+		if (currentBottom - currentTop >= static_cast<S64>(CAPACITY))
+			return false;
+
+		items[static_cast<U64>(currentBottom) & INDEX_MASK].store(item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(currentBottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	template<typename T, U32 CAPACITY>
+	bool WorkStealingQueue<T, CAPACITY>::Pop(T& item) noexcept
+	{
+		const S64 currentBottom = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(currentBottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		S64 currentTop = top.load(std::memory_order_relaxed);
+
+		// Queue already empty, restore previous state
+		if (currentTop > currentBottom)
+		{
+			bottom.store(currentBottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		item = items[static_cast<U64>(currentBottom) & INDEX_MASK].load(std::memory_order_relaxed);
+		if (currentTop == currentBottom)
+		{
+			// Last element in the queue, race against stealing threads
+			const bool won = top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(currentBottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	template<typename T, U32 CAPACITY>
+	bool WorkStealingQueue<T, CAPACITY>::Steal(T& item) noexcept
+	{
+		S64 currentTop = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const S64 currentBottom = bottom.load(std::memory_order_acquire);
+		if (currentTop >= currentBottom)
+			return false;
+
+		item = items[static_cast<U64>(currentTop) & INDEX_MASK].load(std::memory_order_relaxed);
+		// Other thread already took this element
+		return top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+#pragma endregion
+}
\ No newline at end of file
@@ -47,8 +47,17 @@ namespace ZE::DDS
 	// Convert FormatDDS to PixelFormat
 	constexpr PixelFormat GetFormatFromDDS(FormatDDS ddsFormat) noexcept;
 
+	// Get size of single row and number of rows in surface as stored inside DDS file (without any padding)
+	void GetSurfaceInfo(U32 width, U32 height, PixelFormat format, U32& rowSize, U32& rowCount) noexcept;
+	// Get offset of image inside surface data of DDS file (counted from the end of headers)
+	U64 GetImageFileOffset(U32 width, U32 height, U16 depth, U16 mipCount, PixelFormat format, U16 arrayIndex, U16 mipIndex, U16 depthLevel) noexcept;
+
+	// Save only headers of DDS file, surface data have to be written right after them
+	FileResult EncodeFileHeader(FILE* file, const SurfaceData& srcData) noexcept;
 	// Save DDS file to disk
 	FileResult EncodeFile(FILE* file, const SurfaceData& srcData) noexcept;
+	// Parse only headers of DDS file (image memory is not allocated), file is left at the beginning of surface data
+	FileResult ParseFileHeader(FILE* file, FileData& destData) noexcept;
 	// Load and parse DDS file from disk
 	FileResult ParseFile(FILE* file, FileData& destData) noexcept;
 
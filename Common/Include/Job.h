@@ -0,0 +1,141 @@
+#pragma once
+#include "BasicTypes.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ZE
+{
+	class ThreadPool;
+
+	// Counter of pending jobs, allows for waiting on completion of group of child jobs
+	class JobCounter final
+	{
+		const ThreadPool* pool = nullptr;
+		UA32 pending = 0;
+		// Number of threads still inside Release(), counter cannot be destroyed till they leave it
+		UA32 releasing = 0;
+
+	public:
+		JobCounter() = default;
+		constexpr JobCounter(const ThreadPool& pool, U32 pendingJobs = 0) noexcept : pool(&pool), pending(pendingJobs) {}
+		ZE_CLASS_DELETE(JobCounter);
+		~JobCounter() = default;
+
+		bool IsDone() const noexcept { return pending.load(std::memory_order_acquire) == 0 && releasing.load(std::memory_order_acquire) == 0; }
+		void Add(U32 count = 1) noexcept { pending.fetch_add(count, std::memory_order_relaxed); }
+		void Release() noexcept;
+
+		// Waits till all child jobs finish. If counter has been created with ThreadPool
+		// then other pending jobs from that pool are executed in meantime instead of blocking
+		void Wait() noexcept;
+	};
+
+	// Unit of work scheduled into ThreadPool, stores small callables in-place without any allocation.
+	// Job have to stay in the same place in memory till it's executed
+	class Job final
+	{
+		static constexpr U8 STORAGE_SIZE = 48;
+
+		template<typename Func>
+		static constexpr bool IS_INLINE = sizeof(Func) <= STORAGE_SIZE && alignof(Func) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Func>;
+
+		// Executes and destroys callable or only destroys it
+		typedef void (*Operation)(U8* storage, bool execute);
+
+		alignas(std::max_align_t) U8 storage[STORAGE_SIZE];
+		Operation operation = nullptr;
+		JobCounter* parent = nullptr;
+
+		template<typename Func>
+		static void InlineOperation(U8* storage, bool execute) noexcept;
+		template<typename Func>
+		static void HeapOperation(U8* storage, bool execute) noexcept;
+
+	public:
+		Job() = default;
+		template<typename Func> requires(!std::is_same_v<std::decay_t<Func>, Job>)
+		Job(Func&& func, JobCounter* parentCounter = nullptr) noexcept { Init(std::forward<Func>(func), parentCounter); }
+		ZE_CLASS_DELETE(Job);
+		~Job() { Reset(); }
+
+		constexpr bool IsEmpty() const noexcept { return operation == nullptr; }
+
+		void Reset() noexcept { if (operation) { operation(storage, false); operation = nullptr; } }
+
+		// When parent counter is specified it have to be already incremented for this job, after execution it will be released
+		template<typename Func>
+		void Init(Func&& func, JobCounter* parentCounter = nullptr) noexcept;
+		// Job can be destroyed by it's own callable, so after execution this object is not accessed anymore
+		void Execute() noexcept;
+	};
+
+#pragma region Functions
+	template<typename Func>
+	void Job::InlineOperation(U8* storage, bool execute) noexcept
+	{
+		Func& func = *std::launder(reinterpret_cast<Func*>(storage));
+		if (execute)
+		{
+			// Move out callable as it's destruction can free memory of the whole job
+			Func localFunc(std::move(func));
+			func.~Func();
+			localFunc();
+		}
+		else
+			func.~Func();
+	}
+
+	template<typename Func>
+	void Job::HeapOperation(U8* storage, bool execute) noexcept
+	{
+		Func* func = *std::launder(reinterpret_cast<Func**>(storage));
+		if (execute)
+			(*func)();
+		delete func;
+	}
+
+	template<typename Func>
+	void Job::Init(Func&& func, JobCounter* parentCounter) noexcept
+	{
+		typedef std::decay_t<Func> FuncType;
+
+		Reset();
+		parent = parentCounter;
+		if constexpr (IS_INLINE<FuncType>)
+		{
+			new(storage) FuncType(std::forward<Func>(func));
+			operation = InlineOperation<FuncType>;
+		}
+		else
+		{
+			// Callable too big for in-place storage, fallback to regular allocation
+			new(storage) FuncType*(new FuncType(std::forward<Func>(func)));
+			operation = HeapOperation<FuncType>;
+		}
+	}
+
+	inline void JobCounter::Release() noexcept
+	{
+		// Waiter can observe zero pending jobs before notification is sent,
+		// so it have to wait till last access to counter is performed here
+		releasing.fetch_add(1, std::memory_order_acq_rel);
+		if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			pending.notify_all();
+		releasing.fetch_sub(1, std::memory_order_release);
+	}
+
+	inline void Job::Execute() noexcept
+	{
+		ZE_ASSERT(operation, "Executing empty job!");
+
+		Operation currentOperation = operation;
+		JobCounter* parentCounter = parent;
+		operation = nullptr;
+		currentOperation(storage, true);
+		if (parentCounter)
+			parentCounter->Release();
+	}
+#pragma endregion
+}
\ No newline at end of file
@@ -4,10 +4,10 @@
 
 #if _ZE_MODE_DEBUG || _ZE_MODE_DEV
 // Debug assert with ability to specify level of log entry
-#	define ZE_ASSERT_LVL(lvl, condition, message) do { if (!(condition)) { ZE::Logger::##lvl##(message, true); ZE::Intrin::DebugBreak(); } } while (false)
+#	define ZE_ASSERT_LVL(lvl, condition, message) do { if (!(condition)) { ZE::Logger::lvl(message, true); ZE::Intrin::DebugBreak(); } } while (false)
 #elif _ZE_MODE_PROFILE
 // Debug assert with ability to specify level of log entry
-#	define ZE_ASSERT_LVL(lvl, condition, message) do { if (!(condition)) ZE::Logger::##lvl##(message, true); } while (false)
+#	define ZE_ASSERT_LVL(lvl, condition, message) do { if (!(condition)) ZE::Logger::lvl(message, true); } while (false)
 #elif _ZE_MODE_RELEASE
 // Debug assert with ability to specify level of log entry
 #	define ZE_ASSERT_LVL(lvl, condition, message) ((void)0)
@@ -245,8 +245,9 @@ namespace ZE::Math
 	template<typename T>
 	constexpr T MirrorCoord(T coord, T size) noexcept
 	{
-		const T mod = coord % (size * 2);
-		return mod < size ? (mod < 0 ? std::abs(mod + 1) : mod) : (size * 2 - mod - 1);
+		// Negative coordinates are moved into single period first so they can be further than size away from the edge
+		const T mod = (coord % (size * 2) + size * 2) % (size * 2);
+		return mod < size ? mod : (size * 2 - mod - 1);
 	}
 
 	Float3 GetEulerAngles(const Float4& rotor) noexcept;
@@ -8,6 +8,9 @@
 #if _ZE_PLATFORM_WINDOWS
 #include "Platform/WinAPI/Perf.h"
 namespace ZE { typedef WinAPI::Perf PlatformPerf; }
+#elif _ZE_PLATFORM_LINUX
+#include "Platform/Linux/Perf.h"
+namespace ZE { typedef Linux::Perf PlatformPerf; }
 #else
 #	error Missing Perf platform specific implementation!
 #endif
@@ -35,7 +38,8 @@ namespace ZE
 		static constexpr bool MULTITHREADED = true;
 
 		std::map<std::string, Data> data;
-		std::vector<std::pair<U64, std::string>> lastTags;
+		// Sections can be measured on multiple threads at once so every thread keeps it's own stack of started ones
+		static thread_local std::vector<std::pair<U64, std::string>> lastTags;
 		std::shared_mutex mutex;
 		std::bitset<Flags::FlagsCount> flags = 0;
 #endif
@@ -74,7 +78,7 @@ namespace ZE
 
 #if _ZE_MODE_PROFILE
 // Use to configure tool behavior with given function
-#	define ZE_PERF_CONFIGURE(function, val) ZE::Perf::Get().##function##(val)
+#	define ZE_PERF_CONFIGURE(function, val) ZE::Perf::Get().function(val)
 #	define ZE_PERF_START(sectionTag) ZE::Perf::Get().Start(sectionTag)
 // Use for measuring short periods of time as it gets raw data based on RDTSC
 #	define ZE_PERF_START_SHORT(sectionTag) ZE::Perf::Get().StartShort(sectionTag)
@@ -0,0 +1,18 @@
+#pragma once
+#include "Utils.h"
+#include <time.h>
+
+namespace ZE::Linux
+{
+	class Perf final
+	{
+		static constexpr long double NANOSECONDS_PER_SECOND = 1000000000.0L;
+
+	public:
+		Perf() = default;
+
+		// Timestamps are nanoseconds of raw monotonic clock, not affected by NTP adjustments
+		constexpr long double GetFrequency() const noexcept { return NANOSECONDS_PER_SECOND; }
+		U64 GetCurrentTimestamp() const noexcept { timespec stamp; clock_gettime(CLOCK_MONOTONIC_RAW, &stamp); return static_cast<U64>(stamp.tv_sec) * 1000000000ULL + static_cast<U64>(stamp.tv_nsec); }
+	};
+}
\ No newline at end of file
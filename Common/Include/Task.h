@@ -1,9 +1,5 @@
 #pragma once
-#include "BasicTypes.h"
-ZE_WARNING_PUSH
-ZE_WARNING_DISABLE_MSVC(5204) // Bug in MSVC producing warnings in <future> header
-#include <future>
-ZE_WARNING_POP
+#include "Job.h"
 #include <memory>
 
 namespace ZE
@@ -14,42 +10,85 @@ namespace ZE
 	{
 		friend class ThreadPool;
 
+		typedef std::conditional_t<std::is_void_v<R>, U8, R> Result;
+
 		struct ExecutionData
 		{
-			std::packaged_task<R()> task;
-			BoolAtom processing = false;
+			JobCounter Counter;
+			// Actual work to be done, can be executed either by the pool or by thread waiting for the result
+			Job Work;
+			// Entry submitted into the pool, keeps data alive till it's processed
+			Job Dispatch;
+			Result Value = {};
+			BoolAtom Processing = false;
+
+			template<typename Func>
+			ExecutionData(const ThreadPool& pool, Func&& func) noexcept;
+
+			bool TryExecute() noexcept;
 		};
 		std::shared_ptr<ExecutionData> data;
 
-		constexpr std::shared_ptr<ExecutionData> GetData() noexcept { return data; }
+		constexpr Job& GetDispatchJob() noexcept { return data->Dispatch; }
+		constexpr void ExecuteInPlace() noexcept { data->TryExecute(); data->Dispatch.Reset(); }
 
-		constexpr Task(std::packaged_task<R()>&& task) noexcept
-			: data(std::make_shared<ExecutionData>(std::move(task))) {}
+		template<typename Func>
+		Task(const ThreadPool& pool, Func&& func) noexcept;
 
 	public:
 		Task() = default;
 		ZE_CLASS_DEFAULT(Task);
 		~Task() = default;
 
-		// Waits for scheduled task complition before returting data if any
+		// Check whether task have already finished it's execution
+		bool IsDone() const noexcept { return data == nullptr || data->Counter.IsDone(); }
+		// Waits for scheduled task complition before returting data if any.
+		// When task is still in progress, other pending jobs from the pool are executed while waiting
 		constexpr R Get() noexcept;
 	};
 
 #pragma region Functions
-	template <typename R>
+	template<typename R> template<typename Func>
+	Task<R>::ExecutionData::ExecutionData(const ThreadPool& pool, Func&& func) noexcept
+		: Counter(pool, 1)
+	{
+		Work.Init([this, func = std::forward<Func>(func)]() mutable
+			{
+				if constexpr (std::is_void_v<R>)
+					func();
+				else
+					Value = func();
+			}, &Counter);
+	}
+
+	template<typename R>
+	bool Task<R>::ExecutionData::TryExecute() noexcept
+	{
+		// Check if some thread already started working on this task, if not do it yourself
+		const bool status = Processing.exchange(true, std::memory_order_acq_rel);
+		if (!status)
+			Work.Execute();
+		return !status;
+	}
+
+	template<typename R> template<typename Func>
+	Task<R>::Task(const ThreadPool& pool, Func&& func) noexcept
+		: data(std::make_shared<ExecutionData>(pool, std::forward<Func>(func)))
+	{
+		data->Dispatch.Init([execData = data]() { execData->TryExecute(); });
+	}
+
+	template<typename R>
 	constexpr R Task<R>::Get() noexcept
 	{
 		if (data)
 		{
-			std::future<R> future = data->task.get_future();
-			const bool status = std::atomic_exchange_explicit(&data->processing, true, std::memory_order::memory_order_acq_rel);
-			// Check if some thread already started working on this task, if not do it yourself
-			if (!status)
-				data->task();
-			return future.get();
+			if (!data->TryExecute())
+				data->Counter.Wait();
+			if constexpr (!std::is_void_v<R>)
+				return data->Value;
 		}
 		return R();
 	}
-
 #pragma endregion
 }
\ No newline at end of file
@@ -1,11 +1,15 @@
 #pragma once
-#include "Allocator/BlockingQueue.h"
 #include "Allocator/FixedPool.h"
+#include "Allocator/WorkStealingQueue.h"
 #include "Task.h"
 #include <array>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <iterator>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace ZE
 {
@@ -15,31 +19,64 @@ namespace ZE
 	// Available priorites for jobs scheduled into thread pool
 	enum class ThreadPriority : U8 { Critical = 0, High = 1, Normal = 2 };
 
-	// Pool managing asynchronous job submissions and delegating them into workers on different threads
+	// Pool managing asynchronous job submissions and delegating them into workers on different threads.
+	// Every worker owns separate queue for each priority, when out of jobs it steals them from other workers
 	class ThreadPool final
 	{
+		static constexpr U8 PRIORITY_LEVELS = 3;
+		static constexpr U32 WORKER_QUEUE_SIZE = 1024;
+		static constexpr U64 CACHE_LINE_SIZE = 64;
+		// Number of chunks created for every thread when grain is not specified, allows for better load balancing
+		static constexpr U64 CHUNKS_PER_THREAD = 4;
+
+		// Data owned by single worker thread, aligned to avoid false sharing between workers
+		struct alignas(64) WorkerData
+		{
+			BoolAtom Run = false;
+			std::array<Allocator::WorkStealingQueue<Job*, WORKER_QUEUE_SIZE>, PRIORITY_LEVELS> Queues;
+		};
+
 		static inline VendorCPU currentCPU = VendorCPU::Unknown;
 		static inline U8 coresCount = 0;
 		static inline U8 logicalCoresCount = 0;
+		// Pool to which current thread belongs as a worker
+		static inline thread_local const ThreadPool* currentPool = nullptr;
+		static inline thread_local U8 currentWorker = 0;
 
 		U8 threadsCountOverride = 0;
 		U8 allocatedThreads = 0;
 		U8 maxThreadsCount = UINT8_MAX;
+		U8 workersCapacity = 0;
 		bool useMultiThreading = true;
 
 		BoolAtom runControl = true;
-		Ptr<BoolAtom> threadRunControls;
+		Ptr<WorkerData> workers;
 		std::vector<std::thread> threads;
+		// Number of workers that could have pending jobs in their queues
+		mutable UA8 activeWorkers = 0;
 
+		// Jobs submitted from threads outside of the pool or when worker queue is full
+		mutable std::mutex injectionMutex;
+		mutable std::array<std::deque<Job*>, PRIORITY_LEVELS> injectionQueues;
+		mutable std::array<UA32, PRIORITY_LEVELS> injectionCounts = {};
+
+		mutable std::mutex sleepMutex;
 		mutable std::condition_variable signaler;
-		mutable std::array<Allocator::BlockingQueue<std::function<void()>>, 3> taskQueues;
+		mutable UA32 pendingJobs = 0;
+		mutable UA32 sleepingWorkers = 0;
 
 		constexpr void ResizeThreads(U8 oldCount, U8 currentCount) noexcept;
-		void Worker(const BoolAtom& run) const noexcept;
+		void StartWorkers(U8 count) noexcept;
+		Job* AcquireJob() const noexcept;
+		void Worker(U8 index) const noexcept;
+
+		// Computes size of the chunk, when grain is not specified then separate chunks don't share cache lines of processed elements
+		template<typename T>
+		constexpr U64 GetChunkSize(U64 count, U64 grain) const noexcept;
 
 	public:
 		ThreadPool() noexcept;
-		ZE_CLASS_MOVE(ThreadPool);
+		ZE_CLASS_DELETE(ThreadPool);
 		~ThreadPool();
 
 		static constexpr VendorCPU GetCurrentCPU() noexcept { return currentCPU; }
@@ -58,30 +95,136 @@ namespace ZE
 		// allocThreadsCount: decrease threadpool count by X for static threads that will not be managed by this pool
 		// customThreadCount: set custom override to number of threads (no function will change this number)
 		constexpr void Init(U8 allocThreadsCount = 0, U8 customThreadCount = 0) noexcept;
+
+		// Submit job that have to stay alive till it's execution, when pool don't have any workers it's executed immediately.
+		// If job have parent counter it should be already incremented before submission
+		void Submit(ThreadPriority priority, Job& job) const noexcept;
+		// Execute single job waiting in the pool if any present, returns false when no job was found
+		bool ExecutePendingJob() const noexcept;
+
+		// Calls func(chunkIndex) for every chunk, work is distributed between workers and calling thread.
+		// Chunks are taken one by one in order by free threads, so they can differ in amount of work
+		template<typename ChunkFunc>
+		void ProcessChunks(U64 chunksCount, ThreadPriority priority, ChunkFunc&& func) const noexcept;
+
+		// Calls func(element) for every element in range with random access iterators (ex. EnTT group or single component view).
+		// Range is split into chunks of at least 'grain' elements (when 0 then selected automatically) that are processed
+		// by workers and calling thread. Returns after all elements have been processed
+		template<typename Range, typename Func>
+		void ParallelFor(Range&& range, U64 grain, Func&& func, ThreadPriority priority = ThreadPriority::Critical) const noexcept;
+		// Reduces all elements in range with random access iterators into single value, chunks are created the same way as in ParallelFor().
+		// Every chunk starts from copy of 'init' and accumulates elements with reduce(T& value, element),
+		// then partial results are combined in range order with combine(T& value, const T& partial)
+		template<typename T, typename Range, typename ReduceFunc, typename CombineFunc>
+		T ParallelReduce(Range&& range, U64 grain, const T& init, ReduceFunc&& reduce, CombineFunc&& combine, ThreadPriority priority = ThreadPriority::Critical) const noexcept;
 	};
 
 #pragma region Functions
+	template<typename T>
+	constexpr U64 ThreadPool::GetChunkSize(U64 count, U64 grain) const noexcept
+	{
+		// Explicit grain is always respected, rounding is only applied to automatically selected size
+		if (grain != 0)
+			return grain;
+
+		grain = Math::DivideRoundUp(count, static_cast<U64>(GetWorkerThreadsCount() + 1) * CHUNKS_PER_THREAD);
+		if constexpr (sizeof(T) < CACHE_LINE_SIZE)
+		{
+			// Element size don't have to be power of two so round to multiple of elements filling cache line
+			constexpr U64 CACHE_LINE_ELEMENTS = CACHE_LINE_SIZE / sizeof(T);
+			grain = Math::DivideRoundUp(grain, CACHE_LINE_ELEMENTS) * CACHE_LINE_ELEMENTS;
+		}
+		return grain;
+	}
+
+	template<typename ChunkFunc>
+	void ThreadPool::ProcessChunks(U64 chunksCount, ThreadPriority priority, ChunkFunc&& func) const noexcept
+	{
+		UA64 nextChunk = 0;
+		auto processChunks = [&]()
+			{
+				for (U64 chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunksCount; chunk = nextChunk.fetch_add(1, std::memory_order_relaxed))
+					func(chunk);
+			};
+
+		// Every helper job takes next free chunk till all are processed so no need to create separate job for every chunk
+		const U64 helpersCount = runControl ? std::min(chunksCount - 1, static_cast<U64>(std::min(GetWorkerThreadsCount(), activeWorkers.load(std::memory_order_relaxed)))) : 0;
+		if (helpersCount)
+		{
+			JobCounter counter(*this, Utils::SafeCast<U32>(helpersCount));
+			std::vector<Job> helpers(helpersCount);
+			for (Job& helper : helpers)
+			{
+				helper.Init([&processChunks]() { processChunks(); }, &counter);
+				Submit(priority, helper);
+			}
+			processChunks();
+			counter.Wait();
+		}
+		else
+			processChunks();
+	}
+
+	template<typename Range, typename Func>
+	void ThreadPool::ParallelFor(Range&& range, U64 grain, Func&& func, ThreadPriority priority) const noexcept
+	{
+		auto begin = std::begin(range);
+		static_assert(std::random_access_iterator<decltype(begin)>, "ParallelFor() requires range with random access iterators!");
+
+		const U64 count = static_cast<U64>(std::distance(begin, std::end(range)));
+		if (count == 0)
+			return;
+
+		const U64 chunkSize = GetChunkSize<std::iter_value_t<decltype(begin)>>(count, grain);
+		ProcessChunks(Math::DivideRoundUp(count, chunkSize), priority, [&](U64 chunk)
+			{
+				const U64 chunkStart = chunk * chunkSize;
+				auto it = begin + static_cast<std::iter_difference_t<decltype(begin)>>(chunkStart);
+				for (const auto end = it + static_cast<std::iter_difference_t<decltype(begin)>>(std::min(chunkSize, count - chunkStart)); it != end; ++it)
+					func(*it);
+			});
+	}
+
+	template<typename T, typename Range, typename ReduceFunc, typename CombineFunc>
+	T ThreadPool::ParallelReduce(Range&& range, U64 grain, const T& init, ReduceFunc&& reduce, CombineFunc&& combine, ThreadPriority priority) const noexcept
+	{
+		auto begin = std::begin(range);
+		static_assert(std::random_access_iterator<decltype(begin)>, "ParallelReduce() requires range with random access iterators!");
+
+		const U64 count = static_cast<U64>(std::distance(begin, std::end(range)));
+		if (count == 0)
+			return init;
+
+		const U64 chunkSize = GetChunkSize<std::iter_value_t<decltype(begin)>>(count, grain);
+		std::vector<T> partials(Math::DivideRoundUp(count, chunkSize), init);
+		ProcessChunks(partials.size(), priority, [&](U64 chunk)
+			{
+				// Accumulate locally to avoid false sharing between partial results
+				T value = init;
+				const U64 chunkStart = chunk * chunkSize;
+				auto it = begin + static_cast<std::iter_difference_t<decltype(begin)>>(chunkStart);
+				for (const auto end = it + static_cast<std::iter_difference_t<decltype(begin)>>(std::min(chunkSize, count - chunkStart)); it != end; ++it)
+					reduce(value, *it);
+				partials.at(chunk) = std::move(value);
+			});
+
+		T result = std::move(partials.front());
+		for (U64 i = 1; i < partials.size(); ++i)
+			combine(result, partials.at(i));
+		return result;
+	}
+
 	template <typename Func, typename... Args>
 	constexpr auto ThreadPool::Schedule(ThreadPriority priority, Func&& f, Args&&... args) const noexcept -> Task<decltype(f(args...))>
 	{
 		using Return = decltype(f(args...));
 
-		std::packaged_task<Return()> taskPackage(std::bind(std::forward<Func>(f), std::forward<Args>(args)...));
-		Task<Return> task(std::move(taskPackage));
-		auto workerFunc = [execData = task.GetData()]() -> void
-			{
-				const bool status = std::atomic_exchange_explicit(&execData->processing, true, std::memory_order::memory_order_acq_rel);
-				if (!status)
-					execData->task();
-			};
+		Task<Return> task(*this, std::bind(std::forward<Func>(f), std::forward<Args>(args)...));
 		// When pool is stopped don't delegate new tasks to it, only run them in single thread
 		if (GetWorkerThreadsCount() > 0 && runControl)
-		{
-			taskQueues[static_cast<U8>(priority)].EmplaceBack(std::move(workerFunc));
-			signaler.notify_one();
-		}
+			Submit(priority, task.GetDispatchJob());
 		else
-			workerFunc();
+			task.ExecuteInPlace();
 		return task;
 	}
 
@@ -137,15 +280,12 @@ namespace ZE
 		{
 			allocatedThreads = allocThreadsCount;
 
+			// Worker data is created up front for all possible workers as it's accessed by other threads during stealing
+			workersCapacity = std::max(logicalCoresCount, customThreadCount);
+			workers = new WorkerData[workersCapacity];
+
 			// Create worker threads that will sleep waiting for new job to execute
-			const U8 count = GetWorkerThreadsCount();
-			threadRunControls = new BoolAtom[count];
-			threads.reserve(count);
-			for (U8 i = 0; i < count; ++i)
-			{
-				threadRunControls[i] = true;
-				threads.emplace_back(&ThreadPool::Worker, this, std::cref(threadRunControls[i]));
-			}
+			StartWorkers(GetWorkerThreadsCount());
 		}
 	}
 #pragma endregion
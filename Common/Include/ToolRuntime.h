@@ -0,0 +1,104 @@
+#pragma once
+#include "ThreadPool.h"
+#include <string_view>
+#include <vector>
+
+namespace ZE
+{
+	// Files accessed by single job of the batch, used to find jobs that have to wait for results of previous ones
+	struct ToolJobFiles
+	{
+		std::vector<std::string_view> Inputs;
+		std::vector<std::string_view> Outputs;
+	};
+
+	// Region of the image processed as single unit of work
+	struct ToolTile
+	{
+		// Array slice (or cubemap face) and mip level of the tile, meaning is up to the tool
+		U16 Slice;
+		U16 Level;
+		U32 X;
+		U32 Y;
+		U32 Width;
+		U32 Height;
+	};
+
+	// Execution environment shared by the tools. Work of single job is split into tiles taken dynamically by free threads
+	// of the pool, so images of uneven sizes (small mips, single cubemap faces) don't leave cores idle.
+	// Independent jobs from batch files are executed concurrently on the same pool
+	class ToolRuntime final
+	{
+		ThreadPool pool;
+		U32 threadsCount;
+
+		// Checks whether job have to wait for the earlier one to finish: it reads or overwrites results of earlier job or overwrites it's source
+		static bool IsDependent(const ToolJobFiles& earlier, const ToolJobFiles& job) noexcept;
+
+	public:
+		static constexpr U32 DEFAULT_TILE_SIZE = 64;
+
+		// Calling thread is counted as one of the cores
+		ToolRuntime(U32 cores) noexcept;
+		ZE_CLASS_DELETE(ToolRuntime);
+		~ToolRuntime() = default;
+
+		constexpr U32 GetThreadsCount() const noexcept { return threadsCount; }
+
+		// Appends tiles covering whole image of given size
+		static void AddTiles(std::vector<ToolTile>& tiles, U32 width, U32 height, U32 tileWidth = DEFAULT_TILE_SIZE, U32 tileHeight = DEFAULT_TILE_SIZE, U16 slice = 0, U16 level = 0) noexcept;
+
+		// Calls func(index) for every index in range [0, count), indices are taken one by one by free threads
+		template<typename Func>
+		void ForEach(U64 count, Func&& func) const noexcept;
+		// Calls func(const ToolTile&) for every tile in the list, returns after all tiles have been processed
+		template<typename Func>
+		void ForEachTile(const std::vector<ToolTile>& tiles, Func&& func) const noexcept { ForEach(tiles.size(), [&](U64 i) { func(tiles.at(i)); }); }
+		// Runs batch of jobs with runJob(index) returning status code where 0 means success. Jobs run concurrently unless they depend on files
+		// of the previous ones, after group of jobs fails the rest of the batch is skipped and code of first failed job in batch order is returned
+		template<typename Func>
+		int RunBatch(const std::vector<ToolJobFiles>& jobs, Func&& runJob) const noexcept;
+	};
+
+#pragma region Functions
+	template<typename Func>
+	void ToolRuntime::ForEach(U64 count, Func&& func) const noexcept
+	{
+		if (count)
+			pool.ProcessChunks(count, ThreadPriority::Critical, func);
+	}
+
+	template<typename Func>
+	int ToolRuntime::RunBatch(const std::vector<ToolJobFiles>& jobs, Func&& runJob) const noexcept
+	{
+		// Every job is placed in the group following the last group containing any job it depends on
+		std::vector<U32> groups(jobs.size(), 0);
+		U32 groupsCount = 0;
+		for (U64 i = 0; i < jobs.size(); ++i)
+		{
+			for (U64 j = 0; j < i; ++j)
+				if (groups.at(i) <= groups.at(j) && IsDependent(jobs.at(j), jobs.at(i)))
+					groups.at(i) = groups.at(j) + 1;
+			groupsCount = std::max(groupsCount, groups.at(i) + 1);
+		}
+
+		std::vector<int> results(jobs.size(), 0);
+		std::vector<Task<void>> tasks;
+		for (U32 group = 0; group < groupsCount; ++group)
+		{
+			// Jobs have lower priority than their tiles so already started ones are finished first
+			for (U64 i = 0; i < jobs.size(); ++i)
+				if (groups.at(i) == group)
+					tasks.emplace_back(pool.Schedule(ThreadPriority::Normal, [&runJob, &results, i]() { results.at(i) = runJob(i); }));
+			for (Task<void>& task : tasks)
+				task.Get();
+			tasks.clear();
+
+			for (U64 i = 0; i < jobs.size(); ++i)
+				if (groups.at(i) == group && results.at(i) != 0)
+					return results.at(i);
+		}
+		return 0;
+	}
+#pragma endregion
+}
\ No newline at end of file
@@ -90,23 +90,36 @@
 #include "Timer.h"
 
 /*
-***** Macros.h (defined by CmdParser.h)
-***** shared_mutex
-*** LockGuard.h
-*** memory
-* Allocator/BlockingQueue.h
+* Macros.h (defined by CmdParser.h)
+* shared_mutex
+*/
+#include "LockGuard.h"
+
+/*
 *** BasicTypes.h (defined by CmdParser.h)
 *** type_traits
 *** vector
 * Allocator/FixedPool.h
 *** BasicTypes.h (defined by CmdParser.h)
-*** future
+*** array
+*** type_traits
+* Allocator/WorkStealingQueue.h
+***** BasicTypes.h (defined by CmdParser.h)
+***** cstddef
+***** new
+***** type_traits
+***** utility
+*** Job.h
 *** memory
 * Task.h
 * array
 * condition_variable
+* deque
 * functional
+* iterator
+* mutex
 * thread
+* vector
 */
 #include "ThreadPool.h"
 
@@ -124,13 +137,45 @@
 
 /*
 *** BasicTypes.h (defined by CmdParser.h)
+*** Utils.h
+*** bit
 *** vector
 * Allocator/Pool.h
 * Intrinsics.h (defined by CmdParser.h)
+* algorithm
 * bitset
+* vector
 */
 #include "Allocator/ChunkedTLSF.h"
 
+/*
+* Allocator/ChunkedTLSF.h
+* array
+* memory
+* mutex
+*/
+#include "Allocator/ConcurrentTLSF.h"
+
+/*
+* MathExt.h (defined by MathLight.h)
+* Utils.h
+* charconv
+* deque
+* mutex
+* string_view
+* type_traits
+* vector
+*/
+#include "Allocator/FrameArena.h"
+
+/*
+* MathExt.h (defined by MathLight.h)
+* Utils.h
+* memory
+* mutex
+*/
+#include "Allocator/PageRing.h"
+
 /*
 ***** Macros.h (defined by CmdParser.h)
 *** DDS/PixelFormatDDS.h
@@ -184,4 +229,10 @@
 * Utils.h (defined by platform agnostic headers)
 */
 #	include "Platform/WinAPI/Perf.h"
+#elif _ZE_PLATFORM_LINUX
+/*
+* Utils.h (defined by platform agnostic headers)
+*** time.h
+*/
+#	include "Platform/Linux/Perf.h"
 #endif
\ No newline at end of file
@@ -121,7 +121,7 @@ namespace ZE::DDS
 #undef ZE_IS_MASK
 	}
 
-	static constexpr void GetSurfaceInfo(U32 width, U32 height, PixelFormat format, U32& rowSize, U32& rowCount) noexcept
+	void GetSurfaceInfo(U32 width, U32 height, PixelFormat format, U32& rowSize, U32& rowCount) noexcept
 	{
 		bool blockCompression = false;
 		U8 bytePairEncoding = 0;
@@ -167,7 +167,24 @@ namespace ZE::DDS
 		}
 	}
 
-	FileResult EncodeFile(FILE* file, const SurfaceData& srcData) noexcept
+	U64 GetImageFileOffset(U32 width, U32 height, U16 depth, U16 mipCount, PixelFormat format, U16 arrayIndex, U16 mipIndex, U16 depthLevel) noexcept
+	{
+		U64 chainSize = 0;
+		U64 offset = 0;
+		for (U16 mip = 0; mip < mipCount; ++mip)
+		{
+			U32 rowSize, rowCount;
+			GetSurfaceInfo(std::max(width >> mip, 1U), std::max(height >> mip, 1U), format, rowSize, rowCount);
+			const U64 sliceSize = static_cast<U64>(rowSize) * rowCount;
+
+			if (mip == mipIndex)
+				offset = chainSize + depthLevel * sliceSize;
+			chainSize += sliceSize * std::max(depth >> mip, 1);
+		}
+		return arrayIndex * chainSize + offset;
+	}
+
+	FileResult EncodeFileHeader(FILE* file, const SurfaceData& srcData) noexcept
 	{
 		ZE_ASSERT(file, "Empty file to write into!");
 
@@ -251,14 +268,24 @@ namespace ZE::DDS
 		ZE_DDS_CHECK_WRITE(MAGIC_NUMBER);
 		ZE_DDS_CHECK_WRITE(header);
 		ZE_DDS_CHECK_WRITE(dxt10Header);
+		return FileResult::Ok;
+#undef ZE_MAKE_FOURCC
+#undef ZE_DDS_CHECK_WRITE
+	}
+
+	FileResult EncodeFile(FILE* file, const SurfaceData& srcData) noexcept
+	{
+		const FileResult result = EncodeFileHeader(file, srcData);
+		if (result != FileResult::Ok)
+			return result;
 
 		U8* srcImageMemory = srcData.ImageMemory.get();
 		for (U16 a = 0; a < srcData.ArraySize; ++a)
 		{
 			for (U16 mip = 0; mip < srcData.MipCount; ++mip)
 			{
-				U32 currentWidth = std::max(header.Width >> mip, 1U);
-				U32 currentHeight = std::max(header.Height >> mip, 1U);
+				U32 currentWidth = std::max(srcData.Width >> mip, 1U);
+				U32 currentHeight = std::max(srcData.Height >> mip, 1U);
 				U16 currentDepth = std::max<U16>(srcData.Depth >> mip, 1);
 
 				const U64 srcSliceSize = GFX::Surface::GetSliceByteSize(currentWidth, currentHeight, srcData.Format, 0);
@@ -300,11 +327,9 @@ namespace ZE::DDS
 			}
 		}
 		return FileResult::Ok;
-#undef ZE_MAKE_FOURCC
-#undef ZE_DDS_CHECK_WRITE
 	}
 
-	FileResult ParseFile(FILE* file, FileData& destData) noexcept
+	FileResult ParseFileHeader(FILE* file, FileData& destData) noexcept
 	{
 		ZE_ASSERT(file, "Empty file to read from!");
 
@@ -336,7 +361,8 @@ namespace ZE::DDS
 				return FileResult::IncorrectArraySize;
 			arraySize = Utils::SafeCast<U16>(dxt10Header.ArraySize);
 			format = GetFormatFromDDS(dxt10Header.Format);
-			alpha = !(dxt10Header.MiscFlags2 & MiscFlag2DXT10::AlphaOpaque);
+			// Alpha mode is stored as value, not as separate flags
+			alpha = (dxt10Header.MiscFlags2 & MiscFlag2DXT10::AlphaModeMask) != MiscFlag2DXT10::AlphaOpaque;
 
 			if (dxt10Header.Dimension & ResourceDimension::Texture3D)
 			{
@@ -374,13 +400,37 @@ namespace ZE::DDS
 		if (format == PixelFormat::Unknown)
 			return FileResult::UnknownFormat;
 
+		destData.Format = format;
+		destData.Alpha = alpha;
+		destData.Width = header.Width;
+		destData.Height = header.Height;
+		destData.Depth = depth;
+		destData.MipCount = Utils::SafeCast<U16>(header.MipMapCount ? header.MipMapCount : 1);
+		destData.ArraySize = arraySize;
+		destData.ImageMemorySize = 0;
+		destData.ImageMemory = nullptr;
+		return FileResult::Ok;
+#undef ZE_IS_FOURCC
+#undef ZE_DDS_CHECK_READ
+	}
+
+	FileResult ParseFile(FILE* file, FileData& destData) noexcept
+	{
+		const FileResult result = ParseFileHeader(file, destData);
+		if (result != FileResult::Ok)
+			return result;
+
+		const PixelFormat format = destData.Format;
+		const U16 depth = destData.Depth;
+		const U16 mipCount = destData.MipCount;
+		const U16 arraySize = destData.ArraySize;
+
 		// Compute padded destination image size
 		U64 destImageSize = 0;
-		const U16 mipCount = Utils::SafeCast<U16>(header.MipMapCount ? header.MipMapCount : 1);
 		for (U16 a = 0; a < arraySize; ++a)
 		{
 			for (U16 mip = 0; mip < mipCount; ++mip)
-				destImageSize += GFX::Surface::GetSliceByteSize(header.Width, header.Height, format, mip) * std::max(depth >> mip, 1);
+				destImageSize += GFX::Surface::GetSliceByteSize(destData.Width, destData.Height, format, mip) * std::max(depth >> mip, 1);
 		}
 
 		// Read surfaces from disk to memory directly in padded regions
@@ -390,8 +440,8 @@ namespace ZE::DDS
 		{
 			for (U16 mip = 0; mip < mipCount; ++mip)
 			{
-				U32 currentWidth = std::max(header.Width >> mip, 1U);
-				U32 currentHeight = std::max(header.Height >> mip, 1U);
+				U32 currentWidth = std::max(destData.Width >> mip, 1U);
+				U32 currentHeight = std::max(destData.Height >> mip, 1U);
 				U16 currentDepth = std::max<U16>(depth >> mip, 1);
 
 				const U64 destSliceSize = GFX::Surface::GetSliceByteSize(currentWidth, currentHeight, format, 0);
@@ -433,17 +483,8 @@ namespace ZE::DDS
 			}
 		}
 
-		destData.Format = format;
-		destData.Alpha = alpha;
-		destData.Width = header.Width;
-		destData.Height = header.Height;
-		destData.Depth = depth;
-		destData.MipCount = mipCount;
-		destData.ArraySize = arraySize;
 		destData.ImageMemorySize = Utils::SafeCast<U32>(destImageSize);
 		destData.ImageMemory = image;
 		return FileResult::Ok;
-#undef ZE_IS_FOURCC
-#undef ZE_DDS_CHECK_READ
 	}
 }
\ No newline at end of file
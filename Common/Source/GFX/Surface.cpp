@@ -135,6 +135,8 @@ namespace ZE::GFX
 										dest += destRowSize;
 										src += srcRowSize;
 									}
+									// Skip padding at the end of the slice
+									dest += destSliceSize - static_cast<U64>(destRowSize) * currentHeight;
 								}
 							}
 						}
@@ -0,0 +1,20 @@
+#include "Job.h"
+#include "ThreadPool.h"
+
+namespace ZE
+{
+	void JobCounter::Wait() noexcept
+	{
+		while (!IsDone())
+		{
+			// Help with processing pending jobs instead of blocking current thread,
+			// when there is nothing to do then sleep till counter changes
+			if (pool == nullptr || !pool->ExecutePendingJob())
+			{
+				const U32 current = pending.load(std::memory_order_acquire);
+				if (current != 0)
+					pending.wait(current, std::memory_order_acquire);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 namespace ZE
 {
 #if _ZE_MODE_PROFILE
+	thread_local std::vector<std::pair<U64, std::string>> Perf::lastTags;
+
 	U64& Perf::CreateStartStamp(const std::string& sectionTag) noexcept
 	{
 		if (data.find(sectionTag) == data.end())
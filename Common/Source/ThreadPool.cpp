@@ -5,49 +5,111 @@ namespace ZE
 {
 	constexpr void ThreadPool::ResizeThreads(U8 oldCount, U8 currentCount) noexcept
 	{
-		for (; oldCount < currentCount; ++oldCount)
-		{
-			threadRunControls[oldCount] = true;
-			threads.emplace_back(&ThreadPool::Worker, this, std::cref(threadRunControls[oldCount]));
-		}
-		if (currentCount < oldCount)
+		currentCount = std::min(currentCount, workersCapacity);
+		if (oldCount < currentCount)
+			StartWorkers(currentCount);
+		else if (currentCount < oldCount)
 		{
 			for (U8 i = currentCount; i < oldCount; ++i)
-				threadRunControls[i] = false;
-			signaler.notify_all();
+				workers[i].Run = false;
+			{
+				std::lock_guard lock(sleepMutex);
+				signaler.notify_all();
+			}
+			// Stopped workers finish all jobs from their own queues before exiting
 			for (U8 i = currentCount; i < oldCount; ++i)
 				threads[i].join();
 			threads.resize(currentCount);
+			// Queues of stopped workers are empty now so they don't have to be searched for jobs anymore
+			activeWorkers.store(currentCount, std::memory_order_release);
+		}
+	}
+
+	void ThreadPool::StartWorkers(U8 count) noexcept
+	{
+		ZE_ASSERT(count <= workersCapacity, "Too many workers requested!");
+
+		threads.reserve(count);
+		for (U8 i = Utils::SafeCast<U8>(threads.size()); i < count; ++i)
+		{
+			workers[i].Run = true;
+			threads.emplace_back(&ThreadPool::Worker, this, i);
+		}
+		if (activeWorkers < count)
+			activeWorkers = count;
+	}
+
+	Job* ThreadPool::AcquireJob() const noexcept
+	{
+		const bool isWorker = currentPool == this;
+		const U8 workersCount = activeWorkers.load(std::memory_order_acquire);
+		Job* job = nullptr;
+
+		// More important jobs first, checking all sources of jobs for given priority
+		for (U8 priority = 0; priority < PRIORITY_LEVELS; ++priority)
+		{
+			// Own queue is checked first since it's most likely to contain cache-hot data
+			if (isWorker && workers[currentWorker].Queues[priority].Pop(job))
+				break;
+
+			if (injectionCounts[priority].load(std::memory_order_acquire))
+			{
+				std::lock_guard lock(injectionMutex);
+				if (injectionQueues[priority].size())
+				{
+					job = injectionQueues[priority].front();
+					injectionQueues[priority].pop_front();
+					injectionCounts[priority].fetch_sub(1, std::memory_order_relaxed);
+					break;
+				}
+			}
+
+			// Steal oldest jobs from other workers, starting with next one to spread contention between them
+			const U8 start = isWorker ? currentWorker + 1 : 0;
+			for (U8 i = 0; i < workersCount; ++i)
+			{
+				const U8 victim = (start + i) % workersCount;
+				if (isWorker && victim == currentWorker)
+					continue;
+				if (workers[victim].Queues[priority].Steal(job))
+					break;
+				job = nullptr;
+			}
+			if (job)
+				break;
 		}
+
+		if (job)
+			pendingJobs.fetch_sub(1);
+		return job;
 	}
 
-	void ThreadPool::Worker(const BoolAtom& run) const noexcept
+	void ThreadPool::Worker(U8 index) const noexcept
 	{
+		currentPool = this;
+		currentWorker = index;
+		const BoolAtom& run = workers[index].Run;
+
 		// Process tasks till stopped by master thread
 		while (true)
 		{
-			bool newItem = false;
-			std::function<void()> task;
-
-			// Creating local mutex because access to task queue is protected by more efficient one
-			std::mutex mutex;
-			std::unique_lock lock(mutex);
-			// Wait for new task and try obtain it (more important jobs first)
-			signaler.wait(lock, [this, &run, &newItem, &task]() -> bool
-				{
-					for (auto& queue : taskQueues)
-					{
-						newItem = queue.TryPopFront(task);
-						if (newItem)
-							break;
-					}
-					return newItem || !(run && runControl);
-				});
-
-			// Don't stop when task queue is not empty
-			if ((run || runControl) && !newItem)
+			if (Job* job = AcquireJob())
+			{
+				job->Execute();
+				continue;
+			}
+
+			// Don't stop when there are still jobs left to process
+			if (!(run && runControl))
 				return;
-			task();
+
+			// Wait for new job to be submitted
+			sleepingWorkers.fetch_add(1);
+			{
+				std::unique_lock lock(sleepMutex);
+				signaler.wait(lock, [this, &run]() -> bool { return pendingJobs.load() > 0 || !(run && runControl); });
+			}
+			sleepingWorkers.fetch_sub(1);
 		}
 	}
 
@@ -122,10 +184,50 @@ namespace ZE
 	ThreadPool::~ThreadPool()
 	{
 		runControl = false;
-		signaler.notify_all();
+		{
+			std::lock_guard lock(sleepMutex);
+			signaler.notify_all();
+		}
 		for (std::thread& worker : threads)
 			worker.join();
-		if (threadRunControls)
-			threadRunControls.DeleteArray();
+		if (workers)
+			workers.DeleteArray();
+	}
+
+	void ThreadPool::Submit(ThreadPriority priority, Job& job) const noexcept
+	{
+		ZE_ASSERT(!job.IsEmpty(), "Submitting empty job!");
+
+		// Without workers to process it, perform job in place
+		if (activeWorkers == 0 || !runControl)
+		{
+			job.Execute();
+			return;
+		}
+
+		// Increment before job is visible so it can never be seen as negative
+		const U8 index = static_cast<U8>(priority);
+		pendingJobs.fetch_add(1);
+		if (currentPool != this || !workers[currentWorker].Queues[index].Push(&job))
+		{
+			std::lock_guard lock(injectionMutex);
+			injectionQueues[index].emplace_back(&job);
+			injectionCounts[index].fetch_add(1, std::memory_order_release);
+		}
+
+		// Wake up worker only when any of them is sleeping, avoiding system call on hot path
+		if (sleepingWorkers.load() > 0)
+		{
+			std::lock_guard lock(sleepMutex);
+			signaler.notify_one();
+		}
+	}
+
+	bool ThreadPool::ExecutePendingJob() const noexcept
+	{
+		Job* job = AcquireJob();
+		if (job)
+			job->Execute();
+		return job != nullptr;
 	}
 }
\ No newline at end of file
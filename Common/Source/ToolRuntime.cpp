@@ -0,0 +1,39 @@
+#include "ToolRuntime.h"
+#include <filesystem>
+
+namespace ZE
+{
+	bool ToolRuntime::IsDependent(const ToolJobFiles& earlier, const ToolJobFiles& job) noexcept
+	{
+		auto isSameFile = [](std::string_view first, std::string_view second) -> bool
+			{
+				return std::filesystem::path(first).lexically_normal() == std::filesystem::path(second).lexically_normal();
+			};
+		auto containsAny = [&isSameFile](const std::vector<std::string_view>& files, const std::vector<std::string_view>& searched) -> bool
+			{
+				for (std::string_view file : files)
+					for (std::string_view other : searched)
+						if (isSameFile(file, other))
+							return true;
+				return false;
+			};
+
+		return containsAny(earlier.Outputs, job.Inputs) || containsAny(earlier.Outputs, job.Outputs) || containsAny(earlier.Inputs, job.Outputs);
+	}
+
+	ToolRuntime::ToolRuntime(U32 cores) noexcept
+		: threadsCount(std::clamp(cores, 1U, static_cast<U32>(UINT8_MAX)))
+	{
+		// Custom count of UINT8_MAX means that no workers are created and everything runs on calling thread
+		pool.Init(0, threadsCount > 1 ? Utils::SafeCast<U8>(threadsCount - 1) : UINT8_MAX);
+	}
+
+	void ToolRuntime::AddTiles(std::vector<ToolTile>& tiles, U32 width, U32 height, U32 tileWidth, U32 tileHeight, U16 slice, U16 level) noexcept
+	{
+		ZE_ASSERT(tileWidth && tileHeight, "Tile cannot be empty!");
+
+		for (U32 y = 0; y < height; y += tileHeight)
+			for (U32 x = 0; x < width; x += tileWidth)
+				tiles.emplace_back(slice, level, x, y, std::min(tileWidth, width - x), std::min(tileHeight, height - y));
+	}
+}
\ No newline at end of file
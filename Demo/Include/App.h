@@ -27,7 +27,6 @@ class App final
 	void ShowOptionsWindow();
 	void BuiltObjectTree(EID currentEntity, EID& selected);
 	void ShowObjectWindow();
-	void PropagateTransformChange(EID childEntity);
 
 	void AddModelButton();
 	void ChangeBackgroundButton();
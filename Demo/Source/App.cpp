@@ -143,19 +143,7 @@ void App::ProcessInput()
 	}
 
 	if (cameraChanged)
-	{
-		if (Settings::Data.try_get<ParentID>(currentCamera))
-			PropagateTransformChange(currentCamera);
-		else
-		{
-			Settings::Data.get<Data::TransformGlobal>(currentCamera) = static_cast<Data::TransformGlobal>(Settings::Data.get<Data::Transform>(currentCamera));
-			if (Children* children = Settings::Data.try_get<Children>(currentCamera))
-			{
-				for (EID child : children->Childs)
-					PropagateTransformChange(child);
-			}
-		}
-	}
+		Data::MarkTransformDirty(currentCamera);
 }
 
 void App::ShowOptionsWindow()
@@ -302,19 +290,7 @@ void App::ShowObjectWindow()
 				ImGui::Columns(1);
 
 				if (change)
-				{
-					if (Settings::Data.try_get<ParentID>(selected))
-						PropagateTransformChange(selected);
-					else
-					{
-						Settings::Data.get<Data::TransformGlobal>(selected) = static_cast<Data::TransformGlobal>(transform);
-						if (Children* children = Settings::Data.try_get<Children>(selected))
-						{
-							for (EID child : children->Childs)
-								PropagateTransformChange(child);
-						}
-					}
-				}
+					Data::MarkTransformDirty(selected);
 			}
 
 			if (Settings::Data.all_of<Data::MaterialID>(selected))
@@ -513,28 +489,6 @@ void App::ShowObjectWindow()
 	ImGui::End();
 }
 
-void App::PropagateTransformChange(EID childEntity)
-{
-	ZE_VALID_EID(childEntity);
-	ZE_ASSERT(Settings::Data.try_get<ParentID>(childEntity), "Incorrect child-parent structure defined!");
-
-	auto& parent = Settings::Data.get<Data::TransformGlobal>(Settings::Data.get<ParentID>(childEntity).ID);
-	auto& global = Settings::Data.get<Data::TransformGlobal>(childEntity);
-	auto& local = Settings::Data.get<Data::Transform>(childEntity);
-	Math::XMStoreFloat4(&global.Rotation,
-		Math::XMQuaternionNormalize(Math::XMQuaternionMultiply(Math::XMLoadFloat4(&parent.Rotation), Math::XMLoadFloat4(&local.Rotation))));
-	Math::XMStoreFloat3(&global.Position,
-		Math::XMVectorAdd(Math::XMLoadFloat3(&parent.Position), Math::XMLoadFloat3(&local.Position)));
-	Math::XMStoreFloat3(&global.Scale,
-		Math::XMVectorMultiply(Math::XMLoadFloat3(&parent.Scale), Math::XMLoadFloat3(&local.Scale)));
-
-	if (Children* children = Settings::Data.try_get<Children>(childEntity))
-	{
-		for (EID child : children->Childs)
-			PropagateTransformChange(child);
-	}
-}
-
 EID App::AddCamera(std::string&& name, float nearZ, float fov,
 	Float3&& position, const Float3& angle)
 {
@@ -724,13 +678,11 @@ App::App(const CmdParser& params)
 			const float angleZ = Math::Rand(0.0f, 360.0f, randEngine);
 			const float scale = Math::Rand(0.5f, 5.0f, randEngine);
 
-			auto& transform = Settings::Data.emplace<Data::TransformGlobal>(model,
+			Settings::Data.emplace<Data::TransformGlobal>(model,
 				Settings::Data.emplace<Data::Transform>(model,
 					Math::GetQuaternion(angleX, angleY, angleZ),
 					Math::RandPosition(-200.0f, 200.0f, randEngine),
 					Float3(scale, scale, scale)));
-			if (Settings::ComputeMotionVectors())
-				Settings::Data.emplace<Data::TransformPrevious>(model, transform);
 
 			Settings::Data.emplace<Data::RenderLambertian>(model);
 			Settings::Data.emplace<Data::ShadowCaster>(model);
@@ -790,13 +742,11 @@ App::App(const CmdParser& params)
 				EID model = Settings::CreateEntity();
 				Settings::Data.emplace<std::string>(model, "Sphere_Rgh_" + std::to_string(metalness) + "_Mtl_" + std::to_string(roughness));
 
-				auto& transform = Settings::Data.emplace<Data::TransformGlobal>(model,
+				Settings::Data.emplace<Data::TransformGlobal>(model,
 					Settings::Data.emplace<Data::Transform>(model,
 						Math::NoRotation(),
 						Float3(static_cast<float>(static_cast<S32>(roughness) - positionOffset) * 2.5f, static_cast<float>(static_cast<S32>(metalness) - positionOffset) * 2.5f, 0.0f),
 						Math::UnitScale()));
-				if (Settings::ComputeMotionVectors())
-					Settings::Data.emplace<Data::TransformPrevious>(model, transform);
 
 				Settings::Data.emplace<Data::RenderLambertian>(model);
 				Settings::Data.emplace<Data::ShadowCaster>(model);
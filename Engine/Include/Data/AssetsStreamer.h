@@ -6,6 +6,7 @@
 #include "MaterialPBR.h"
 #include "LOD.h"
 #include "ResourceLocation.h"
+#include <span>
 #if _ZE_EXTERNAL_MODEL_LOADING
 ZE_WARNING_PUSH
 #	include "assimp/Importer.hpp"
@@ -36,12 +37,17 @@ namespace ZE::Data
 		{
 			EID ResID;
 			IO::CompressionFormat Format;
-			std::unique_ptr<U8[]> CompressedBuffer;
-			U32 CompressedSize;
+			// Data inside mapped resource pack
+			std::span<const U8> Source;
 		};
 
 		static constexpr const char* RESOURCE_DIR = "Resources";
 		static constexpr const char* RESOURCE_FILE = "Resources/respack";
+		// Minimal fraction of entry size that have to be saved by automatically selected compression
+		static constexpr float MIN_COMPRESSION_SAVING = 0.05f;
+		// Compression dictionary is not trained for packs with only few small entries
+		static constexpr U32 MIN_DICTIONARY_SAMPLES = 16;
+		static constexpr U32 MAX_DICTIONARY_SIZE = 16 * 1024;
 
 		IO::DiskManager diskManager;
 		GFX::Resource::Texture::Library texSchemaLib;
@@ -60,13 +66,15 @@ namespace ZE::Data
 		constexpr GFX::Resource::Texture::Library& GetSchemaLib() noexcept { return texSchemaLib; }
 
 		Task<IO::FileStatus> LoadResourcePack(GFX::Device& dev, U16 packId) { return LoadResourcePack(dev, RESOURCE_FILE + std::to_string(packId) + RESOURCE_FILE_EXT); }
-		Task<IO::FileStatus> SaveResourcePack(GFX::Device& dev, U16 packId, IO::CompressionFormat defaultCompression) { return SaveResourcePack(dev, RESOURCE_FILE + std::to_string(packId) + RESOURCE_FILE_EXT, packId, defaultCompression); }
+		Task<IO::FileStatus> SaveResourcePack(GFX::Device& dev, U16 packId, IO::CompressionFormat defaultCompression, bool autoCompression = false) { return SaveResourcePack(dev, RESOURCE_FILE + std::to_string(packId) + RESOURCE_FILE_EXT, packId, defaultCompression, autoCompression); }
 
 		void Init(GFX::Device& dev);
 		void Free(GFX::Device& dev);
 
 		Task<IO::FileStatus> LoadResourcePack(GFX::Device& dev, std::string_view packFile);
-		Task<IO::FileStatus> SaveResourcePack(GFX::Device& dev, std::string_view packFile, U16 packId, IO::CompressionFormat defaultCompression);
+		// When 'autoCompression' is set, every entry without custom compression is checked against all codecs and the one
+		// with lowest load cost is selected, or entry is stored raw when compression doesn't save enough space
+		Task<IO::FileStatus> SaveResourcePack(GFX::Device& dev, std::string_view packFile, U16 packId, IO::CompressionFormat defaultCompression, bool autoCompression = false);
 
 #if _ZE_EXTERNAL_MODEL_LOADING
 		Task<MeshID> ParseMesh(GFX::Device& dev, const aiMesh& mesh);
@@ -32,15 +32,29 @@ namespace ZE::Data
 	// Indicates that material requires blending on already rendered geometry
 	struct MaterialBlend {};
 
+	// Entities are rendered only after world matrices have been created for them by the transform hierarchy
 	template<EmptyType T>
-	constexpr auto GetRenderGroup() noexcept { return Settings::Data.group<T>(entt::get<TransformGlobal, MaterialID, MeshID>); }
-	template<EmptyType T, typename Visibility>
-	constexpr auto GetVisibleRenderGroup() noexcept { return Settings::Data.group<Visibility>(entt::get<T, TransformGlobal, MaterialID, MeshID>); }
-
-	// Assure that all render components are registered as pools in data storage
-	constexpr void InitRenderComponents() noexcept { Settings::AssureEntityPools<RenderLambertian, RenderOutline, RenderWireframe, ShadowCaster, LightDirectional, LightSpot, LightPoint, MaterialTransparent, MaterialBlend>(); }
+	constexpr auto GetRenderGroup() noexcept { return Settings::Data.group<T>(entt::get<TransformGlobal, TransformMatrix, MaterialID, MeshID>); }
 
 	inline auto GetDirectionalLightGroup() noexcept { return Settings::Data.group<LightDirectional, DirectionalLight, Direction, DirectionalLightBuffer>(); }
 	inline auto GetSpotLightGroup() noexcept { return Settings::Data.group<LightSpot, SpotLight, SpotLightBuffer>(entt::get<TransformGlobal>); }
 	inline auto GetPointLightGroup() noexcept { return Settings::Data.group<LightPoint, PointLight, PointLightBuffer>(entt::get<TransformGlobal>); }
+
+	// Assure that all render components are registered as pools in data storage.
+	// Groups used by render passes are created upfront too as passes can be recorded by multiple threads
+	inline void InitRenderComponents() noexcept;
+
+#pragma region Functions
+	inline void InitRenderComponents() noexcept
+	{
+		Settings::AssureEntityPools<RenderLambertian, RenderOutline, RenderWireframe, ShadowCaster, LightDirectional, LightSpot, LightPoint, MaterialTransparent, MaterialBlend>();
+		GetRenderGroup<RenderLambertian>();
+		GetRenderGroup<RenderOutline>();
+		GetRenderGroup<RenderWireframe>();
+		GetRenderGroup<ShadowCaster>();
+		GetDirectionalLightGroup();
+		GetSpotLightGroup();
+		GetPointLightGroup();
+	}
+#pragma endregion
 }
\ No newline at end of file
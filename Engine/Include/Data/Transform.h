@@ -3,9 +3,9 @@
 
 namespace ZE::Data
 {
-	// Component allowing to place physical object in the scene.
-	// Ordering by non-decreasing parent, root entities at the end.
-	// If child entity have Transform then all parents should have said component too
+	// Component allowing to place physical object in the scene, relative to the parent entity.
+	// If child entity have Transform then all parents should have said component too.
+	// After changing it mark entity with TransformDirty to update it's TransformGlobal
 	struct Transform
 	{
 		Float4 Rotation;
@@ -15,6 +15,22 @@ namespace ZE::Data
 	struct TransformGlobal : public Transform {};
 	struct TransformPrevious : public TransformGlobal {};
 
+	// World matrix of the entity computed from TransformGlobal once per frame, stored transposed for direct use in shaders
+	struct TransformMatrix
+	{
+		Float4x4 ModelTps;
+	};
+	struct TransformMatrixPrevious : public TransformMatrix {};
+
+	// Indicates that local transform of the entity have changed and global transforms of it's whole subtree have to be recomputed
+	struct TransformDirty {};
+
 	// Assure that all transform components are registered as pools in data storage
-	constexpr void InitTransformComponents() noexcept { Settings::AssureEntityPools<Transform, TransformGlobal, TransformPrevious>(); }
+	constexpr void InitTransformComponents() noexcept { Settings::AssureEntityPools<Transform, TransformGlobal, TransformPrevious, TransformMatrix, TransformMatrixPrevious, TransformDirty>(); }
+	// Request update of global transform for given entity and all of it's children
+	inline void MarkTransformDirty(EID entity) noexcept { Settings::Data.emplace_or_replace<TransformDirty>(entity); }
+	// Apply local transform of the entity to global transform of it's parent
+	TransformGlobal ComputeGlobalTransform(const TransformGlobal& parent, const Transform& local) noexcept;
+	// Create world matrix for given global transform
+	TransformMatrix ComputeTransformMatrix(const TransformGlobal& global) noexcept;
 }
\ No newline at end of file
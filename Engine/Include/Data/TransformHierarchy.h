@@ -0,0 +1,49 @@
+#pragma once
+#include "Transform.h"
+
+namespace ZE::Data
+{
+	// Keeps all entities with transforms in flat parent-first order and recomputes global transforms along with world matrices
+	// of subtrees which roots have been marked with TransformDirty. Order is rebuilt when hierarchy changes.
+	// Previous frame transforms are always present for entities in hierarchy and only changed ones are updated
+	class TransformHierarchy final
+	{
+		// Entity in hierarchy with position of it's parent inside flat storage
+		struct Node
+		{
+			EID Entity;
+			U32 Parent;
+		};
+
+		static constexpr U32 NO_PARENT = UINT32_MAX;
+		static constexpr U32 NO_NODE = UINT32_MAX;
+		// Global transform of the node have to be recomputed
+		static constexpr U8 NODE_CHANGED = 1;
+		// Node have been marked with TransformDirty, only then local transform of the root is used as it's global one
+		static constexpr U8 NODE_MARKED = 2;
+
+		bool rebuildOrder = true;
+		bool transformsChanged = false;
+		// Nodes in depth-first order, every root is followed by it's whole subtree
+		std::vector<Node> nodes;
+		// Start of every root subtree in nodes, ending with total size of the nodes
+		std::vector<U32> roots;
+		// Position of the node for every entity index, used to find nodes of entities marked with TransformDirty
+		std::vector<U32> nodeIndices;
+		// Flags of nodes changed in current frame, kept till previous transforms are updated
+		std::vector<U8> dirty;
+
+		void OnHierarchyChange(Storage&, EID) noexcept { rebuildOrder = true; }
+		void RebuildOrder() noexcept;
+
+	public:
+		TransformHierarchy() noexcept;
+		ZE_CLASS_DELETE(TransformHierarchy);
+		~TransformHierarchy();
+
+		// Recompute global transforms and matrices of all changed entities along with their children and clear dirty markers
+		void Update() noexcept;
+		// Move current transforms and matrices into previous state for entities changed in current frame
+		void UpdatePrevious() noexcept;
+	};
+}
\ No newline at end of file
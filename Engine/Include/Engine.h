@@ -1,4 +1,5 @@
 #pragma once
+#include "Data/TransformHierarchy.h"
 #include "GFX/Pipeline/RenderGraph.h"
 #include "GUI/ImGuiManager.h"
 #include "StartupConfig.h"
@@ -17,6 +18,7 @@ namespace ZE
 		GFX::Pipeline::RenderGraphBuilder graphBuilder;
 		GFX::Pipeline::RenderGraph renderGraph;
 		Data::AssetsStreamer assets;
+		Data::TransformHierarchy transforms;
 		std::bitset<Flags::Count> flags;
 
 		bool UploadSync();
@@ -0,0 +1,76 @@
+#pragma once
+#include "Data/Tags.h"
+#include "Allocator/FrameArena.h"
+#include <ranges>
+
+namespace ZE::GFX
+{
+	// World space bounding boxes of entities from single render group stored as structure of arrays,
+	// allowing for frustum checks of multiple boxes at once. Boxes are recomputed only when entity transform changes
+	class CullingCache final
+	{
+		// Maximal number of boxes checked in single iteration, box arrays are padded to multiple of it
+		static constexpr U32 BATCH_SIZE = 8;
+
+		// Data used for computation of world space box, allows to detect changes in entity
+		struct Source
+		{
+			EID Entity = INVALID_EID;
+			EID Mesh = INVALID_EID;
+			Data::TransformGlobal Transform;
+		};
+
+		U32 count = 0;
+		std::vector<Source> sources;
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> centerZ;
+		std::vector<float> extentX;
+		std::vector<float> extentY;
+		std::vector<float> extentZ;
+
+		void Resize(U32 size) noexcept;
+		void UpdateBox(U32 index) noexcept;
+
+	public:
+		CullingCache() = default;
+		ZE_CLASS_MOVE(CullingCache);
+		~CullingCache() = default;
+
+		constexpr U32 GetSize() const noexcept { return count; }
+		constexpr EID GetEntity(U32 index) const noexcept { ZE_ASSERT(index < count, "Accessing culling cache out of bounds!"); return sources[index].Entity; }
+
+		// Synchronize cached boxes with all entities in render group (containing TransformGlobal and MeshID),
+		// index of every entity in cache is the same as it's position in the group
+		void Update(const auto& group) noexcept;
+		// Fills list with indices of boxes intersecting with frustum in ascending order
+		void Cull(const Math::BoundingFrustum& frustum, Allocator::FrameVector<U32>& visibleIndices) const noexcept;
+	};
+
+#pragma region Functions
+	void CullingCache::Update(const auto& group) noexcept
+	{
+		const U32 size = Utils::SafeCast<U32>(group.size());
+		if (size != count)
+			Resize(size);
+
+		Settings::GetThreadPool().ParallelFor(std::views::iota(0U, count), 0, [&](U32 i)
+			{
+				const EID entity = group[i];
+				const auto& transform = group.get<Data::TransformGlobal>(entity);
+				const EID mesh = group.get<Data::MeshID>(entity).ID;
+
+				// Only boxes of changed entities are transformed again
+				Source& source = sources[i];
+				if (source.Entity != entity || source.Mesh != mesh
+					|| std::memcmp(&source.Transform, &transform, sizeof(Data::TransformGlobal)) != 0)
+				{
+					source.Entity = entity;
+					source.Mesh = mesh;
+					source.Transform = transform;
+					UpdateBox(i);
+				}
+			});
+	}
+#pragma endregion
+}
\ No newline at end of file
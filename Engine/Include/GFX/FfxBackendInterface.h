@@ -41,6 +41,9 @@ namespace ZE::GFX::FFX
 
 	// Set information about current pass for creation of internal buffers. Need to be called before and after Init/Update pass calls
 	void SetCurrentPass(FfxInterface& backendInterface, const PassInfo* info) noexcept;
+	// All effects share single backend context so only one of them can record it's commands at once,
+	// lock has to be held during dispatch of any effect
+	std::mutex& GetDispatchLock() noexcept;
 
 	// Free up FFX SDK backend interface
 	void DestroyInterface(FfxInterface& backendInterface) noexcept;
@@ -14,9 +14,8 @@ namespace ZE::GFX::Pipeline
 		NoMemoryAliasing = 0x01,
 		// Enable printing of FrameBuffer memory allocation for supported APIs (not possible on release builds)
 		DebugMemoryPrint = 0x02,
-		// Use matrix-based algorithm for creation of FrameBuffer in DX12
+		// Use previous matrix-based algorithm for packing FrameBuffer memory in DX12 instead of interval placement, kept for comparison
 		MatrixCreationAlgorithmDX12 = 0x04,
-		FavorCreationSpeed = MatrixCreationAlgorithmDX12,
 	};
 
 	ZE_ENUM_OPERATORS(FrameBufferFlag, FrameBufferFlags);
@@ -0,0 +1,23 @@
+#pragma once
+#include "Types.h"
+
+namespace ZE::GFX::Pipeline
+{
+	// Single resource to be placed in transient memory shared between resources with disjoint lifetimes.
+	// Sizes and offsets are expressed in chunks of minimal resource alignment used by given heap
+	struct AliasingRegion
+	{
+		U32 Chunks = 0;
+		U32 ChunkAlignment = 1;
+		// Pass levels when resource is in use as range [start:end)
+		U32 StartLevel = 0;
+		U32 EndLevel = 0;
+		// Computed placement in the memory
+		U32 ChunkOffset = 0;
+	};
+
+	// Assigns memory offsets for all regions so no two regions alive at the same pass level overlap, returns required memory size in chunks.
+	// Regions are placed in given order (best results when sorted descending by size) in the smallest free gap between
+	// regions with overlapping lifetimes, memory grows only when no gap can fit region. Runs in O(N^2) time independent of memory size and level count
+	U32 PlanMemoryAliasing(AliasingRegion* regions, U32 count) noexcept;
+}
\ No newline at end of file
@@ -121,19 +121,45 @@ namespace ZE::GFX::Pipeline
 			std::vector<BarrierTransition> EndBarriers;
 		};
 
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		// Separate command lists for every pass in execution group when they are recorded by multiple threads
+		struct WorkerLists
+		{
+			std::vector<CommandList> Main;
+			std::vector<CommandList> Async;
+		};
+#endif
+
+		// Number of frames after which average recording times of pass groups are logged
+		static constexpr U64 RECORD_TIMING_FRAMES = 500;
+
 		std::unique_ptr<std::array<ExecutionGroup, 2>[]> passExecGroups;
 		U32 execGroupCount = 0;
 		RendererPassExecuteData execData;
 		ChainPool<CommandList> asyncListChain;
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		ChainPool<WorkerLists> workerLists;
+#endif
 		ChainPool<Resource::DynamicCBuffer> dynamicBuffers;
 		Data::Library<U32, std::pair<PtrVoid, PassCleanCallback>> passExecData;
 		FfxInterface ffxInterface = {};
 		Data::Library<S32, FFX::InternalResourceDescription> ffxInternalBuffers;
 		bool ffxBuffersChanged = false;
 		GraphFinalizeFlags finalizationFlags = 0;
+		// Accumulated CPU time of recording for every pass group in order of execution
+		std::vector<double> recordTimings;
+		U64 timedFrames = 0;
 
 		void PrepareFrameResources(Device& dev, SwapChain& swapChain);
 		void UnloadConfig(Device& dev) noexcept;
+		void SaveRecordTiming(U32 groupIndex, double startTime) noexcept;
+		void LogRecordTimings() noexcept;
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		// Only groups with multiple passes that can run in parallel are worth recording by worker threads
+		static bool IsRecordedInParallel(const ExecutionGroup& group) noexcept;
+		// Record passes of every parallel group at once into separate command lists and submit them in order
+		void RecordParallel(Device& dev, ExecutionGroup& group, std::vector<CommandList>& lists, QueueType queue, U32& timingIndex);
+#endif
 
 	public:
 		RenderGraph() = default;
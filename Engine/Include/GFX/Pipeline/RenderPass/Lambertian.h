@@ -1,14 +1,10 @@
 #pragma once
 #include "GFX/Pipeline/PassDesc.h"
 #include "GFX/Resource/PipelineStateGfx.h"
+#include "GFX/CullingCache.h"
 
 namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 {
-	// Indicates that entity is inside view frustum
-	struct InsideFrustumSolid { Resource::DynamicBufferAlloc Transform; };
-	// Indicates that entity is inside view frustum and is not opaque
-	struct InsideFrustumNotSolid {};
-
 	struct Resources
 	{
 		RID DepthStencil;
@@ -25,6 +21,7 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 		Resource::PipelineStateGfx StateDepth;
 		Ptr<Resource::PipelineStateGfx> StatesSolid;
 		Ptr<Resource::PipelineStateGfx> StatesTransparent;
+		CullingCache Culling;
 		bool MotionEnabled;
 		bool ReactiveEnabled;
 	};
@@ -1,13 +1,10 @@
 #pragma once
 #include "GFX/Pipeline/PassDesc.h"
 #include "GFX/Resource/PipelineStateGfx.h"
-#
+#include "GFX/CullingCache.h"
 
 namespace ZE::GFX::Pipeline::RenderPass::OutlineDraw
 {
-	// Indicates that entity is inside view frustum
-	struct InsideFrustum { Resource::DynamicBufferAlloc Transform; };
-
 	struct Resources
 	{
 		RID RenderTarget;
@@ -19,6 +16,7 @@ namespace ZE::GFX::Pipeline::RenderPass::OutlineDraw
 		U32 BindingIndex;
 		Resource::PipelineStateGfx StateStencil;
 		Resource::PipelineStateGfx StateRender;
+		CullingCache Culling;
 	};
 
 	constexpr bool Evaluate() noexcept { return true; } // TODO: check input data
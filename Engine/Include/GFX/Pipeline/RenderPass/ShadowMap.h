@@ -1,16 +1,12 @@
 #pragma once
 #include "GFX/Pipeline/PassDesc.h"
 #include "GFX/Resource/PipelineStateGfx.h"
+#include "GFX/CullingCache.h"
 
 namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 {
 	constexpr Data::PBRFlags SHADOW_PERMUTATIONS = { Data::MaterialPBR::IsTransparent | Data::MaterialPBR::UseParallaxTex };
 
-	// Indicates that entity is inside view frustum
-	struct InsideFrustumSolid { Resource::DynamicBufferAlloc Transform; };
-	// Indicates that entity is inside view frustum and is not opaque
-	struct InsideFrustumNotSolid {};
-
 	struct Resources
 	{
 		RID RenderTarget;
@@ -24,6 +20,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 		Ptr<Resource::PipelineStateGfx> StatesSolid;
 		Ptr<Resource::PipelineStateGfx> StatesTransparent;
 		Float4x4 Projection;
+		CullingCache Culling;
 	};
 
 	void Clean(Device& dev, ExecuteData& data) noexcept;
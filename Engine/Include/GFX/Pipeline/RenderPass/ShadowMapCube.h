@@ -6,11 +6,6 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 {
 	constexpr Data::PBRFlags SHADOW_PERMUTATIONS = { Data::MaterialPBR::IsTransparent | Data::MaterialPBR::UseParallaxTex };
 
-	// Indicates that material of the geometry can be processed in depth pre-pass
-	struct Solid { Resource::DynamicBufferAlloc Transform; };
-	// Indicates that material of the geometry cannot be processed in depth pre-pass
-	struct Transparent {};
-
 	struct Resources
 	{
 		RID RenderTarget;
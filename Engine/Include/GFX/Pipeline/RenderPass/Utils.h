@@ -1,74 +1,136 @@
 #pragma once
+#include "GFX/Resource/DynamicBufferAlloc.h"
+#include "GFX/CullingCache.h"
 #include "GFX/TransformBuffer.h"
 #include "Data/CubemapSource.h"
 #include "Data/Tags.h"
-#include <type_traits>
+#include "Allocator/FrameArena.h"
+#include <bit>
 
 namespace ZE::GFX::Pipeline::RenderPass::Utils
 {
 	// Order for view sorting objects
 	enum class Sort : bool { Ascending, Descending };
 
-	// Perform frustum culling on entities in a group and emplace `Visibility` components on those inside camera frustum.
-	// `VisibilitySolid` component is added only to entities which material is not transparent,
-	// to other ones `VisibilityTransparent` is added. Specify both as same component to avoid whole material check.
-	template<typename VisibilitySolid, typename VisibilityTransparent>
-	constexpr void FrustumCulling(const auto& group, const Math::BoundingFrustum& frustum) noexcept;
+	// Entity visible in current view along with transform data that can be allocated for it by the pass
+	struct VisibleEntity
+	{
+		EID Entity;
+		Resource::DynamicBufferAlloc Transform;
+	};
+
+	// Dense list of entities visible in single view, allocated from frame arena so valid only during current frame
+	struct VisibilityBuffer
+	{
+		U32 Count = 0;
+		VisibleEntity* Entities = nullptr;
+	};
+
+	// Sorting key of single entity in visibility buffer
+	struct SortEntry
+	{
+		U64 Key;
+		U32 Index;
+	};
+
+	// Perform frustum culling on entities in a group and fill visibility buffers with those inside camera frustum.
+	// `solid` buffer gets only entities which material is not transparent, other ones are placed in `transparent` buffer.
+	// Don't specify transparent buffer to avoid whole material check and place all visible entities in `solid` buffer.
+	// Culling cache holds world space bounds of entities and should be always used with the same group.
+	void FrustumCulling(const auto& group, CullingCache& cache, const Math::BoundingFrustum& frustum,
+		Allocator::FrameArena& arena, VisibilityBuffer& solid, VisibilityBuffer* transparent = nullptr) noexcept;
+
+	// Compute squared distance of the entity from camera
+	inline float GetViewDistance(EID entity, const Vector& cameraPos) noexcept;
+	// Create key for ordering draw calls, composed of (starting from most significant bits)
+	// pipeline state number, material index and quantized distance from camera
+	constexpr U64 GetDrawKey(U8 state, EID material, float distance) noexcept;
+	// Sort entities in ascending order of their keys with LSD radix sort, entries are modified during sorting
+	void KeySort(VisibilityBuffer& buffer, SortEntry* entries, Allocator::FrameArena& arena) noexcept;
 
 	// Sort entities according to distance from camera
 	template<Sort ORDER>
-	constexpr void ViewSort(auto& group, const Vector& cameraPos) noexcept;
+	void ViewSort(VisibilityBuffer& buffer, const Vector& cameraPos, Allocator::FrameArena& arena) noexcept;
 	// Sort entities front-back according to distance from camera
-	constexpr void ViewSortAscending(auto& group, const Vector& cameraPos) noexcept { ViewSort<Sort::Ascending>(group, cameraPos); }
+	inline void ViewSortAscending(VisibilityBuffer& buffer, const Vector& cameraPos, Allocator::FrameArena& arena) noexcept { ViewSort<Sort::Ascending>(buffer, cameraPos, arena); }
 	// Sort entities back-front according to distance from camera
-	constexpr void ViewSortDescending(auto& group, const Vector& cameraPos) noexcept { ViewSort<Sort::Descending>(group, cameraPos); }
+	inline void ViewSortDescending(VisibilityBuffer& buffer, const Vector& cameraPos, Allocator::FrameArena& arena) noexcept { ViewSort<Sort::Descending>(buffer, cameraPos, arena); }
+	// Sort entities according to draw keys to minimize pipeline state and material switches, inside single material they are ordered front-back.
+	// Pipeline state number used by material is returned from `getState(EID material) -> U8`
+	void DrawKeySort(VisibilityBuffer& buffer, const Vector& cameraPos, Allocator::FrameArena& arena, auto&& getState) noexcept;
 
 	// Display information about current cubemap source in debug UI
 	void ShowCubemapDebugUI(const char* title, const Data::CubemapSource& source, const char* newSourceDir, Data::CubemapSource& newSource, bool& updateData, bool& updateError) noexcept;
 
 #pragma region Functions
-	template<typename VisibilitySolid, typename VisibilityTransparent>
-	constexpr void FrustumCulling(const auto& group, const Math::BoundingFrustum& frustum) noexcept
+	void FrustumCulling(const auto& group, CullingCache& cache, const Math::BoundingFrustum& frustum,
+		Allocator::FrameArena& arena, VisibilityBuffer& solid, VisibilityBuffer* transparent) noexcept
 	{
-		for (EID entity : group)
-		{
-			const auto& transform = group.get<Data::TransformGlobal>(entity);
+		cache.Update(group);
+		Allocator::FrameVector<U32> visibleIndices(arena);
+		cache.Cull(frustum, visibleIndices);
+		const U32 visibleCount = ZE::Utils::SafeCast<U32>(visibleIndices.size());
 
-			Math::BoundingBox box = Settings::Data.get<Math::BoundingBox>(group.get<Data::MeshID>(entity).ID);
-			box.Transform(box, Math::GetTransform(transform.Position, transform.Rotation, transform.Scale));
+		// Both buffers have to be prepared for all visible entities being placed inside of them
+		solid.Count = 0;
+		solid.Entities = arena.Alloc<VisibleEntity>(visibleCount);
+		if (transparent)
+		{
+			transparent->Count = 0;
+			transparent->Entities = arena.Alloc<VisibleEntity>(visibleCount);
+		}
 
-			// Mark entity as visible
-			if (frustum.Intersects(box)
-#if !_ZE_MODE_RELEASE
-				|| Settings::IsEnabledNoCulling()
-#endif
-				)
-			{
-				if constexpr (std::is_same_v<VisibilitySolid, VisibilityTransparent>)
-					Settings::Data.emplace<VisibilitySolid>(entity);
-				else
-				{
-					if (Settings::Data.all_of<Data::MaterialTransparent>(group.get<Data::MaterialID>(entity).ID))
-						Settings::Data.emplace<VisibilityTransparent>(entity);
-					else
-						Settings::Data.emplace<VisibilitySolid>(entity);
-				}
-			}
+		for (U32 index : visibleIndices)
+		{
+			const EID entity = cache.GetEntity(index);
+			if (transparent && Settings::Data.all_of<Data::MaterialTransparent>(group.get<Data::MaterialID>(entity).ID))
+				transparent->Entities[transparent->Count++].Entity = entity;
+			else
+				solid.Entities[solid.Count++].Entity = entity;
 		}
 	}
 
+	inline float GetViewDistance(EID entity, const Vector& cameraPos) noexcept
+	{
+		return Math::XMVectorGetX(Math::XMVector3LengthSq(Math::XMVectorSubtract(
+			Math::XMLoadFloat3(&Settings::Data.get<Data::TransformGlobal>(entity).Position), cameraPos)));
+	}
+
+	constexpr U64 GetDrawKey(U8 state, EID material, float distance) noexcept
+	{
+		// Bits of positive floats keep their ordering so distance can be used directly as integer
+		return (static_cast<U64>(state) << 56)
+			| (static_cast<U64>(entt::to_entity(material) & 0xFFFFFF) << 32)
+			| std::bit_cast<U32>(distance);
+	}
+
 	template<Sort ORDER>
-	constexpr void ViewSort(auto& group, const Vector& cameraPos) noexcept
+	void ViewSort(VisibilityBuffer& buffer, const Vector& cameraPos, Allocator::FrameArena& arena) noexcept
+	{
+		SortEntry* entries = arena.Alloc<SortEntry>(buffer.Count);
+		for (U32 i = 0; i < buffer.Count; ++i)
+		{
+			const U32 distance = std::bit_cast<U32>(GetViewDistance(buffer.Entities[i].Entity, cameraPos));
+			if constexpr (ORDER == Sort::Ascending)
+				entries[i].Key = distance;
+			else if constexpr (ORDER == Sort::Descending)
+				entries[i].Key = ~distance;
+			entries[i].Index = i;
+		}
+		KeySort(buffer, entries, arena);
+	}
+
+	void DrawKeySort(VisibilityBuffer& buffer, const Vector& cameraPos, Allocator::FrameArena& arena, auto&& getState) noexcept
 	{
-		group.sort<Data::TransformGlobal>([&cameraPos](const Data::TransformGlobal& t1, const Data::TransformGlobal& t2) -> bool
-			{
-				const float len1 = Math::XMVectorGetX(Math::XMVector3Length(Math::XMVectorSubtract(Math::XMLoadFloat3(&t1.Position), cameraPos)));
-				const float len2 = Math::XMVectorGetX(Math::XMVector3Length(Math::XMVectorSubtract(Math::XMLoadFloat3(&t2.Position), cameraPos)));
-				if constexpr (ORDER == Sort::Ascending)
-					return len1 < len2;
-				else if constexpr (ORDER == Sort::Descending)
-					return len1 > len2;
-			});
+		SortEntry* entries = arena.Alloc<SortEntry>(buffer.Count);
+		for (U32 i = 0; i < buffer.Count; ++i)
+		{
+			const EID entity = buffer.Entities[i].Entity;
+			const EID material = Settings::Data.get<Data::MaterialID>(entity).ID;
+			entries[i].Key = GetDrawKey(getState(material), material, GetViewDistance(entity, cameraPos));
+			entries[i].Index = i;
+		}
+		KeySort(buffer, entries, arena);
 	}
 #pragma endregion
 }
\ No newline at end of file
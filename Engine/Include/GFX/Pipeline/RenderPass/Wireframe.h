@@ -1,12 +1,10 @@
 #pragma once
 #include "GFX/Pipeline/PassDesc.h"
 #include "GFX/Resource/PipelineStateGfx.h"
+#include "GFX/CullingCache.h"
 
 namespace ZE::GFX::Pipeline::RenderPass::Wireframe
 {
-	// Indicates that entity is inside view frustum
-	struct InsideFrustum {};
-
 	struct Resources
 	{
 		RID RenderTarget;
@@ -17,6 +15,7 @@ namespace ZE::GFX::Pipeline::RenderPass::Wireframe
 	{
 		U32 BindingIndex;
 		Resource::PipelineStateGfx State;
+		CullingCache Culling;
 	};
 
 	constexpr bool Evaluate() noexcept { return true; } // TODO: check input element count
@@ -6,6 +6,7 @@
 #include "GFX/Resource/Shader.h"
 #include "FrameBuffer.h"
 #include "RendererData.h"
+#include "Allocator/FrameArena.h"
 
 namespace ZE::GFX::Pipeline
 {
@@ -57,6 +58,8 @@ namespace ZE::GFX::Pipeline
 		Resource::CBuffer SettingsBuffer;
 		// Current dynamic constant buffer used for uploading data to GPU
 		Ptr<Resource::DynamicCBuffer> DynamicBuffer;
+		// Memory for transient data of the passes, released at the start of every frame
+		Allocator::FrameArena FrameArena;
 		RendererSettingsData SettingsData;
 		RendererDynamicData DynamicData;
 		RendererGraphData GraphData;
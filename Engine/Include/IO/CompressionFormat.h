@@ -8,5 +8,56 @@ namespace ZE::IO
 		None,
 		ZLib,
 		Bzip2,
+		// Fastest decompression, favors speed of compression over ratio
+		Lz4,
+		// Same stream format as Lz4 (and decompression speed) but with much better ratio, slow to compress
+		Lz4HC,
+		// Ratio close to ZLib at maximal level with decompression speed a few times faster
+		Zstd,
+		// Zstd using dictionary stored in resource pack, improves ratio of small buffers. Only decompressed on CPU
+		ZstdDictionary,
 	};
+
+	// Convert enum code to string representation for display
+	constexpr const char* GetCompressionFormatString(CompressionFormat format) noexcept;
+	// Format that data decompressed on GPU is stored with, as it cannot use dictionary or compression only variants
+	constexpr CompressionFormat GetGpuCompressionFormat(CompressionFormat format) noexcept;
+
+#pragma region Functions
+	constexpr const char* GetCompressionFormatString(CompressionFormat format) noexcept
+	{
+		switch (format)
+		{
+		case CompressionFormat::None:
+			return "None";
+		case CompressionFormat::ZLib:
+			return "ZLib";
+		case CompressionFormat::Bzip2:
+			return "Bzip2";
+		case CompressionFormat::Lz4:
+			return "LZ4";
+		case CompressionFormat::Lz4HC:
+			return "LZ4 HC";
+		case CompressionFormat::Zstd:
+			return "Zstd";
+		case CompressionFormat::ZstdDictionary:
+			return "Zstd (dictionary)";
+		default:
+			return "UNKNOWN";
+		}
+	}
+
+	constexpr CompressionFormat GetGpuCompressionFormat(CompressionFormat format) noexcept
+	{
+		switch (format)
+		{
+		case CompressionFormat::Lz4HC:
+			return CompressionFormat::Lz4;
+		case CompressionFormat::ZstdDictionary:
+			return CompressionFormat::Zstd;
+		default:
+			return format;
+		}
+	}
+#pragma endregion
 }
\ No newline at end of file
@@ -3,18 +3,97 @@
 
 namespace ZE::IO
 {
-	// Compression codec that is capable of performing CPU side compression and decompression
+	// Compression codec that is capable of performing CPU side compression and decompression.
+	// Data bigger than single block is split into independently compressed blocks that are processed in parallel:
+	//
+	// U32 BlockSize
+	// U32 BlockCount
+	// U32 BlockEnd[BlockCount] (offsets after the block table, block stored raw when it's size equals uncompressed one)
+	// Block data[]
+	//
+	// Every stream is ended with original data size followed by flag marking chunked layout (set only since resource pack version 1.1.0)
 	class Compressor final
 	{
+		// Size of footer ending every compressed stream
+		static constexpr U32 FOOTER_SIZE = sizeof(U32) + 2;
+
+		// Disk throughput in MB/s assumed when estimating load cost of compressed data, kept low to not favor
+		// the fastest codecs on every machine
+		static constexpr U32 ASSUMED_READ_SPEED = 500;
+
 		CompressionFormat format;
+		S32 level;
+		const void* dictionary = nullptr;
+		U32 dictionarySize = 0;
+
+		// Compresses single continuous stream without footer
+		void CompressBlock(const void* input, U32 inputSize, std::vector<U8>& output) const noexcept;
+		void DecompressBlock(const void* src, U32 srcSize, void* dst, U32 dstSize) const noexcept;
 
 	public:
-		constexpr Compressor(CompressionFormat format) noexcept : format(format) { ZE_ASSERT(format != CompressionFormat::None, "Compression codec not needed!"); }
+		// Level used by codec when not specified, best ratio for ZLib, Bzip2 and Lz4HC, default acceleration for Lz4
+		// and high ratio for Zstd (since it's mainly used for offline packing)
+		static constexpr S32 DEFAULT_LEVEL = 0;
+		// Size of uncompressed data in single block of chunked stream
+		static constexpr U32 BLOCK_SIZE = 256 * 1024;
+
+		// Level meaning depends on format: acceleration for Lz4 (higher is faster), [1..12] for Lz4HC, [1..22] for Zstd,
+		// [1..9] for ZLib and Bzip2. Decompression doesn't depend on the level used
+		constexpr Compressor(CompressionFormat format, S32 level = DEFAULT_LEVEL) noexcept : format(format), level(level) { ZE_ASSERT(format != CompressionFormat::None, "Compression codec not needed!"); }
 		ZE_CLASS_MOVE(Compressor);
 		~Compressor() = default;
 
+		// Approximate single core decompression speed in MB/s
+		static constexpr U32 GetDecodeSpeed(CompressionFormat format) noexcept;
+		// Estimated time in nanoseconds for reading and decompressing the data
+		static constexpr U64 GetLoadCost(CompressionFormat format, U64 compressedSize, U64 uncompressedSize) noexcept;
+		// Trains Zstd dictionary on concatenated samples, returns empty dictionary when there is not enough data for training
+		static std::vector<U8> TrainDictionary(const std::vector<U8>& samples, const std::vector<size_t>& sampleSizes, U32 maxSize) noexcept;
+		// Compresses data with every codec suitable for runtime loading and returns the one with lowest load cost.
+		// When none of them saves at least 'minSaving' fraction of the input, None is returned and output is left empty.
+		// ZstdDictionary is tried instead of Zstd when dictionary is passed
+		static CompressionFormat CompressBest(const void* input, U32 inputSize, float minSaving, std::vector<U8>& output,
+			const void* dictionary = nullptr, U32 dictionarySize = 0) noexcept;
+
+		// Dictionary have to be alive during whole usage of the codec, only used by ZstdDictionary format
+		constexpr void SetDictionary(const void* dict, U32 size) noexcept { dictionary = dict; dictionarySize = size; }
+
 		U32 GetOriginalSize(const void* compressedBuffer, U32 compressedSize) const noexcept;
-		std::vector<U8> Compress(const void* input, U32 inputSize) const noexcept;
+		// Data bigger than BLOCK_SIZE is compressed as chunked stream when 'chunked' is set
+		std::vector<U8> Compress(const void* input, U32 inputSize, bool chunked = true) const noexcept;
+		// Blocks of chunked stream are decompressed directly into destination by workers of thread pool
 		void Decompress(const void* src, U32 srcSize, void* dst, U32 dstSize) const noexcept;
 	};
+
+#pragma region Functions
+	constexpr U32 Compressor::GetDecodeSpeed(CompressionFormat format) noexcept
+	{
+		switch (format)
+		{
+		default:
+			ZE_ENUM_UNHANDLED();
+		case CompressionFormat::None:
+			return UINT32_MAX;
+		case CompressionFormat::ZLib:
+			return 400;
+		case CompressionFormat::Bzip2:
+			return 50;
+		case CompressionFormat::Lz4:
+		case CompressionFormat::Lz4HC:
+			return 4000;
+		case CompressionFormat::Zstd:
+		case CompressionFormat::ZstdDictionary:
+			return 1500;
+		}
+	}
+
+	constexpr U64 Compressor::GetLoadCost(CompressionFormat format, U64 compressedSize, U64 uncompressedSize) noexcept
+	{
+		// Bytes per MB/s gives microseconds, scaled to nanoseconds so small buffers are not rounded to zero
+		U64 cost = compressedSize * 1000 / ASSUMED_READ_SPEED;
+		if (format != CompressionFormat::None)
+			cost += uncompressedSize * 1000 / GetDecodeSpeed(format);
+		return cost;
+	}
+#pragma endregion
 }
\ No newline at end of file
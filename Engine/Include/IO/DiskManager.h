@@ -26,6 +26,23 @@ namespace ZE::RHI
 	}
 #	endif
 }
+#elif _ZE_PLATFORM_LINUX
+#	include "Platform/Linux/DiskManager.h"
+namespace ZE::RHI
+{
+#	if _ZE_RHI_GL
+	namespace GL
+	{
+		typedef ZE::Linux::DiskManager DiskManager;
+	}
+#	endif
+#	if _ZE_RHI_VK
+	namespace VK
+	{
+		typedef ZE::Linux::DiskManager DiskManager;
+	}
+#	endif
+}
 #else
 #	error Missing DiskManager platform specific implementation!
 #endif
@@ -26,6 +26,23 @@ namespace ZE::RHI
 	}
 #	endif
 }
+#elif _ZE_PLATFORM_LINUX
+#	include "Platform/Linux/File.h"
+namespace ZE::RHI
+{
+#	if _ZE_RHI_GL
+	namespace GL
+	{
+		typedef ZE::Linux::File File;
+	}
+#	endif
+#	if _ZE_RHI_VK
+	namespace VK
+	{
+		typedef ZE::Linux::File File;
+	}
+#	endif
+}
 #else
 #	error Missing File platform specific implementation!
 #endif
@@ -11,6 +11,11 @@ namespace ZE::IO::Format
 	* ResourcePackTextureEntry[]
 	* String names[]
 	* Data[]
+	*
+	* Since version 1.1.0 compressed entries bigger than Compressor::BLOCK_SIZE are stored as chunked streams
+	* with block table at the start of entry data, allowing for parallel decompression.
+	* Since version 1.2.0 pack can contain single Dictionary entry (placed before any other entry) with data used
+	* by entries compressed with ZstdDictionary format.
 	*/
 
 	typedef U16 ResourcePackFlags;
@@ -18,7 +23,7 @@ namespace ZE::IO::Format
 	enum ResourcePackFlag : ResourcePackFlags { None = 0 };
 
 	// Type of single entry in resource pack
-	enum class ResourcePackEntryType : U8 { Geometry, Material, Buffer, Textures };
+	enum class ResourcePackEntryType : U8 { Geometry, Material, Buffer, Textures, Dictionary };
 
 #pragma pack(push, 1)
 	// Header of resource pack file
@@ -67,6 +72,13 @@ namespace ZE::IO::Format
 				U64 CustomFlags;
 				CompressionFormat Compression;
 			} Buffer;
+			// Always stored without compression
+			struct
+			{
+				// Offset from start of file
+				U64 Offset;
+				U32 Bytes;
+			} Dictionary;
 			struct
 			{
 				// Index from start of ResourcePackTextureEntry section
@@ -0,0 +1,38 @@
+#pragma once
+#include "IO/Format/ResourcePackFile.h"
+#include "IO/FileStatus.h"
+#include "IO/MappedFile.h"
+#include <span>
+
+namespace ZE::IO::Format
+{
+	// Reader of resource pack file mapped into memory, all returned data points directly into the mapping
+	// and stays valid until the reader is closed
+	class ResourcePackReader final
+	{
+		MappedFile file;
+		const ResourcePackFileHeader* header = nullptr;
+		std::span<const ResourcePackEntry> resourceTable;
+		std::span<const ResourcePackTextureEntry> textureTable;
+		std::string_view nameTable;
+
+	public:
+		ResourcePackReader() = default;
+		ZE_CLASS_DELETE(ResourcePackReader);
+		~ResourcePackReader() = default;
+
+		constexpr const ResourcePackFileHeader& GetHeader() const noexcept { ZE_ASSERT(header, "Resource pack not opened!"); return *header; }
+		constexpr std::span<const ResourcePackEntry> GetResourceTable() const noexcept { return resourceTable; }
+		constexpr std::span<const ResourcePackTextureEntry> GetTextureTable() const noexcept { return textureTable; }
+		constexpr std::string_view GetNameTable() const noexcept { return nameTable; }
+
+		// Checks header and maps info section of the pack
+		FileStatus Open(std::string_view packFile) noexcept;
+		void Close() noexcept;
+
+		// Returns empty string when name is outside of the name section
+		std::string_view GetName(U32 index, U16 size) const noexcept;
+		// Returns empty span when requested range is outside of the file
+		std::span<const U8> GetData(U64 offset, U32 bytes) const noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#if _ZE_PLATFORM_WINDOWS
+#	include "Platform/WinAPI/MappedFile.h"
+namespace ZE::IO
+{
+	// Read only file mapped into memory for Windows
+	typedef ZE::WinAPI::MappedFile MappedFile;
+}
+#elif _ZE_PLATFORM_LINUX
+#	include "Platform/Linux/MappedFile.h"
+namespace ZE::IO
+{
+	// Read only file mapped into memory for Linux
+	typedef ZE::Linux::MappedFile MappedFile;
+}
+#else
+#	error Missing MappedFile platform specific implementation!
+#endif
\ No newline at end of file
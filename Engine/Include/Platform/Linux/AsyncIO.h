@@ -0,0 +1,85 @@
+#pragma once
+#include <linux/io_uring.h>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ZE::Linux
+{
+	// Process wide queue of asynchronous file operations. Requests gathered from all threads are submitted to io_uring in batches,
+	// when it's not available (old kernel or blocked by sandbox) they are executed with pread()/pwrite() on dedicated IO threads
+	class AsyncIO final
+	{
+		static constexpr U32 QUEUE_DEPTH = 256;
+		static constexpr U32 FALLBACK_THREAD_COUNT = 4;
+		// Completion signaling end of processing, never used by regular requests
+		static constexpr U64 SHUTDOWN_TAG = 0;
+
+		struct Request
+		{
+			int File;
+			bool IsRead;
+			void* Buffer;
+			U32 Size;
+			U64 Offset;
+			// Bytes already processed when request is continued after short transfer
+			U32 Transferred = 0;
+			std::promise<U32> Result;
+		};
+		// Submission and completion queues shared with the kernel
+		struct Ring
+		{
+			int FD = -1;
+			// Signaled by the kernel on every completion, allows waking completion thread without the ring
+			int EventFD = -1;
+			void* SqMapping = nullptr;
+			U64 SqMappingSize = 0;
+			void* CqMapping = nullptr;
+			U64 CqMappingSize = 0;
+			io_uring_sqe* Sqes = nullptr;
+			U64 SqesSize = 0;
+
+			U32* SqTail = nullptr;
+			U32 SqMask = 0;
+			U32* SqArray = nullptr;
+			U32* CqHead = nullptr;
+			U32* CqTail = nullptr;
+			U32 CqMask = 0;
+			io_uring_cqe* Cqes = nullptr;
+		};
+
+		Ring ring;
+		std::mutex queueMutex;
+		std::condition_variable queueCondition;
+		std::vector<Request*> pending;
+		// Requests submitted to the ring and not completed yet, kept below size of the queue so completions are never dropped
+		U32 inFlight = 0;
+		bool shutdown = false;
+		// Shutdown couldn't be submitted to the ring so completion thread is woken through event instead
+		bool shutdownSkipped = false;
+		std::vector<std::thread> threads;
+
+		AsyncIO() noexcept;
+
+		bool InitRing() noexcept;
+		void DestroyRing() noexcept;
+		void SubmitLoop() noexcept;
+		void CompleteLoop() noexcept;
+		void FallbackLoop() noexcept;
+
+	public:
+		ZE_CLASS_DELETE(AsyncIO);
+		~AsyncIO();
+
+		static AsyncIO& Get() noexcept { static AsyncIO io; return io; }
+		// Blocking operation repeated until all bytes are transferred, returns number of bytes actually processed
+		static U32 Transfer(int file, bool isRead, void* buffer, U32 size, U64 offset) noexcept;
+
+		constexpr bool IsUsingRing() const noexcept { return ring.FD != -1; }
+
+		// Returns waitable number of bytes processed by this operation
+		std::future<U32> Submit(int file, bool isRead, void* buffer, U32 size, U64 offset) noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include "GFX/CommandList.h"
+
+namespace ZE::Linux
+{
+	// DiskManager implementation for Linux, asynchronous file operations are handled by AsyncIO
+	class DiskManager final
+	{
+	public:
+		DiskManager() = default;
+		constexpr DiskManager(GFX::Device& dev) noexcept {}
+		ZE_CLASS_MOVE(DiskManager);
+		~DiskManager() = default;
+
+		constexpr DiskStatusHandle SetGPUUploadWaitPoint() noexcept { return nullptr; }
+		constexpr void StartUploadGPU() noexcept {}
+		constexpr bool IsGPUWorkPending(DiskStatusHandle handle) const noexcept { return false; }
+		constexpr bool WaitForUploadGPU(GFX::Device& dev, GFX::CommandList& cl, DiskStatusHandle handle) { return true; }
+	};
+}
\ No newline at end of file
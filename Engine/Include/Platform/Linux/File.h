@@ -0,0 +1,37 @@
+#pragma once
+#include "Platform/Linux/AsyncIO.h"
+#include "IO/DiskManager.h"
+#include "IO/FileFlags.h"
+
+namespace ZE::Linux
+{
+	// File implementation for Linux
+	class File final
+	{
+		int file = -1;
+
+		bool PerformSyncOperation(bool isRead, void* buffer, U32 size, U64 offset) const noexcept;
+		std::future<U32> PerformAsyncOperation(bool isRead, void* buffer, U32 size, U64 offset) const noexcept;
+
+	public:
+		File() = default;
+		File(File&& f) noexcept : file(std::exchange(f.file, -1)) {}
+		ZE_CLASS_NO_COPY(File);
+		File& operator=(File&& f) noexcept { Close(); file = std::exchange(f.file, -1); return *this; }
+		~File() { Close(); }
+
+		bool Open(IO::DiskManager& disk, std::string_view fileName, IO::FileFlags flags) noexcept { return Open(fileName, flags); }
+		void Close(IO::DiskManager& disk) noexcept { Close(); }
+
+		bool Read(void* buffer, U32 size, U64 offset) const noexcept { return PerformSyncOperation(true, buffer, size, offset); }
+		bool Write(void* buffer, U32 size, U64 offset) const noexcept { return PerformSyncOperation(false, buffer, size, offset); }
+
+		std::future<U32> ReadAsync(void* buffer, U32 size, U64 offset) const noexcept { return PerformAsyncOperation(true, buffer, size, offset); }
+		std::future<U32> WriteAsync(void* buffer, U32 size, U64 offset) const noexcept { return PerformAsyncOperation(false, buffer, size, offset); }
+
+		// IO API Internal
+
+		bool Open(std::string_view fileName, IO::FileFlags flags) noexcept;
+		void Close() noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace ZE::Linux
+{
+	// Read only view of whole file mapped into address space of the process
+	class MappedFile final
+	{
+		const U8* data = nullptr;
+		U64 size = 0;
+
+	public:
+		MappedFile() = default;
+		ZE_CLASS_DELETE(MappedFile);
+		~MappedFile() { Close(); }
+
+		constexpr bool IsOpen() const noexcept { return data != nullptr; }
+		constexpr U64 GetSize() const noexcept { return size; }
+		constexpr const U8* GetData() const noexcept { return data; }
+
+		bool Open(std::string_view fileName) noexcept;
+		void Close() noexcept;
+	};
+}
\ No newline at end of file
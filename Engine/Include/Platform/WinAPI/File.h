@@ -1,6 +1,10 @@
 #pragma once
 #include "IO/DiskManager.h"
 #include "IO/FileFlags.h"
+ZE_WARNING_PUSH
+ZE_WARNING_DISABLE_MSVC(5204) // Bug in MSVC producing warnings in <future> header
+#include <future>
+ZE_WARNING_POP
 
 namespace ZE::WinAPI
 {
@@ -1,5 +1,5 @@
 #pragma once
-#include "Allocator/ChunkedTLSF.h"
+#include "Allocator/ConcurrentTLSF.h"
 #include "ResourceInfo.h"
 
 namespace ZE::RHI::DX12
@@ -23,7 +23,7 @@ namespace ZE::RHI::DX12
 			static void Init(Memory& chunk, HeapFlags flags, U64 size, void* userData);
 			static void Destroy(Memory& chunk, void* userData) noexcept { chunk.Heap = nullptr; }
 		};
-		typedef Allocator::ChunkedTLSF<Memory, 4, 2> HeapAllocator;
+		typedef Allocator::ConcurrentTLSF<Memory, 4, 2> HeapAllocator;
 
 		static constexpr U64 TIGHT_CHUNK = D3D12_TIGHT_ALIGNMENT_MIN_PLACED_RESOURCE_ALIGNMENT; // 8 B
 		static constexpr U64 SMALL_CHUNK = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT; // 4 KB
@@ -41,6 +41,8 @@ namespace ZE::RHI::DX12
 		bool tightAlignment = false;
 		HeapAllocator::BlockAllocator blockAllocator;
 		HeapAllocator::ChunkAllocator chunkAllocator;
+		// Guards all heap allocators together with shared block and chunk pools
+		std::mutex heapMutex;
 
 		// Tier1: buffers | Tier2: buffers + textures
 		HeapAllocator mainAllocator;
@@ -73,8 +75,8 @@ namespace ZE::RHI::DX12
 		static void Remove(ResourceInfo& resInfo, HeapAllocator& allocator) noexcept;
 
 	public:
-		AllocatorGPU() : blockAllocator(BLOCK_ALLOC_CAPACITY), chunkAllocator(CHUNK_ALLOC_CAPACITY), mainAllocator(blockAllocator, chunkAllocator),
-			secondaryAllocator(blockAllocator, chunkAllocator), dynamicBuffersAllocator(blockAllocator, chunkAllocator), readbackBuffersAllocator(blockAllocator, chunkAllocator) {}
+		AllocatorGPU() : blockAllocator(BLOCK_ALLOC_CAPACITY), chunkAllocator(CHUNK_ALLOC_CAPACITY), mainAllocator(blockAllocator, chunkAllocator, heapMutex),
+			secondaryAllocator(blockAllocator, chunkAllocator, heapMutex), dynamicBuffersAllocator(blockAllocator, chunkAllocator, heapMutex), readbackBuffersAllocator(blockAllocator, chunkAllocator, heapMutex) {}
 		ZE_CLASS_MOVE(AllocatorGPU);
 		~AllocatorGPU();
 
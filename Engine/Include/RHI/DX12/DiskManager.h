@@ -28,6 +28,9 @@ namespace ZE::RHI::DX12
 		// Custom decompression formats
 		static constexpr DSTORAGE_COMPRESSION_FORMAT DS_COMPRESSION_FORMAT_ZLIB = static_cast<DSTORAGE_COMPRESSION_FORMAT>(DSTORAGE_CUSTOM_COMPRESSION_0 + 1);
 		static constexpr DSTORAGE_COMPRESSION_FORMAT DS_COMPRESSION_FORMAT_BZIP2 = static_cast<DSTORAGE_COMPRESSION_FORMAT>(DS_COMPRESSION_FORMAT_ZLIB + 1);
+		// Decompression of LZ4 and LZ4 HC streams is the same
+		static constexpr DSTORAGE_COMPRESSION_FORMAT DS_COMPRESSION_FORMAT_LZ4 = static_cast<DSTORAGE_COMPRESSION_FORMAT>(DS_COMPRESSION_FORMAT_BZIP2 + 1);
+		static constexpr DSTORAGE_COMPRESSION_FORMAT DS_COMPRESSION_FORMAT_ZSTD = static_cast<DSTORAGE_COMPRESSION_FORMAT>(DS_COMPRESSION_FORMAT_LZ4 + 1);
 
 		enum class ResourceType : U8 { Buffer, Mesh, Texture, TextureCopySrc };
 
@@ -59,6 +62,8 @@ namespace ZE::RHI::DX12
 		std::jthread cpuDecompressionThread;
 
 		static constexpr DSTORAGE_COMPRESSION_FORMAT GetCompressionFormat(IO::CompressionFormat compression) noexcept;
+		// Codec able to decompress given custom format
+		static constexpr IO::CompressionFormat GetCodecFormat(DSTORAGE_COMPRESSION_FORMAT compression) noexcept;
 		static bool IsFileOnSSD(std::wstring_view path) noexcept;
 		void DecompressAssets(Device& dev) const;
 		void AddRequest(EID resourceID, IResource* dest, ResourceType type, std::shared_ptr<const U8[]> src) noexcept;
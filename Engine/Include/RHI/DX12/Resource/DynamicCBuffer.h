@@ -2,29 +2,30 @@
 #include "GFX/Resource/DynamicBufferAlloc.h"
 #include "GFX/Binding/Context.h"
 #include "GFX/CommandList.h"
+#include "Allocator/PageRing.h"
 
 namespace ZE::RHI::DX12::Resource
 {
+	// Dynamic data is sub-allocated by every recording thread from it's own persistently mapped page
 	class DynamicCBuffer final
 	{
-		static constexpr U64 BLOCK_SHRINK_STEP = 2;
+		struct Page
+		{
+			ResourceInfo Info;
+			D3D12_GPU_VIRTUAL_ADDRESS Address = 0;
+		};
 
-		std::vector<std::pair<ResourceInfo, D3D12_GPU_VIRTUAL_ADDRESS>> resInfo;
-		Ptr<U8> buffer;
-		U32 nextOffset = 0;
-		U64 currentBlock = 0;
-#ifndef _ZE_RENDER_GRAPH_SINGLE_THREAD
-		std::mutex allocLock;
-#endif
+		Allocator::PageRing<Page, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT> pages;
 
-		void AllocBlock(GFX::Device& dev);
-		void MapBlock(GFX::Device& dev, U64 block);
+		static U8* CreatePage(GFX::Device& dev, Page& page);
+		static void FreePage(GFX::Device& dev, Page& page) noexcept;
 
 	public:
 		DynamicCBuffer() = default;
-		DynamicCBuffer(GFX::Device& dev) { AllocBlock(dev); }
+		// Pages are created on first allocation from every thread
+		DynamicCBuffer(GFX::Device& dev) noexcept {}
 		ZE_CLASS_MOVE(DynamicCBuffer);
-		~DynamicCBuffer();
+		~DynamicCBuffer() = default;
 
 		GFX::Resource::DynamicBufferAlloc Alloc(GFX::Device& dev, const void* values, U32 bytes);
 		void Bind(GFX::CommandList& cl, GFX::Binding::Context& bindCtx, const GFX::Resource::DynamicBufferAlloc& allocInfo) const noexcept;
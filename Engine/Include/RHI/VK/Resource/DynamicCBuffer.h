@@ -14,8 +14,8 @@ namespace ZE::RHI::VK::Resource
 		Ptr<U8> buffer;
 		U32 nextOffset = 0;
 		U64 currentBlock = 0;
-#ifndef _ZE_RENDER_GRAPH_SINGLE_THREAD
-		std::mutex allocLock;
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		mutable std::mutex allocLock;
 #endif
 
 		void AllocBlock(GFX::Device& dev);
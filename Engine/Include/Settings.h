@@ -24,6 +24,7 @@ namespace ZE
 			ImGui,
 			SplitRenderSubmissions,
 			IBL,
+			RenderGraphTiming,
 			Count,
 		};
 
@@ -112,6 +113,7 @@ namespace ZE
 		static constexpr bool IsEnabledImGui() noexcept { return flags[Flags::ImGui]; }
 		static constexpr bool IsEnabledSplitRenderSubmissions() noexcept { return flags[Flags::SplitRenderSubmissions]; }
 		static constexpr bool IsEnabledIBL() noexcept { return flags[Flags::IBL]; }
+		static constexpr bool IsEnabledRenderGraphTiming() noexcept { return flags[Flags::RenderGraphTiming]; }
 
 		static constexpr void SetGfxTags(bool enabled) noexcept { flags[Flags::GfxTags] = enabled; }
 		static constexpr void SetU8IndexBuffers(bool enabled) noexcept { flags[Flags::IndexBufferU8] = enabled; }
@@ -181,6 +183,7 @@ namespace ZE
 		flags[Flags::NoCulling] = params.Flags & SettingsInitFlag::DisableCulling;
 		flags[Flags::ImGui] = true;
 		flags[Flags::SplitRenderSubmissions] = params.Flags & SettingsInitFlag::SplitRenderSubmissions;
+		flags[Flags::RenderGraphTiming] = params.Flags & SettingsInitFlag::RenderGraphTiming;
 #endif
 #if _ZE_DEBUG_GFX_API
 		flags[Flags::GPUValidation] = params.Flags & SettingsInitFlag::EnableGPUValidation;
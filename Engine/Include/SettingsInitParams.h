@@ -7,7 +7,7 @@
 namespace ZE
 {
 	// Set of flags used to enable various engine features.
-	typedef U8 SettingsInitFlags;
+	typedef U16 SettingsInitFlags;
 	// Possible engine features to be enabled by the application.
 	enum class SettingsInitFlag : SettingsInitFlags
 	{
@@ -27,6 +27,8 @@ namespace ZE
 		SplitRenderSubmissions = 64,
 		// Enable Image Based Lighting as handler of ambient lighting.
 		EnableIBL = 128,
+		// Measure CPU time spent on recording every pass group of render graph and periodically log it. Only for debug and development builds.
+		RenderGraphTiming = 256,
 	};
 	ZE_ENUM_OPERATORS(SettingsInitFlag, SettingsInitFlags);
 
@@ -31,11 +31,13 @@
 *** filesystem
 *** fstream
 *** functional
-*** future
 *** intrin.h/x86intrin.h + cpuid.h
+*** iterator
 *** limits
 *** map
 *** memory
+*** mutex
+*** new
 *** random
 *** shared_mutex
 *** sstream
@@ -3,7 +3,7 @@
 #include "Data/Tags.h"
 #include "GFX/Vertex.h"
 #include "GUI/DialogWindow.h"
-#include "IO/Format/ResourcePackFile.h"
+#include "IO/Format/ResourcePackReader.h"
 #include "IO/Compressor.h"
 #include "IO/File.h"
 
@@ -58,18 +58,15 @@ namespace ZE::Data
 		return Settings::GetThreadPool().Schedule(ThreadPriority::Normal,
 			[&]() -> IO::FileStatus
 			{
+				// CPU data is taken directly from mapped file, GPU resources are still read through disk manager
+				IO::Format::ResourcePackReader pack;
+				if (const IO::FileStatus status = pack.Open(packFile); status != IO::FileStatus::Ok)
+					return status;
 				IO::File file;
 				if (!file.Open(diskManager, packFile, IO::FileFlag::GpuReading))
 					return IO::FileStatus::ErrorOpeningFile;
 
-				IO::Format::ResourcePackFileHeader header = {};
-				if (!file.Read(&header, sizeof(header), 0))
-					return IO::FileStatus::ErrorReading;
-				// Check if signature is correct first and resources are present
-				if (std::memcmp(header.Signature, IO::Format::ResourcePackFileHeader::SIGNATURE_STR, 4) != 0)
-					return IO::FileStatus::ErrorBadSignature;
-				if (header.ResourcesCount == 0)
-					return IO::FileStatus::ErrorNoResources;
+				const IO::Format::ResourcePackFileHeader& header = pack.GetHeader();
 
 				// Prepare IDs for all created entities
 				std::vector<EID> resourceIds(header.ResourcesCount);
@@ -80,52 +77,70 @@ namespace ZE::Data
 				switch (header.Version)
 				{
 				case Utils::MakeVersion(1, 0, 0):
+				case Utils::MakeVersion(1, 1, 0): // Large compressed entries can be split into blocks, handled by Compressor
+				case Utils::MakeVersion(1, 2, 0): // Optional compression dictionary entry
 				{
-					const U32 infoSectionSize = header.ResourcesCount * sizeof(IO::Format::ResourcePackEntry)
-						+ header.TexturesCount * sizeof(IO::Format::ResourcePackTextureEntry)
-						+ header.NameSectionSize;
-					std::unique_ptr<U8[]> infoSection = std::make_unique<U8[]>(infoSectionSize);
-					auto tableWait = file.ReadAsync(infoSection.get(), infoSectionSize, sizeof(header));
-
-					const IO::Format::ResourcePackEntry* resourceTable = reinterpret_cast<const IO::Format::ResourcePackEntry*>(infoSection.get() + sizeof(header));
-					const IO::Format::ResourcePackTextureEntry* textureTable = reinterpret_cast<const IO::Format::ResourcePackTextureEntry*>(resourceTable + header.ResourcesCount);
-					const char* nameTable = reinterpret_cast<const char*>(textureTable + header.TexturesCount);
-
-					// Wait for last read and check if correct numer of bytes are read
-					if (tableWait.get() != infoSectionSize)
-					{
-						result = IO::FileStatus::ErrorReading;
-						break;
-					}
+					const IO::Format::ResourcePackEntry* resourceTable = pack.GetResourceTable().data();
+					const IO::Format::ResourcePackTextureEntry* textureTable = pack.GetTextureTable().data();
 
 					// First check for integrity of resources and loading of CPU only data
 					U32 resIdIndex = 0;
 					U32 materialEntryCount = 0;
+					U32 dictionaryEntryCount = 0;
 					U32 textureSchemaMaterialPBRIndex = UINT32_MAX;
 					std::vector<DecompressionEntry> materialBuffers;
-					std::vector<std::future<U32>> materialBufferWait;
+					std::span<const U8> dictionary;
 					for (U32 i = 0; i < header.ResourcesCount; ++i)
 					{
 						const auto& entry = resourceTable[i];
 
+						// Dictionary is not a resource, it's only needed for decompressing CPU data of other entries
+						if (entry.Type == IO::Format::ResourcePackEntryType::Dictionary)
+						{
+							if (dictionaryEntryCount++ || i != 0 || entry.Dictionary.Bytes == 0)
+							{
+								result = IO::FileStatus::ErrorUnknownResourceEntry;
+								break;
+							}
+							dictionary = pack.GetData(entry.Dictionary.Offset, entry.Dictionary.Bytes);
+							if (dictionary.empty())
+							{
+								result = IO::FileStatus::ErrorReading;
+								break;
+							}
+							continue;
+						}
+
 						EID resId = resourceIds.at(resIdIndex++);
 						Settings::Data.emplace<PackID>(resId, header.ID);
 
-						std::string& name = Settings::Data.emplace<std::string>(resId);
-						name.resize(entry.NameSize);
-						std::memcpy(name.data(), nameTable + entry.NameIndex, entry.NameSize);
+						Settings::Data.emplace<std::string>(resId, pack.GetName(entry.NameIndex, entry.NameSize));
 
 						// Check for correct type of resource pack entry
 						switch (entry.Type)
 						{
 						case IO::Format::ResourcePackEntryType::Geometry:
 						{
+							// Geometry is decompressed on GPU where dictionary is not available
+							if (entry.Geometry.Compression == IO::CompressionFormat::ZstdDictionary)
+							{
+								result = IO::FileStatus::ErrorUnknownResourceEntry;
+								i = header.ResourcesCount;
+								break;
+							}
 							Settings::Data.emplace<Math::BoundingBox>(resId, entry.Geometry.BoxCenter, entry.Geometry.BoxExtents);
 							break;
 						}
 						case IO::Format::ResourcePackEntryType::Material:
 						{
 							++materialEntryCount;
+							// Dictionary entry always comes first so it's presence is already known
+							if (entry.Buffer.Compression == IO::CompressionFormat::ZstdDictionary && dictionary.empty())
+							{
+								result = IO::FileStatus::ErrorUnknownResourceEntry;
+								i = header.ResourcesCount;
+								break;
+							}
 							// Material entry is composed of 2 entries, one holding buffer info and second holding textures info
 							bool correctEntries = false;
 							if (++i < header.ResourcesCount)
@@ -138,8 +153,7 @@ namespace ZE::Data
 
 								if (textureSchemaMaterialPBRIndex == UINT32_MAX)
 								{
-									std::string schemaName(resourceTable[i].Textures.SchemaNameSize, '\0');
-									std::memcpy(schemaName.data(), nameTable + resourceTable[i].Textures.SchemaNameIndex, resourceTable[i].Textures.SchemaNameSize);
+									std::string schemaName(pack.GetName(resourceTable[i].Textures.SchemaNameIndex, resourceTable[i].Textures.SchemaNameSize));
 									if (schemaName == MaterialBuffersPBR::GetTextureSchemaName())
 										textureSchemaMaterialPBRIndex = resourceTable[i].Textures.SchemaNameIndex;
 								}
@@ -154,17 +168,18 @@ namespace ZE::Data
 									result = IO::FileStatus::ErrorIncorrectMaterialBufferSize;
 									i = header.ResourcesCount;
 								}
+								else if (const std::span<const U8> source = pack.GetData(entry.Buffer.Offset, entry.Buffer.Bytes); source.empty())
+								{
+									result = IO::FileStatus::ErrorReading;
+									i = header.ResourcesCount;
+								}
 								else
 								{
-									// Load CPU side of material data
+									// Load CPU side of material data straight from the mapping, compressed ones are decoded after issuing GPU reads
 									if (entry.Buffer.Compression == IO::CompressionFormat::None)
-										materialBufferWait.emplace_back(file.ReadAsync(&Settings::Data.emplace<MaterialPBR>(resId), sizeof(MaterialPBR), entry.Buffer.Offset));
+										std::memcpy(&Settings::Data.emplace<MaterialPBR>(resId), source.data(), sizeof(MaterialPBR));
 									else
-									{
-										U8* dest = materialBuffers.emplace_back(resId, entry.Buffer.Compression,
-											std::make_unique<U8[]>(entry.Buffer.Bytes), entry.Buffer.Bytes).CompressedBuffer.get();
-										materialBufferWait.emplace_back(file.ReadAsync(dest, entry.Buffer.Bytes, entry.Buffer.Offset));
-									}
+										materialBuffers.emplace_back(resId, entry.Buffer.Compression, source);
 									// Load CPU material flags entry from opaque flags field
 									Settings::Data.emplace<PBRFlags>(resId).Flags = Utils::SafeCast<U8>(entry.Buffer.CustomFlags);
 								}
@@ -185,8 +200,7 @@ namespace ZE::Data
 							}
 							else if (resourceTable[i].Textures.SchemaNameIndex != UINT32_MAX && resourceTable[i].Textures.SchemaNameSize)
 							{
-								std::string schemaName(resourceTable[i].Textures.SchemaNameSize, '\0');
-								std::memcpy(schemaName.data(), nameTable + resourceTable[i].Textures.SchemaNameIndex, resourceTable[i].Textures.SchemaNameSize);
+								std::string schemaName(pack.GetName(resourceTable[i].Textures.SchemaNameIndex, resourceTable[i].Textures.SchemaNameSize));
 
 								// Save known schema indexes to avoid string comparison later on
 								if (schemaName == MaterialBuffersPBR::GetTextureSchemaName())
@@ -220,7 +234,14 @@ namespace ZE::Data
 							break;
 						}
 						case IO::Format::ResourcePackEntryType::Buffer:
+						{
+							if (entry.Buffer.Compression == IO::CompressionFormat::ZstdDictionary && dictionary.empty())
+							{
+								result = IO::FileStatus::ErrorUnknownResourceEntry;
+								i = header.ResourcesCount;
+							}
 							break;
+						}
 						default:
 						{
 							result = IO::FileStatus::ErrorUnknownResourceEntry;
@@ -233,17 +254,17 @@ namespace ZE::Data
 					if (result != IO::FileStatus::Ok)
 						break;
 
-					// When loading material entities, single resource is composed of 2 entries, so remove unneeded ones
-					if (materialEntryCount)
+					// When loading material entities, single resource is composed of 2 entries, so remove unneeded ones (same for dictionary)
+					if (const U32 unusedIds = materialEntryCount + dictionaryEntryCount)
 					{
-						Settings::DestroyEntities(resourceIds.end() - materialEntryCount, resourceIds.end());
-						resourceIds.erase(resourceIds.end() - materialEntryCount, resourceIds.end());
+						Settings::DestroyEntities(resourceIds.end() - unusedIds, resourceIds.end());
+						resourceIds.erase(resourceIds.end() - unusedIds, resourceIds.end());
 					}
 
 					// Final processing of GPU resources
 					resIdIndex = 0;
 					const GFX::Resource::Texture::Schema& pbrMaterialSchema = texSchemaLib.Get(MaterialBuffersPBR::GetTextureSchemaName());
-					for (U32 i = 0; i < header.ResourcesCount; ++i)
+					for (U32 i = dictionaryEntryCount; i < header.ResourcesCount; ++i)
 					{
 						const auto& entry = resourceTable[i];
 						const auto* entryPtr = &entry;
@@ -303,8 +324,7 @@ namespace ZE::Data
 								}
 								else
 								{
-									std::string schemaName(resourceTable[i].Textures.SchemaNameSize, '\0');
-									std::memcpy(schemaName.data(), nameTable + entryPtr->Textures.SchemaNameIndex, entryPtr->Textures.SchemaNameSize);
+									std::string schemaName(pack.GetName(entryPtr->Textures.SchemaNameIndex, entryPtr->Textures.SchemaNameSize));
 									desc.Init(texSchemaLib.Get(schemaName));
 								}
 							}
@@ -345,22 +365,11 @@ namespace ZE::Data
 					}
 
 					// Finish loading of material CPU data
-					for (auto& wait : materialBufferWait)
+					for (auto& buffer : materialBuffers)
 					{
-						if (wait.get() != sizeof(MaterialPBR))
-						{
-							result = IO::FileStatus::ErrorReading;
-							break;
-						}
-					}
-					materialBufferWait.clear();
-					if (result == IO::FileStatus::Ok)
-					{
-						for (auto& buffer : materialBuffers)
-						{
-							IO::Compressor codec(buffer.Format);
-							codec.Decompress(buffer.CompressedBuffer.get(), buffer.CompressedSize, &Settings::Data.emplace<MaterialPBR>(buffer.ResID), sizeof(MaterialPBR));
-						}
+						IO::Compressor codec(buffer.Format);
+						codec.SetDictionary(dictionary.data(), Utils::SafeCast<U32>(dictionary.size()));
+						codec.Decompress(buffer.Source.data(), Utils::SafeCast<U32>(buffer.Source.size()), &Settings::Data.emplace<MaterialPBR>(buffer.ResID), sizeof(MaterialPBR));
 					}
 					break;
 				}
@@ -378,23 +387,28 @@ namespace ZE::Data
 			});
 	}
 
-	Task<IO::FileStatus> AssetsStreamer::SaveResourcePack(GFX::Device& dev, std::string_view packFile, U16 packId, IO::CompressionFormat defaultCompression)
+	Task<IO::FileStatus> AssetsStreamer::SaveResourcePack(GFX::Device& dev, std::string_view packFile, U16 packId, IO::CompressionFormat defaultCompression, bool autoCompression)
 	{
 		return Settings::GetThreadPool().Schedule(ThreadPriority::Normal,
 			[&]() -> IO::FileStatus
 			{
-				// Gather all resources for given group
+				// Gather all resources for given group. Only CPU copy of material data can be saved currently,
+				// geometry and textures cannot be read back from GPU so they are left out of the pack
 				std::vector<EID> resourceIds;
-				U32 materialCount = 0;
+				U32 skippedCount = 0;
 				for (EID entity : Settings::Data.view<PackID>())
 				{
 					if (Settings::Data.get<PackID>(entity).ID == packId)
 					{
-						resourceIds.emplace_back(entity);
 						if (Settings::Data.try_get<MaterialBuffersPBR>(entity))
-							++materialCount;
+							resourceIds.emplace_back(entity);
+						else
+							++skippedCount;
 					}
 				}
+				if (skippedCount)
+					Logger::Warning("Resource pack " + std::to_string(packId) + ": " + std::to_string(skippedCount) + " resources without CPU data are not saved.");
+				const U32 materialCount = Utils::SafeCast<U32>(resourceIds.size());
 
 				if (resourceIds.size() == 0)
 					return IO::FileStatus::ErrorNoResources;
@@ -403,61 +417,177 @@ namespace ZE::Data
 				if (!file.Open(diskManager, packFile, IO::FileFlag::WriteOnly))
 					return IO::FileStatus::ErrorOpeningFile;
 
+				// Small material buffers compress badly alone so common dictionary is trained on all of them
+				std::vector<U8> dictionary;
+				if (autoCompression || defaultCompression == IO::CompressionFormat::ZstdDictionary)
+				{
+					std::vector<U8> samples;
+					std::vector<size_t> sampleSizes;
+					for (EID entity : resourceIds)
+					{
+						if (Settings::Data.try_get<MaterialBuffersPBR>(entity))
+						{
+							const MaterialPBR& material = Settings::Data.get<MaterialPBR>(entity);
+							samples.insert(samples.end(), reinterpret_cast<const U8*>(&material), reinterpret_cast<const U8*>(&material + 1));
+							sampleSizes.emplace_back(sizeof(MaterialPBR));
+						}
+					}
+					if (sampleSizes.size() >= MIN_DICTIONARY_SAMPLES)
+						dictionary = IO::Compressor::TrainDictionary(samples, sampleSizes, MAX_DICTIONARY_SIZE);
+				}
+
 				// Save general header info
 				IO::Format::ResourcePackFileHeader header = {};
 				header.Signature[0] = IO::Format::ResourcePackFileHeader::SIGNATURE_STR[0];
 				header.Signature[1] = IO::Format::ResourcePackFileHeader::SIGNATURE_STR[1];
 				header.Signature[2] = IO::Format::ResourcePackFileHeader::SIGNATURE_STR[2];
 				header.Signature[3] = IO::Format::ResourcePackFileHeader::SIGNATURE_STR[3];
-				header.Version = Utils::MakeVersion(1, 0, 0);
-				header.ResourcesCount = Utils::SafeCast<U32>(resourceIds.size() + materialCount);
+				header.Version = Utils::MakeVersion(1, 2, 0);
+				header.ResourcesCount = Utils::SafeCast<U32>(resourceIds.size() + materialCount + (dictionary.size() ? 1 : 0));
 				header.TexturesCount = 0;
 				header.NameSectionSize = 0;
 				header.ID = packId;
 				header.Flags = IO::Format::ResourcePackFlag::None;
 
-				std::vector<std::pair<U32, std::future<U32>>> results;
-				results.emplace_back(Utils::SafeCast<U32>(sizeof(header)), file.WriteAsync(&header, sizeof(header), 0));
+				// Selects compression of single entry and compresses it's data, stored raw when compression doesn't give enough savings.
+				// Dictionary can only be used by entries decompressed on CPU
+				auto compressEntry = [&](EID entity, const void* data, U32 size, bool cpuOnly, std::vector<U8>& output) -> IO::CompressionFormat
+					{
+						// If custom compression specified then use this one
+						IO::CompressionFormat format = defaultCompression;
+						bool autoSelect = autoCompression;
+						if (auto* compression = Settings::Data.try_get<IO::CompressionFormat>(entity))
+						{
+							format = *compression;
+							autoSelect = false;
+						}
+						const bool useDictionary = cpuOnly && dictionary.size();
 
-				// Prepare resource table
+						if (autoSelect)
+						{
+							format = IO::Compressor::CompressBest(data, size, MIN_COMPRESSION_SAVING, output,
+								useDictionary ? dictionary.data() : nullptr, Utils::SafeCast<U32>(dictionary.size()));
+						}
+						else if (format != IO::CompressionFormat::None)
+						{
+							if (format == IO::CompressionFormat::ZstdDictionary && !useDictionary)
+								format = IO::CompressionFormat::Zstd;
+
+							IO::Compressor codec(format);
+							codec.SetDictionary(dictionary.data(), Utils::SafeCast<U32>(dictionary.size()));
+							output = codec.Compress(data, size);
+						}
+						if (!cpuOnly)
+							format = IO::GetGpuCompressionFormat(format);
+						if (format == IO::CompressionFormat::None)
+							output.assign(reinterpret_cast<const U8*>(data), reinterpret_cast<const U8*>(data) + size);
+
+						Logger::Info("Resource pack entry \"" + Settings::Data.get<std::string>(entity) + "\": "
+							+ IO::GetCompressionFormatString(format) + ", " + std::to_string(size) + " -> " + std::to_string(output.size())
+							+ " B (saved " + std::to_string(static_cast<S64>(size) - static_cast<S64>(output.size()))
+							+ " B), predicted load cost " + std::to_string(IO::Compressor::GetLoadCost(format, output.size(), size)) + " ns");
+						return format;
+					};
+
+				// Prepare resource table, data offsets are relative to the start of data section till it's position is known
 				auto resourceInfoTable = std::make_unique<IO::Format::ResourcePackEntry[]>(header.ResourcesCount);
-				// Offset for files that will be written into disk
+				std::vector<std::vector<U8>> entriesData;
+				std::string nameSection;
 				U64 dataOffset = 0;
-				U32 nameOffset = 0;
-				for (U32 i = 0; EID entity : resourceIds)
+				U32 i = 0;
+				if (dictionary.size())
 				{
 					auto& entry = resourceInfoTable[i++];
-					entry.NameIndex = nameOffset;
-					entry.NameSize = Utils::SafeCast<U16>(Settings::Data.get<std::string>(entity).size());
-					nameOffset += entry.NameSize;
-
-					if (auto* mesh = Settings::Data.try_get<GFX::Resource::Mesh>(entity))
+					entry.Type = IO::Format::ResourcePackEntryType::Dictionary;
+					entry.NameIndex = UINT32_MAX;
+					entry.NameSize = 0;
+					entry.Dictionary.Offset = dataOffset;
+					entry.Dictionary.Bytes = Utils::SafeCast<U32>(dictionary.size());
+					dataOffset += entry.Dictionary.Bytes;
+				}
+				U32 materialSchemaNameIndex = UINT32_MAX;
+				for (EID entity : resourceIds)
+				{
+					auto& entry = resourceInfoTable[i++];
+					const std::string& name = Settings::Data.get<std::string>(entity);
+					entry.NameIndex = Utils::SafeCast<U32>(nameSection.size());
+					entry.NameSize = Utils::SafeCast<U16>(name.size());
+					nameSection += name;
+
+					// CPU copy of material data is decompressed on load so it can use dictionary
+					std::vector<U8>& data = entriesData.emplace_back();
+					entry.Type = IO::Format::ResourcePackEntryType::Material;
+					entry.Buffer.Offset = dataOffset;
+					entry.Buffer.UncompressedSize = sizeof(MaterialPBR);
+					entry.Buffer.CustomFlags = Settings::Data.get<PBRFlags>(entity).Flags;
+					entry.Buffer.Compression = compressEntry(entity, &Settings::Data.get<MaterialPBR>(entity), sizeof(MaterialPBR), true, data);
+					entry.Buffer.Bytes = Utils::SafeCast<U32>(data.size());
+					dataOffset += entry.Buffer.Bytes;
+
+					// Material textures are described in following entry, only schema is saved without texture data
+					if (materialSchemaNameIndex == UINT32_MAX)
 					{
-						entry.Type = IO::Format::ResourcePackEntryType::Geometry;
-						entry.Geometry.Offset = dataOffset;
-						entry.Geometry.Bytes = mesh->GetSize(); // TODO NOW: Currently no compression, add simple zlib ones
-						entry.Geometry.UncompressedSize = mesh->GetSize();
-						entry.Geometry.BoxCenter = Settings::Data.get<Math::BoundingBox>(entity).Center;
-						entry.Geometry.BoxExtents = Settings::Data.get<Math::BoundingBox>(entity).Extents;
-						entry.Geometry.VertexCount = mesh->GetVertexCount();
-						entry.Geometry.IndexCount = mesh->GetIndexCount();
-						entry.Geometry.VertexSize = mesh->GetVertexSize();
-						entry.Geometry.IndexBufferFormat = mesh->GetIndexFormat();
-
-						// If custom compression specified then use this one
-						auto* compression = Settings::Data.try_get<IO::CompressionFormat>(entity);
-						entry.Geometry.Compression = compression ? *compression : defaultCompression;
+						materialSchemaNameIndex = Utils::SafeCast<U32>(nameSection.size());
+						nameSection += MaterialBuffersPBR::GetTextureSchemaName();
+					}
+					auto& texturesEntry = resourceInfoTable[i++];
+					texturesEntry.Type = IO::Format::ResourcePackEntryType::Textures;
+					texturesEntry.NameIndex = UINT32_MAX;
+					texturesEntry.NameSize = UINT16_MAX;
+					texturesEntry.Textures.TextureIndex = 0;
+					texturesEntry.Textures.TexturesCount = 0;
+					texturesEntry.Textures.SchemaNameIndex = materialSchemaNameIndex;
+					texturesEntry.Textures.SchemaNameSize = Utils::SafeCast<U16>(std::strlen(MaterialBuffersPBR::GetTextureSchemaName()));
+				}
+				header.NameSectionSize = Utils::SafeCast<U32>(nameSection.size());
 
-						if (entry.Geometry.IndexBufferFormat == PixelFormat::R8_UInt)
-						{
-							// TODO: save index buffer as R16 format due to compatibility with other RHI
-						}
-						// TODO: load data from GPU and write to file
+				// Move data offsets after the info section
+				const U32 tableSize = header.ResourcesCount * sizeof(IO::Format::ResourcePackEntry);
+				const U64 dataStart = sizeof(header) + tableSize + header.TexturesCount * sizeof(IO::Format::ResourcePackTextureEntry) + header.NameSectionSize;
+				for (U32 j = 0; j < header.ResourcesCount; ++j)
+				{
+					auto& entry = resourceInfoTable[j];
+					switch (entry.Type)
+					{
+					case IO::Format::ResourcePackEntryType::Geometry:
+						entry.Geometry.Offset += dataStart;
+						break;
+					case IO::Format::ResourcePackEntryType::Material:
+					case IO::Format::ResourcePackEntryType::Buffer:
+						entry.Buffer.Offset += dataStart;
+						break;
+					case IO::Format::ResourcePackEntryType::Dictionary:
+						entry.Dictionary.Offset += dataStart;
+						break;
+					default:
+						break;
 					}
+				}
 
-					// TODO: handle other types of resources
+				std::vector<std::pair<U32, std::future<U32>>> results;
+				results.emplace_back(Utils::SafeCast<U32>(sizeof(header)), file.WriteAsync(&header, sizeof(header), 0));
+				results.emplace_back(tableSize, file.WriteAsync(resourceInfoTable.get(), tableSize, sizeof(header)));
+				if (header.NameSectionSize)
+					results.emplace_back(header.NameSectionSize, file.WriteAsync(nameSection.data(), header.NameSectionSize, dataStart - header.NameSectionSize));
+
+				// Data is written in the same order as offsets were assigned
+				U64 writeOffset = dataStart;
+				if (dictionary.size())
+				{
+					results.emplace_back(Utils::SafeCast<U32>(dictionary.size()), file.WriteAsync(dictionary.data(), Utils::SafeCast<U32>(dictionary.size()), writeOffset));
+					writeOffset += dictionary.size();
 				}
-				return IO::FileStatus::Ok;
+				for (auto& data : entriesData)
+				{
+					results.emplace_back(Utils::SafeCast<U32>(data.size()), file.WriteAsync(data.data(), Utils::SafeCast<U32>(data.size()), writeOffset));
+					writeOffset += data.size();
+				}
+
+				IO::FileStatus result = IO::FileStatus::Ok;
+				for (auto& write : results)
+					if (write.second.get() != write.first)
+						result = IO::FileStatus::ErrorWriting;
+				return result;
 			});
 	}
 
@@ -22,20 +22,23 @@ namespace ZE::Data
 			scaling = { 1.0f, 1.0f, 1.0f, 0.0f };
 		}
 
-		// Store node transforms without influence of top-level transform
-		auto& local = Settings::Data.emplace<Transform>(currentEntity);
-		Math::XMStoreFloat4(&local.Rotation, rotation);
-		Math::XMStoreFloat3(&local.Position, translation);
-		Math::XMStoreFloat3(&local.Scale, scaling);
-
 		// Apply top-level transform and local one as final render transform
 		auto& global = Settings::Data.emplace<TransformGlobal>(currentEntity, topTransform);
 		Math::XMStoreFloat4(&global.Rotation, Math::XMQuaternionNormalize(Math::XMQuaternionMultiply(Math::XMLoadFloat4(&global.Rotation), rotation)));
 		Math::XMStoreFloat3(&global.Position, Math::XMVectorAdd(Math::XMLoadFloat3(&global.Position), translation));
 		Math::XMStoreFloat3(&global.Scale, Math::XMVectorMultiply(Math::XMLoadFloat3(&global.Scale), scaling));
 
-		if (Settings::ComputeMotionVectors())
-			Settings::Data.emplace<TransformPrevious>(currentEntity, topTransform);
+		// Store node transforms without influence of top-level transform. Root of the model is not part of any hierarchy
+		// so it's local transform have to contain whole placement set by the user, otherwise it would be lost on update
+		if (Settings::Data.all_of<ParentID>(currentEntity))
+		{
+			auto& local = Settings::Data.emplace<Transform>(currentEntity);
+			Math::XMStoreFloat4(&local.Rotation, rotation);
+			Math::XMStoreFloat3(&local.Position, translation);
+			Math::XMStoreFloat3(&local.Scale, scaling);
+		}
+		else
+			Settings::Data.emplace<Transform>(currentEntity, static_cast<const Transform&>(global));
 
 		if (!Settings::Data.all_of<Children>(currentEntity))
 			Settings::Data.emplace<Children>(currentEntity);
@@ -60,8 +63,6 @@ namespace ZE::Data
 
 				Settings::Data.emplace<Transform>(child, Transform({ 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }));
 				Settings::Data.emplace<TransformGlobal>(child, global);
-				if (Settings::ComputeMotionVectors())
-					Settings::Data.emplace<TransformPrevious>(child, global);
 
 				Settings::Data.emplace<MeshID>(child, meshes.at(node.mMeshes[i]).first);
 				Settings::Data.emplace<MaterialID>(child, meshes.at(node.mMeshes[i]).second);
@@ -137,13 +138,13 @@ namespace ZE::Data
 					scene->mRootNode->mTransformation.b3 = temp;
 					std::swap(scene->mRootNode->mTransformation.c2, scene->mRootNode->mTransformation.c3);
 				}
+				Data::Transform topTransform = transform;
 				if (flipYZ || filePath.extension().string() == ".fbx")
 				{
 					// Fix for model rotated by 90 degrees in X axis
-					Float4& rotation = Settings::Data.get<TransformGlobal>(root).Rotation;
-					Math::XMStoreFloat4(&rotation,
+					Math::XMStoreFloat4(&topTransform.Rotation,
 						Math::XMQuaternionNormalize(Math::XMQuaternionMultiply(Math::XMQuaternionRotationRollPitchYaw(Math::ToRadians(90.0f), 0.0f, 0.0f),
-							Math::XMLoadFloat4(&rotation))));
+							Math::XMLoadFloat4(&topTransform.Rotation))));
 				}
 
 				// Load geometry
@@ -178,10 +179,7 @@ namespace ZE::Data
 				materials.clear();
 
 				// Load model structure
-				ParseNode(*scene->mRootNode, root, transform, meshes);
-
-				// For root node apply top-level transform as it's set by the user
-				Settings::Data.get<Data::Transform>(root) = Settings::Data.get<Data::TransformGlobal>(root);
+				ParseNode(*scene->mRootNode, root, topTransform, meshes);
 				return true;
 			});
 	}
@@ -0,0 +1,23 @@
+#include "Data/Transform.h"
+
+namespace ZE::Data
+{
+	TransformGlobal ComputeGlobalTransform(const TransformGlobal& parent, const Transform& local) noexcept
+	{
+		TransformGlobal global;
+		Math::XMStoreFloat4(&global.Rotation,
+			Math::XMQuaternionNormalize(Math::XMQuaternionMultiply(Math::XMLoadFloat4(&parent.Rotation), Math::XMLoadFloat4(&local.Rotation))));
+		Math::XMStoreFloat3(&global.Position,
+			Math::XMVectorAdd(Math::XMLoadFloat3(&parent.Position), Math::XMLoadFloat3(&local.Position)));
+		Math::XMStoreFloat3(&global.Scale,
+			Math::XMVectorMultiply(Math::XMLoadFloat3(&parent.Scale), Math::XMLoadFloat3(&local.Scale)));
+		return global;
+	}
+
+	TransformMatrix ComputeTransformMatrix(const TransformGlobal& global) noexcept
+	{
+		TransformMatrix matrix;
+		Math::XMStoreFloat4x4(&matrix.ModelTps, Math::XMMatrixTranspose(Math::GetTransform(global.Position, global.Rotation, global.Scale)));
+		return matrix;
+	}
+}
\ No newline at end of file
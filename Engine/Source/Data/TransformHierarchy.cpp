@@ -0,0 +1,147 @@
+#include "Data/TransformHierarchy.h"
+#include <ranges>
+
+namespace ZE::Data
+{
+	void TransformHierarchy::RebuildOrder() noexcept
+	{
+		ZE_PERF_GUARD("Transform hierarchy - rebuild order");
+
+		nodes.clear();
+		roots.clear();
+		std::vector<std::pair<EID, U32>> stack;
+		for (EID entity : Settings::Data.view<Transform, TransformGlobal>())
+		{
+			// Entity is treated as root when it's parent is not part of the hierarchy
+			const ParentID* parent = Settings::Data.try_get<ParentID>(entity);
+			if (parent && Settings::Data.all_of<Transform, TransformGlobal>(parent->ID))
+				continue;
+
+			roots.emplace_back(Utils::SafeCast<U32>(nodes.size()));
+			stack.emplace_back(entity, NO_PARENT);
+			while (stack.size())
+			{
+				auto [current, parentIndex] = stack.back();
+				stack.pop_back();
+
+				const U32 index = Utils::SafeCast<U32>(nodes.size());
+				nodes.emplace_back(current, parentIndex);
+
+				// New entities start with matrices based on their current state. Previous state is created regardless of motion vectors
+				// so changing that setting don't require any updates, it's updated only for changed entities anyway
+				if (!Settings::Data.all_of<TransformMatrix>(current))
+				{
+					const TransformGlobal& global = Settings::Data.get<TransformGlobal>(current);
+					const TransformMatrix& matrix = Settings::Data.emplace<TransformMatrix>(current, ComputeTransformMatrix(global));
+					Settings::Data.emplace_or_replace<TransformMatrixPrevious>(current, matrix);
+					if (!Settings::Data.all_of<TransformPrevious>(current))
+						Settings::Data.emplace<TransformPrevious>(current, global);
+				}
+				if (const Children* children = Settings::Data.try_get<Children>(current))
+				{
+					for (EID child : children->Childs)
+						if (Settings::Data.all_of<Transform, TransformGlobal>(child))
+							stack.emplace_back(child, index);
+				}
+			}
+		}
+		roots.emplace_back(Utils::SafeCast<U32>(nodes.size()));
+
+		nodeIndices.clear();
+		for (U32 i = 0; const Node& node : nodes)
+		{
+			const U32 entityIndex = Utils::SafeCast<U32>(entt::to_entity(node.Entity));
+			if (entityIndex >= nodeIndices.size())
+				nodeIndices.resize(entityIndex + 1, NO_NODE);
+			nodeIndices.at(entityIndex) = i++;
+		}
+
+		// Whole hierarchy have to be recomputed as new entities could be placed anywhere
+		dirty.assign(nodes.size(), NODE_CHANGED);
+		rebuildOrder = false;
+	}
+
+	TransformHierarchy::TransformHierarchy() noexcept
+	{
+		Settings::Data.on_construct<Transform>().connect<&TransformHierarchy::OnHierarchyChange>(*this);
+		Settings::Data.on_destroy<Transform>().connect<&TransformHierarchy::OnHierarchyChange>(*this);
+		Settings::Data.on_construct<ParentID>().connect<&TransformHierarchy::OnHierarchyChange>(*this);
+		Settings::Data.on_update<ParentID>().connect<&TransformHierarchy::OnHierarchyChange>(*this);
+		Settings::Data.on_destroy<ParentID>().connect<&TransformHierarchy::OnHierarchyChange>(*this);
+	}
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		Settings::Data.on_construct<Transform>().disconnect(this);
+		Settings::Data.on_destroy<Transform>().disconnect(this);
+		Settings::Data.on_construct<ParentID>().disconnect(this);
+		Settings::Data.on_update<ParentID>().disconnect(this);
+		Settings::Data.on_destroy<ParentID>().disconnect(this);
+	}
+
+	void TransformHierarchy::Update() noexcept
+	{
+		ZE_PERF_GUARD("Transform hierarchy - update");
+
+		if (rebuildOrder)
+			RebuildOrder();
+		else if (Settings::Data.view<TransformDirty>().size() == 0)
+			return;
+
+		for (EID entity : Settings::Data.view<TransformDirty>())
+		{
+			const U32 entityIndex = Utils::SafeCast<U32>(entt::to_entity(entity));
+			if (entityIndex < nodeIndices.size())
+			{
+				const U32 index = nodeIndices.at(entityIndex);
+				if (index != NO_NODE && nodes.at(index).Entity == entity)
+					dirty.at(index) |= NODE_CHANGED | NODE_MARKED;
+			}
+		}
+
+		// Every root subtree is placed continuously and parent is always before children so they can be processed independently
+		Settings::GetThreadPool().ParallelFor(std::views::iota(0U, Utils::SafeCast<U32>(roots.size() - 1)), 0, [&](U32 root)
+			{
+				for (U32 i = roots.at(root), end = roots.at(root + 1); i < end; ++i)
+				{
+					const Node& node = nodes.at(i);
+					if (node.Parent != NO_PARENT && dirty.at(node.Parent))
+						dirty.at(i) |= NODE_CHANGED;
+
+					if (dirty.at(i))
+					{
+						TransformGlobal& global = Settings::Data.get<TransformGlobal>(node.Entity);
+						// Roots keep their placement unless local transform have been changed explicitly
+						if (node.Parent != NO_PARENT)
+							global = ComputeGlobalTransform(Settings::Data.get<TransformGlobal>(nodes.at(node.Parent).Entity), Settings::Data.get<Transform>(node.Entity));
+						else if (dirty.at(i) & NODE_MARKED)
+							global = static_cast<TransformGlobal>(Settings::Data.get<Transform>(node.Entity));
+						Settings::Data.get<TransformMatrix>(node.Entity) = ComputeTransformMatrix(global);
+					}
+				}
+			});
+
+		transformsChanged = true;
+		Settings::Data.clear<TransformDirty>();
+	}
+
+	void TransformHierarchy::UpdatePrevious() noexcept
+	{
+		if (!transformsChanged)
+			return;
+		ZE_PERF_GUARD("Transform hierarchy - update previous");
+
+		// Unchanged entities already have same current and previous state
+		Settings::GetThreadPool().ParallelFor(std::views::iota(0U, Utils::SafeCast<U32>(nodes.size())), 0, [&](U32 i)
+			{
+				if (dirty.at(i))
+				{
+					const EID entity = nodes.at(i).Entity;
+					static_cast<TransformGlobal&>(Settings::Data.get<TransformPrevious>(entity)) = Settings::Data.get<TransformGlobal>(entity);
+					static_cast<TransformMatrix&>(Settings::Data.get<TransformMatrixPrevious>(entity)) = Settings::Data.get<TransformMatrix>(entity);
+				}
+			});
+		dirty.assign(nodes.size(), false);
+		transformsChanged = false;
+	}
+}
\ No newline at end of file
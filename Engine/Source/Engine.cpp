@@ -152,6 +152,7 @@ namespace ZE
 		GFX::CommandList& mainList = graphics.GetMainList();
 
 		UploadSync();
+		transforms.Update();
 		renderGraph.SetCamera(camera);
 		renderGraph.UpdateFrameData(dev);
 		if (graphBuilder.ExecuteStartupPasses(dev, mainList, renderGraph))
@@ -317,6 +318,9 @@ namespace ZE
 			imgui.EndFrame();
 		graphics.WaitForFrame();
 
+		// Propagate changes in transforms before they are used in rendering
+		transforms.Update();
+
 		// Update of render graph and it's data
 		GFX::Pipeline::BuildResult result = graphBuilder.UpdatePassConfiguration(dev, mainList, assets, renderGraph);
 		if (!ZE_PIPELINE_BUILD_SUCCESS(result))
@@ -333,26 +337,10 @@ namespace ZE
 			}
 		}
 
-		// Add or remove missing transform components
-		if (Settings::ComputeMotionVectors())
-		{
-			if (!Settings::Data.all_of<Data::TransformPrevious>(renderGraph.GetCurrentCamera()))
-			{
-				for (EID id : Settings::Data.view<Data::TransformGlobal>())
-					Settings::Data.emplace_or_replace<Data::TransformPrevious>(id, Settings::Data.get<Data::TransformGlobal>(id));
-			}
-		}
-		else if (Settings::Data.all_of<Data::TransformPrevious>(renderGraph.GetCurrentCamera()))
-			Settings::Data.clear<Data::TransformPrevious>();
-
 		renderGraph.Execute(graphics);
 
-		// Move all current transforms to previous state
-		if (Settings::ComputeMotionVectors())
-		{
-			for (EID id : Settings::Data.view<Data::TransformGlobal>())
-				static_cast<Data::TransformGlobal&>(Settings::Data.get<Data::TransformPrevious>(id)) = Settings::Data.get<Data::TransformGlobal>(id);
-		}
+		// Move changed transforms to previous state
+		transforms.UpdatePrevious();
 		graphics.Present();
 
 		// Frame marker
@@ -0,0 +1,122 @@
+#include "GFX/CullingCache.h"
+
+namespace ZE::GFX
+{
+	void CullingCache::Resize(U32 size) noexcept
+	{
+		count = size;
+		sources.resize(count);
+
+		// Padding is never visible as it's masked out during culling
+		const U32 paddedSize = Math::AlignUp(count, BATCH_SIZE);
+		centerX.resize(paddedSize, 0.0f);
+		centerY.resize(paddedSize, 0.0f);
+		centerZ.resize(paddedSize, 0.0f);
+		extentX.resize(paddedSize, 0.0f);
+		extentY.resize(paddedSize, 0.0f);
+		extentZ.resize(paddedSize, 0.0f);
+	}
+
+	void CullingCache::UpdateBox(U32 index) noexcept
+	{
+		const Source& source = sources[index];
+
+		Math::BoundingBox box;
+		Settings::Data.get<Math::BoundingBox>(source.Mesh).Transform(box,
+			Math::XMMatrixTranspose(Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(source.Entity).ModelTps)));
+
+		centerX[index] = box.Center.x;
+		centerY[index] = box.Center.y;
+		centerZ[index] = box.Center.z;
+		extentX[index] = box.Extents.x;
+		extentY[index] = box.Extents.y;
+		extentZ[index] = box.Extents.z;
+	}
+
+	void CullingCache::Cull(const Math::BoundingFrustum& frustum, Allocator::FrameVector<U32>& visibleIndices) const noexcept
+	{
+#if !_ZE_MODE_RELEASE
+		if (Settings::IsEnabledNoCulling())
+		{
+			visibleIndices.resize(count);
+			for (U32 i = 0; i < count; ++i)
+				visibleIndices[i] = i;
+			return;
+		}
+#endif
+		// Space for whole batch is needed as indices are written without checking
+		visibleIndices.resize(Math::AlignUp(count, BATCH_SIZE));
+		U32 visibleCount = 0;
+
+		// Planes with normals pointing outside of the frustum, box is outside when it's whole
+		// projected radius is on the positive side of any plane (conservative test)
+		std::array<Vector, 6> planes;
+		frustum.GetPlanes(&planes.at(0), &planes.at(1), &planes.at(2), &planes.at(3), &planes.at(4), &planes.at(5));
+		std::array<Float4, 6> planeData;
+		for (U8 i = 0; i < planes.size(); ++i)
+			Math::XMStoreFloat4(&planeData.at(i), planes.at(i));
+
+#if __AVX2__
+		for (U32 i = 0; i < count; i += 8)
+		{
+			const __m256 cx = _mm256_loadu_ps(centerX.data() + i);
+			const __m256 cy = _mm256_loadu_ps(centerY.data() + i);
+			const __m256 cz = _mm256_loadu_ps(centerZ.data() + i);
+			const __m256 ex = _mm256_loadu_ps(extentX.data() + i);
+			const __m256 ey = _mm256_loadu_ps(extentY.data() + i);
+			const __m256 ez = _mm256_loadu_ps(extentZ.data() + i);
+
+			__m256 outside = _mm256_setzero_ps();
+			for (const Float4& plane : planeData)
+			{
+				const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), cx), _mm256_mul_ps(_mm256_set1_ps(plane.y), cy)),
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), cz), _mm256_set1_ps(plane.w)));
+				const __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::abs(plane.x)), ex), _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.y)), ey)),
+					_mm256_mul_ps(_mm256_set1_ps(std::abs(plane.z)), ez));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, radius, _CMP_GT_OQ));
+			}
+			U32 visibleMask = ~static_cast<U32>(_mm256_movemask_ps(outside)) & 0xFF;
+#elif __SSE2__ || _M_X64
+		for (U32 i = 0; i < count; i += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(centerX.data() + i);
+			const __m128 cy = _mm_loadu_ps(centerY.data() + i);
+			const __m128 cz = _mm_loadu_ps(centerZ.data() + i);
+			const __m128 ex = _mm_loadu_ps(extentX.data() + i);
+			const __m128 ey = _mm_loadu_ps(extentY.data() + i);
+			const __m128 ez = _mm_loadu_ps(extentZ.data() + i);
+
+			__m128 outside = _mm_setzero_ps();
+			for (const Float4& plane : planeData)
+			{
+				const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w)));
+				const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey)),
+					_mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez));
+				outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, radius));
+			}
+			U32 visibleMask = ~static_cast<U32>(_mm_movemask_ps(outside)) & 0x0F;
+#else
+		for (U32 i = 0; i < count; ++i)
+		{
+			bool outside = false;
+			for (const Float4& plane : planeData)
+			{
+				const float distance = plane.x * centerX[i] + plane.y * centerY[i] + plane.z * centerZ[i] + plane.w;
+				const float radius = std::abs(plane.x) * extentX[i] + std::abs(plane.y) * extentY[i] + std::abs(plane.z) * extentZ[i];
+				outside |= distance > radius;
+			}
+			U32 visibleMask = !outside;
+#endif
+			// Padding after last box is not taken into account
+			if (count - i < 32)
+				visibleMask &= (1U << (count - i)) - 1;
+			while (visibleMask)
+			{
+				visibleIndices[visibleCount++] = i + Intrin::BitScanLSB(visibleMask);
+				visibleMask &= visibleMask - 1;
+			}
+		}
+		visibleIndices.resize(visibleCount);
+	}
+}
\ No newline at end of file
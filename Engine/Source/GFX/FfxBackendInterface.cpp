@@ -221,6 +221,12 @@ namespace ZE::GFX::FFX
 		GetFfxInterface(&backendInterface).CurrentPass = info ? *info : PassInfo{};
 	}
 
+	std::mutex& GetDispatchLock() noexcept
+	{
+		static std::mutex dispatchLock;
+		return dispatchLock;
+	}
+
 	void DestroyInterface(FfxInterface& backendInterface) noexcept
 	{
 		if (backendInterface.scratchBuffer)
@@ -0,0 +1,65 @@
+#include "GFX/Pipeline/MemoryAliasing.h"
+
+namespace ZE::GFX::Pipeline
+{
+	U32 PlanMemoryAliasing(AliasingRegion* regions, U32 count) noexcept
+	{
+		ZE_ASSERT(regions || count == 0, "Empty regions to place in memory!");
+
+		// Indices of already placed regions kept sorted by their offsets
+		std::vector<U32> placed;
+		placed.reserve(count);
+		// Memory ranges [start:end) occupied during lifetime of current region
+		std::vector<std::pair<U32, U32>> occupied;
+		occupied.reserve(count);
+
+		U32 memoryChunks = 0;
+		for (U32 i = 0; i < count; ++i)
+		{
+			AliasingRegion& region = regions[i];
+			ZE_ASSERT(region.StartLevel < region.EndLevel, "Incorrect lifetime of aliased region!");
+			const U32 alignment = std::max(region.ChunkAlignment, 1U);
+
+			occupied.clear();
+			for (U32 index : placed)
+			{
+				const AliasingRegion& other = regions[index];
+				if (other.StartLevel < region.EndLevel && region.StartLevel < other.EndLevel)
+					occupied.emplace_back(other.ChunkOffset, other.ChunkOffset + other.Chunks);
+			}
+
+			// Walk over free gaps between occupied ranges and select the smallest one that can hold aligned region
+			U32 bestOffset = UINT32_MAX, bestGap = UINT32_MAX;
+			U32 gapStart = 0;
+			auto checkGap = [&](U32 gapEnd)
+				{
+					const U32 offset = Math::AlignUp(gapStart, alignment);
+					if (offset + region.Chunks <= gapEnd && gapEnd - gapStart < bestGap)
+					{
+						bestOffset = offset;
+						bestGap = gapEnd - gapStart;
+					}
+				};
+			for (const auto& range : occupied)
+			{
+				if (range.first > gapStart)
+					checkGap(range.first);
+				gapStart = std::max(gapStart, range.second);
+			}
+			// Space after last occupied range but still inside current memory
+			checkGap(memoryChunks);
+
+			if (bestOffset == UINT32_MAX)
+			{
+				// Nothing fits, grow memory from the end of last occupied range
+				bestOffset = Math::AlignUp(gapStart, alignment);
+				memoryChunks = bestOffset + region.Chunks;
+			}
+			region.ChunkOffset = bestOffset;
+
+			placed.insert(std::upper_bound(placed.begin(), placed.end(), bestOffset,
+				[regions](U32 offset, U32 index) { return offset < regions[index].ChunkOffset; }), i);
+		}
+		return memoryChunks;
+	}
+}
\ No newline at end of file
@@ -21,6 +21,14 @@ namespace ZE::GFX::Pipeline
 {
 	void RenderGraph::PrepareFrameResources(Device& dev, SwapChain& swapChain)
 	{
+		// Report every frame that needed more transient memory than previous ones to allow for sizing pages of the arena
+		const U64 previousPeak = execData.FrameArena.GetPeakUsage();
+		execData.FrameArena.Reset();
+		if (execData.FrameArena.GetPeakUsage() > previousPeak)
+		{
+			Logger::Info("Frame arena usage raised to: " + std::to_string(execData.FrameArena.GetPeakUsage() >> 10)
+				+ " KB, capacity: " + std::to_string(execData.FrameArena.GetCapacity() >> 10) + " KB");
+		}
 		execData.DynamicBuffer = &dynamicBuffers.Get();
 		execData.DynamicBuffer->StartFrame(dev);
 		execData.DynamicBuffer->Alloc(dev, &execData.DynamicData, sizeof(RendererDynamicData));
@@ -43,8 +51,102 @@ namespace ZE::GFX::Pipeline
 		ffxInternalBuffers.Clear();
 		execGroupCount = 0;
 		passExecGroups = nullptr;
+		recordTimings.clear();
+		timedFrames = 0;
+
+		// Summary of whole run of the config
+		if (execData.FrameArena.GetPeakUsage())
+		{
+			Logger::Info("Frame arena peak usage: " + std::to_string(execData.FrameArena.GetPeakUsage() >> 10)
+				+ " KB, capacity: " + std::to_string(execData.FrameArena.GetCapacity() >> 10) + " KB");
+		}
 	}
 
+	void RenderGraph::SaveRecordTiming(U32 groupIndex, double startTime) noexcept
+	{
+		if (groupIndex >= recordTimings.size())
+			recordTimings.resize(groupIndex + 1, 0.0);
+		recordTimings.at(groupIndex) += Perf::Get().GetNow() - startTime;
+	}
+
+	void RenderGraph::LogRecordTimings() noexcept
+	{
+		std::string log = "Render graph CPU recording times, average from " + std::to_string(timedFrames) + " frames:";
+		double total = 0.0;
+		U32 groupIndex = 0;
+		// Pass groups are visited in the same order as during execution
+		for (U32 i = 0; i < execGroupCount; ++i)
+		{
+			for (U8 queue = 0; queue < 2; ++queue)
+			{
+				const ExecutionGroup& group = passExecGroups[i].at(queue);
+				for (U32 j = 0; j < group.PassGroupCount && groupIndex < recordTimings.size(); ++j, ++groupIndex)
+				{
+					const double time = recordTimings.at(groupIndex) / Utils::SafeCast<double>(timedFrames);
+					total += time;
+					log += "\n    Level " + std::to_string(i + 1) + (queue ? " async" : " main") + ", pass group " + std::to_string(j + 1)
+						+ " (" + std::to_string(group.PassGroups[j].PassCount) + " passes): " + std::to_string(time) + " us";
+				}
+			}
+		}
+		Logger::Info(log + "\n    Total: " + std::to_string(total) + " us");
+
+		recordTimings.assign(recordTimings.size(), 0.0);
+		timedFrames = 0;
+	}
+
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+	bool RenderGraph::IsRecordedInParallel(const ExecutionGroup& group) noexcept
+	{
+		if (Settings::IsEnabledSplitRenderSubmissions())
+			return false;
+		for (U32 i = 0; i < group.PassGroupCount; ++i)
+			if (group.PassGroups[i].PassCount > 1)
+				return true;
+		return false;
+	}
+
+	void RenderGraph::RecordParallel(Device& dev, ExecutionGroup& group, std::vector<CommandList>& lists, QueueType queue, U32& timingIndex)
+	{
+		U32 listCount = 0;
+		for (U32 i = 0; i < group.PassGroupCount; ++i)
+			listCount += group.PassGroups[i].PassCount;
+		while (lists.size() < listCount)
+			lists.emplace_back(dev, queue);
+
+		U32 listOffset = 0;
+		for (U32 i = 0; i < group.PassGroupCount; ++i)
+		{
+			const double startTime = Settings::IsEnabledRenderGraphTiming() ? Perf::Get().GetNow() : 0.0;
+			auto& parallelGroup = group.PassGroups[i];
+			const bool lastGroup = i + 1 == group.PassGroupCount;
+
+			// Passes have no dependencies between each other so every one of them can be recorded by different thread
+			Settings::GetThreadPool().ProcessChunks(parallelGroup.PassCount, ThreadPriority::Critical, [&](U64 pass)
+				{
+					const U32 j = Utils::SafeCast<U32>(pass);
+					CommandList& list = lists.at(listOffset + j);
+					list.Open(dev);
+
+					// Lists are submitted in order so barriers of whole group can be recorded only in the first and last one
+					if (j == 0 && parallelGroup.StartBarriers.size())
+						execData.Buffers.Barrier(list, parallelGroup.StartBarriers.data(), Utils::SafeCast<U32>(parallelGroup.StartBarriers.size()));
+					parallelGroup.Passes[j].Exec(dev, list, execData, parallelGroup.Passes[j].Data);
+					if (lastGroup && j + 1 == parallelGroup.PassCount && group.EndBarriers.size())
+						execData.Buffers.Barrier(list, group.EndBarriers.data(), Utils::SafeCast<U32>(group.EndBarriers.size()));
+
+					list.Close(dev);
+				});
+			listOffset += parallelGroup.PassCount;
+
+			if (Settings::IsEnabledRenderGraphTiming())
+				SaveRecordTiming(timingIndex, startTime);
+			++timingIndex;
+		}
+		dev.Execute(lists.data(), listCount);
+	}
+#endif
+
 	void RenderGraph::Execute(Graphics& gfx)
 	{
 		ZE_PERF_GUARD("Execute render graph");
@@ -54,12 +156,18 @@ namespace ZE::GFX::Pipeline
 		CommandList& asyncList = asyncListChain.Get();
 		if (asyncList.IsInitialized())
 			asyncList.Reset(dev);
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		WorkerLists& workers = workerLists.Get();
+		for (CommandList& list : workers.Main)
+			list.Reset(dev);
+		for (CommandList& list : workers.Async)
+			list.Reset(dev);
+#endif
 
 		PrepareFrameResources(dev, gfx.GetSwapChain());
 
-		// TODO: Single threaded method only for now, but multiple threads possible as workers
-		//       for a) passes in single pass group and then maybe for multiple pass groups at once
-		//       but only if no synchronization issues could occur between pass states
+		const bool timingEnabled = Settings::IsEnabledRenderGraphTiming();
+		U32 timingIndex = 0;
 		for (U32 i = 0; i < execGroupCount; ++i)
 		{
 			auto& mainGroup = passExecGroups[i].at(0);
@@ -67,41 +175,52 @@ namespace ZE::GFX::Pipeline
 
 			if (mainGroup.PassGroupCount)
 			{
-				ZE_DRAW_TAG_BEGIN_MAIN(dev, "Main execution group, level " + std::to_string(i + 1), PixelVal::White);
+				ZE_DRAW_TAG_BEGIN_MAIN(dev, execData.FrameArena.Concat("Main execution group, level ", i + 1), PixelVal::White);
 				if (mainGroup.QueueWait)
 					dev.WaitMainFromCompute(mainGroup.WaitFence);
 
-				ZE_SPLIT_SUBMISSIONS_DISABLED()
-				{
-					mainList.Open(dev);
-				}
-				for (U32 j = 0; j < mainGroup.PassGroupCount; ++j)
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+				if (IsRecordedInParallel(mainGroup))
+					RecordParallel(dev, mainGroup, workers.Main, QueueType::Main, timingIndex);
+				else
+#endif
 				{
-					auto& parallelGroup = mainGroup.PassGroups[j];
-					if (parallelGroup.StartBarriers.size())
+					ZE_SPLIT_SUBMISSIONS_DISABLED()
 					{
-						ZE_SPLIT_SUBMISSIONS_BEGIN(mainList);
-						execData.Buffers.Barrier(mainList, parallelGroup.StartBarriers.data(), Utils::SafeCast<U32>(parallelGroup.StartBarriers.size()));
-						ZE_SPLIT_SUBMISSIONS_END(mainList, false);
+						mainList.Open(dev);
 					}
+					for (U32 j = 0; j < mainGroup.PassGroupCount; ++j)
+					{
+						const double startTime = timingEnabled ? Perf::Get().GetNow() : 0.0;
+						auto& parallelGroup = mainGroup.PassGroups[j];
+						if (parallelGroup.StartBarriers.size())
+						{
+							ZE_SPLIT_SUBMISSIONS_BEGIN(mainList);
+							execData.Buffers.Barrier(mainList, parallelGroup.StartBarriers.data(), Utils::SafeCast<U32>(parallelGroup.StartBarriers.size()));
+							ZE_SPLIT_SUBMISSIONS_END(mainList, false);
+						}
 
-					for (U32 k = 0; k < parallelGroup.PassCount; ++k)
+						for (U32 k = 0; k < parallelGroup.PassCount; ++k)
+						{
+							ZE_SPLIT_SUBMISSIONS_BEGIN(mainList);
+							parallelGroup.Passes[k].Exec(dev, mainList, execData, parallelGroup.Passes[k].Data);
+							ZE_SPLIT_SUBMISSIONS_END(mainList, false);
+						}
+						if (timingEnabled)
+							SaveRecordTiming(timingIndex, startTime);
+						++timingIndex;
+					}
+					if (mainGroup.EndBarriers.size())
 					{
 						ZE_SPLIT_SUBMISSIONS_BEGIN(mainList);
-						parallelGroup.Passes[k].Exec(dev, mainList, execData, parallelGroup.Passes[k].Data);
+						execData.Buffers.Barrier(mainList, mainGroup.EndBarriers.data(), Utils::SafeCast<U32>(mainGroup.EndBarriers.size()));
 						ZE_SPLIT_SUBMISSIONS_END(mainList, false);
 					}
-				}
-				if (mainGroup.EndBarriers.size())
-				{
-					ZE_SPLIT_SUBMISSIONS_BEGIN(mainList);
-					execData.Buffers.Barrier(mainList, mainGroup.EndBarriers.data(), Utils::SafeCast<U32>(mainGroup.EndBarriers.size()));
-					ZE_SPLIT_SUBMISSIONS_END(mainList, false);
-				}
-				ZE_SPLIT_SUBMISSIONS_DISABLED()
-				{
-					mainList.Close(dev);
-					dev.ExecuteMain(mainList);
+					ZE_SPLIT_SUBMISSIONS_DISABLED()
+					{
+						mainList.Close(dev);
+						dev.ExecuteMain(mainList);
+					}
 				}
 
 				if (mainGroup.SignalFence)
@@ -111,41 +230,52 @@ namespace ZE::GFX::Pipeline
 
 			if (asyncGroup.PassGroupCount)
 			{
-				ZE_DRAW_TAG_BEGIN_COMPUTE(dev, "Async execution group, level " + std::to_string(i + 1), PixelVal::White);
+				ZE_DRAW_TAG_BEGIN_COMPUTE(dev, execData.FrameArena.Concat("Async execution group, level ", i + 1), PixelVal::White);
 				if (asyncGroup.QueueWait)
 					dev.WaitComputeFromMain(asyncGroup.WaitFence);
 
-				ZE_SPLIT_SUBMISSIONS_DISABLED()
-				{
-					asyncList.Open(dev);
-				}
-				for (U32 j = 0; j < asyncGroup.PassGroupCount; ++j)
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+				if (IsRecordedInParallel(asyncGroup))
+					RecordParallel(dev, asyncGroup, workers.Async, QueueType::Compute, timingIndex);
+				else
+#endif
 				{
-					auto& parallelGroup = asyncGroup.PassGroups[j];
-					if (parallelGroup.StartBarriers.size())
+					ZE_SPLIT_SUBMISSIONS_DISABLED()
 					{
-						ZE_SPLIT_SUBMISSIONS_BEGIN(asyncList);
-						execData.Buffers.Barrier(asyncList, parallelGroup.StartBarriers.data(), Utils::SafeCast<U32>(parallelGroup.StartBarriers.size()));
-						ZE_SPLIT_SUBMISSIONS_END(asyncList, true);
+						asyncList.Open(dev);
 					}
+					for (U32 j = 0; j < asyncGroup.PassGroupCount; ++j)
+					{
+						const double startTime = timingEnabled ? Perf::Get().GetNow() : 0.0;
+						auto& parallelGroup = asyncGroup.PassGroups[j];
+						if (parallelGroup.StartBarriers.size())
+						{
+							ZE_SPLIT_SUBMISSIONS_BEGIN(asyncList);
+							execData.Buffers.Barrier(asyncList, parallelGroup.StartBarriers.data(), Utils::SafeCast<U32>(parallelGroup.StartBarriers.size()));
+							ZE_SPLIT_SUBMISSIONS_END(asyncList, true);
+						}
 
-					for (U32 k = 0; k < parallelGroup.PassCount; ++k)
+						for (U32 k = 0; k < parallelGroup.PassCount; ++k)
+						{
+							ZE_SPLIT_SUBMISSIONS_BEGIN(asyncList);
+							parallelGroup.Passes[k].Exec(dev, asyncList, execData, parallelGroup.Passes[k].Data);
+							ZE_SPLIT_SUBMISSIONS_END(asyncList, true);
+						}
+						if (timingEnabled)
+							SaveRecordTiming(timingIndex, startTime);
+						++timingIndex;
+					}
+					if (asyncGroup.EndBarriers.size())
 					{
 						ZE_SPLIT_SUBMISSIONS_BEGIN(asyncList);
-						parallelGroup.Passes[k].Exec(dev, asyncList, execData, parallelGroup.Passes[k].Data);
+						execData.Buffers.Barrier(asyncList, asyncGroup.EndBarriers.data(), Utils::SafeCast<U32>(asyncGroup.EndBarriers.size()));
 						ZE_SPLIT_SUBMISSIONS_END(asyncList, true);
 					}
-				}
-				if (asyncGroup.EndBarriers.size())
-				{
-					ZE_SPLIT_SUBMISSIONS_BEGIN(asyncList);
-					execData.Buffers.Barrier(asyncList, asyncGroup.EndBarriers.data(), Utils::SafeCast<U32>(asyncGroup.EndBarriers.size()));
-					ZE_SPLIT_SUBMISSIONS_END(asyncList, true);
-				}
-				ZE_SPLIT_SUBMISSIONS_DISABLED()
-				{
-					asyncList.Close(dev);
-					dev.ExecuteCompute(asyncList);
+					ZE_SPLIT_SUBMISSIONS_DISABLED()
+					{
+						asyncList.Close(dev);
+						dev.ExecuteCompute(asyncList);
+					}
 				}
 
 				if (asyncGroup.SignalFence)
@@ -153,6 +283,9 @@ namespace ZE::GFX::Pipeline
 				ZE_DRAW_TAG_END_COMPUTE(dev);
 			}
 		}
+
+		if (timingEnabled && ++timedFrames == RECORD_TIMING_FRAMES)
+			LogRecordTimings();
 	}
 
 	void RenderGraph::SetCamera(EID camera)
@@ -172,7 +305,7 @@ namespace ZE::GFX::Pipeline
 		execData.GraphData.PrevProjection = execData.GraphData.Projection;
 
 		auto& currentCamera = Settings::Data.get<Data::Camera>(execData.GraphData.CurrentCamera);
-		const auto& transform = Settings::Data.get<Data::Transform>(execData.GraphData.CurrentCamera); // TODO: Change into TransformGlobal later
+		const auto& transform = Settings::Data.get<Data::TransformGlobal>(execData.GraphData.CurrentCamera);
 
 		// Setup shader dynamic data
 		execData.DynamicData.CameraPos = transform.Position;
@@ -207,6 +340,17 @@ namespace ZE::GFX::Pipeline
 		finalizationFlags = 0;
 		FFX::DestroyInterface(ffxInterface);
 		asyncListChain.Exec([&dev](CommandList& x) { x.Free(dev); });
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		workerLists.Exec([&dev](WorkerLists& x)
+			{
+				for (CommandList& list : x.Main)
+					list.Free(dev);
+				for (CommandList& list : x.Async)
+					list.Free(dev);
+				x.Main.clear();
+				x.Async.clear();
+			});
+#endif
 		dynamicBuffers.Exec([&dev](Resource::DynamicCBuffer& x) { x.Free(dev); });
 		execData.Buffers.Free(dev);
 		execData.Bindings.Free(dev);
@@ -94,6 +94,7 @@ namespace ZE::GFX::Pipeline::RenderPass::CACAO
 		// Custom way of loading normals is chosen so no need to perform any unpacking from SDK (custom callbacks provided)
 		desc.normalUnpackMul = 1.0f;
 		desc.normalUnpackAdd = 0.0f;
+		const std::lock_guard<std::mutex> lock(FFX::GetDispatchLock());
 		ZE_FFX_THROW_FAILED(ffxCacaoContextDispatch(&data.Ctx, &desc), "Error performing CACAO!");
 
 		ZE_DRAW_TAG_END(dev, cl);
@@ -137,8 +137,6 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 		psoDesc.InputLayout = Vertex::GetLayout();
 		ZE_PSO_SET_NAME(psoDesc, "LambertianDepth");
 		passData->StateDepth.Init(dev, psoDesc, buildData.BindingLib.GetSchema(passData->BindingIndex));
-
-		Settings::AssureEntityPools<InsideFrustumSolid, InsideFrustumNotSolid>();
 		return passData;
 	}
 
@@ -161,14 +159,12 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 		ZE_PERF_START("Lambertian - frustum culling");
 		Math::BoundingFrustum frustum = Data::GetFrustum(Math::XMLoadFloat4x4(&renderData.GraphData.Projection), Settings::MaxRenderDistance);
 		frustum.Transform(frustum, 1.0f, Math::XMLoadFloat4(&Settings::Data.get<Data::TransformGlobal>(renderData.GraphData.CurrentCamera).Rotation), cameraPos);
-		Utils::FrustumCulling<InsideFrustumSolid, InsideFrustumNotSolid>(Data::GetRenderGroup<Data::RenderLambertian>(), frustum);
+		Utils::VisibilityBuffer solidBuffer, transparentBuffer;
+		Utils::FrustumCulling(Data::GetRenderGroup<Data::RenderLambertian>(), data.Culling, frustum, renderData.FrameArena, solidBuffer, &transparentBuffer);
 		ZE_PERF_STOP();
 
-		// Use new group visible only in current frustum and sort
-		auto solidGroup = Data::GetVisibleRenderGroup<Data::RenderLambertian, InsideFrustumSolid>();
-		auto transparentGroup = Data::GetVisibleRenderGroup<Data::RenderLambertian, InsideFrustumNotSolid>();
-		const U64 solidCount = solidGroup.size();
-		const U64 transparentCount = transparentGroup.size();
+		const U64 solidCount = solidBuffer.Count;
+		const U64 transparentCount = transparentBuffer.Count;
 
 		Binding::Context ctx{ renderData.Bindings.GetSchema(data.BindingIndex) };
 		auto& cbuffer = *renderData.DynamicBuffer;
@@ -180,7 +176,7 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 			ZE_PERF_GUARD("Lambertian - solid present");
 
 			ZE_PERF_START("Lambertian - solid view sorting");
-			Utils::ViewSortAscending(solidGroup, cameraPos);
+			Utils::ViewSortAscending(solidBuffer, cameraPos, renderData.FrameArena);
 			ZE_PERF_STOP();
 
 			// Depth pre-pass
@@ -194,23 +190,20 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 			for (U64 i = 0; i < solidCount; ++i)
 			{
 				ZE_PERF_GUARD("Lambertian Depth - single loop item");
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), PixelVal::Gray);
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), PixelVal::Gray);
 
-				EID entity = solidGroup[i];
-				const auto& transform = solidGroup.get<Data::TransformGlobal>(entity);
+				Utils::VisibleEntity& visible = solidBuffer.Entities[i];
 
-				Matrix m = Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale));
+				Matrix m = Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(visible.Entity).ModelTps);
 				Matrix mvp = viewProjection * m;
 				Resource::DynamicBufferAlloc transformAlloc;
 				if (Settings::ComputeMotionVectors())
 				{
-					const auto& transformPrev = Settings::Data.get<Data::TransformPrevious>(entity);
-
 					ModelTransformBufferMotion transformBuffer;
 					Math::XMStoreFloat4x4(&transformBuffer.ModelTps, m);
 					Math::XMStoreFloat4x4(&transformBuffer.ModelViewProjectionTps, mvp);
 					Math::XMStoreFloat4x4(&transformBuffer.PrevModelViewProjectionTps,
-						prevViewProjectionTps * Math::XMMatrixTranspose(Math::GetTransform(transformPrev.Position, transformPrev.Rotation, transformPrev.Scale)));
+						prevViewProjectionTps * Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrixPrevious>(visible.Entity).ModelTps));
 
 					transformAlloc = cbuffer.Alloc(dev, &transformBuffer, sizeof(ModelTransformBufferMotion));
 				}
@@ -223,12 +216,11 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 					transformAlloc = cbuffer.Alloc(dev, &transformBuffer, sizeof(ModelTransformBuffer));
 				}
 
-				auto& transformInfo = solidGroup.get<InsideFrustumSolid>(entity);
-				transformInfo.Transform = transformAlloc;
+				visible.Transform = transformAlloc;
 				cbuffer.Bind(cl, ctx, transformAlloc);
 				ctx.Reset();
 
-				Settings::Data.get<Resource::Mesh>(solidGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+				Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 				ZE_DRAW_TAG_END(dev, cl);
 			}
 			ZE_PERF_STOP();
@@ -237,15 +229,13 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 			ZE_DRAW_TAG_END(dev, cl);
 			ZE_PERF_STOP();
 
-			// Sort by pipeline state
+			// Sort by pipeline state and material
 			ZE_PERF_START("Lambertian - solid material sort");
-			solidGroup.sort<Data::MaterialID>([&](const auto& m1, const auto& m2) -> bool
+			Utils::DrawKeySort(solidBuffer, cameraPos, renderData.FrameArena, [](EID material) -> U8
 				{
-					const U8 state1 = Data::MaterialPBR::GetPipelineStateNumber(Settings::Data.get<Data::PBRFlags>(m1.ID));
-					const U8 state2 = Data::MaterialPBR::GetPipelineStateNumber(Settings::Data.get<Data::PBRFlags>(m2.ID));
-					return state1 < state2;
+					return Data::MaterialPBR::GetPipelineStateNumber(Settings::Data.get<Data::PBRFlags>(material));
 				});
-			currentState = Data::MaterialPBR::GetPipelineStateNumber(Settings::Data.get<Data::PBRFlags>(solidGroup.get<Data::MaterialID>(solidGroup[0]).ID));
+			currentState = Data::MaterialPBR::GetPipelineStateNumber(Settings::Data.get<Data::PBRFlags>(Settings::Data.get<Data::MaterialID>(solidBuffer.Entities[0].Entity).ID));
 			ZE_PERF_STOP();
 
 			// Solid pass
@@ -267,12 +257,12 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 			for (U64 i = 0; i < solidCount; ++i)
 			{
 				ZE_PERF_GUARD("Lambertian Solid - single loop item");
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0xAD, 0xAD, 0xC9));
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0xAD, 0xAD, 0xC9));
 
-				EID entity = solidGroup[i];
-				cbuffer.Bind(cl, ctx, solidGroup.get<InsideFrustumSolid>(entity).Transform);
+				const Utils::VisibleEntity& visible = solidBuffer.Entities[i];
+				cbuffer.Bind(cl, ctx, visible.Transform);
 
-				const Data::MaterialID material = solidGroup.get<Data::MaterialID>(entity);
+				const Data::MaterialID material = Settings::Data.get<Data::MaterialID>(visible.Entity);
 				if (currentMaterial != material.ID)
 				{
 					currentMaterial = material.ID;
@@ -290,7 +280,7 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 				}
 				ctx.Reset();
 
-				Settings::Data.get<Resource::Mesh>(solidGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+				Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 				ZE_DRAW_TAG_END(dev, cl);
 			}
 			ZE_PERF_STOP();
@@ -309,7 +299,7 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 			ZE_PERF_GUARD("Lambertian - transparent present");
 
 			ZE_PERF_START("Lambertian - transparent view sorting");
-			Utils::ViewSortDescending(transparentGroup, cameraPos);
+			Utils::ViewSortDescending(transparentBuffer, cameraPos, renderData.FrameArena);
 			ZE_PERF_STOP();
 
 			ZE_PERF_START("Lambertian Transparent");
@@ -329,22 +319,19 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 			for (U64 i = 0; i < transparentCount; ++i)
 			{
 				ZE_PERF_GUARD("Lambertian Transparent - single loop item");
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0xD6, 0xD6, 0xE4));
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0xD6, 0xD6, 0xE4));
 
-				EID entity = transparentGroup[i];
-				const auto& transform = transparentGroup.get<Data::TransformGlobal>(entity);
+				const EID entity = transparentBuffer.Entities[i].Entity;
 
-				Matrix m = Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale));
+				Matrix m = Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(entity).ModelTps);
 				Matrix mvp = viewProjection * m;
 				if (Settings::ComputeMotionVectors())
 				{
-					const auto& transformPrev = Settings::Data.get<Data::TransformPrevious>(entity);
-
 					ModelTransformBufferMotion transformBuffer;
 					Math::XMStoreFloat4x4(&transformBuffer.ModelTps, m);
 					Math::XMStoreFloat4x4(&transformBuffer.ModelViewProjectionTps, mvp);
 					Math::XMStoreFloat4x4(&transformBuffer.PrevModelViewProjectionTps,
-						prevViewProjectionTps * Math::XMMatrixTranspose(Math::GetTransform(transformPrev.Position, transformPrev.Rotation, transformPrev.Scale)));
+						prevViewProjectionTps * Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrixPrevious>(entity).ModelTps));
 
 					cbuffer.AllocBind(dev, cl, ctx, &transformBuffer, sizeof(ModelTransformBufferMotion));
 				}
@@ -357,7 +344,7 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 					cbuffer.AllocBind(dev, cl, ctx, &transformBuffer, sizeof(ModelTransformBuffer));
 				}
 
-				const Data::MaterialID material = transparentGroup.get<Data::MaterialID>(entity);
+				const Data::MaterialID material = Settings::Data.get<Data::MaterialID>(entity);
 				if (currentMaterial != material.ID)
 				{
 					currentMaterial = material.ID;
@@ -375,7 +362,7 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 				}
 				ctx.Reset();
 
-				Settings::Data.get<Resource::Mesh>(transparentGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+				Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(entity).ID).Draw(dev, cl);
 				ZE_DRAW_TAG_END(dev, cl);
 			}
 			ZE_PERF_STOP();
@@ -384,11 +371,6 @@ namespace ZE::GFX::Pipeline::RenderPass::Lambertian
 			ZE_DRAW_TAG_END(dev, cl);
 			ZE_PERF_STOP();
 		}
-
-		ZE_PERF_START("Lambertian - visibility clear");
-		// Remove current visibility
-		Settings::Data.clear<InsideFrustumSolid, InsideFrustumNotSolid>();
-		ZE_PERF_STOP();
 		return solidCount != 0 || transparentCount != 0;
 	}
 }
\ No newline at end of file
@@ -57,8 +57,6 @@ namespace ZE::GFX::Pipeline::RenderPass::OutlineDraw
 		psoDesc.FormatDS = PixelFormat::Unknown;
 		ZE_PSO_SET_NAME(psoDesc, "OutlineDrawRender");
 		passData->StateRender.Init(dev, psoDesc, buildData.BindingLib.GetSchema(passData->BindingIndex));
-
-		Settings::AssureEntityPools<InsideFrustum>();
 		return passData;
 	}
 
@@ -81,13 +79,13 @@ namespace ZE::GFX::Pipeline::RenderPass::OutlineDraw
 			ZE_PERF_START("Outline Draw - frustum culling");
 			Math::BoundingFrustum frustum = Data::GetFrustum(Math::XMLoadFloat4x4(&renderData.GraphData.Projection), Settings::MaxRenderDistance);
 			frustum.Transform(frustum, 1.0f, Math::XMLoadFloat4(&Settings::Data.get<Data::TransformGlobal>(renderData.GraphData.CurrentCamera).Rotation), cameraPos);
-			Utils::FrustumCulling<InsideFrustum, InsideFrustum>(group, frustum);
+			Utils::VisibilityBuffer visibleBuffer;
+			Utils::FrustumCulling(group, data.Culling, frustum, renderData.FrameArena, visibleBuffer);
 			ZE_PERF_STOP();
 
 			ZE_PERF_START("Outline Draw - view sort");
-			auto visibleGroup = Data::GetVisibleRenderGroup<Data::RenderOutline, InsideFrustum>();
-			count = visibleGroup.size();
-			Utils::ViewSortAscending(visibleGroup, cameraPos);
+			count = visibleBuffer.Count;
+			Utils::ViewSortAscending(visibleBuffer, cameraPos, renderData.FrameArena);
 			ZE_PERF_STOP();
 
 			Binding::Context ctx{ renderData.Bindings.GetSchema(data.BindingIndex) };
@@ -104,21 +102,19 @@ namespace ZE::GFX::Pipeline::RenderPass::OutlineDraw
 			for (U64 i = 0; i < count; ++i)
 			{
 				ZE_PERF_GUARD("Outline Draw Stencil - single loop item");
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0xC9, 0xBB, 0x8E));
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0xC9, 0xBB, 0x8E));
 
-				EID entity = visibleGroup[i];
-				const auto& transform = visibleGroup.get<Data::TransformGlobal>(entity);
+				Utils::VisibleEntity& visible = visibleBuffer.Entities[i];
 
 				TransformBuffer transformBuffer = {};
 				Math::XMStoreFloat4x4(&transformBuffer.TransformTps, viewProjection *
-					Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale)));
+					Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(visible.Entity).ModelTps));
 
-				auto& transformInfo = visibleGroup.get<InsideFrustum>(entity);
-				transformInfo.Transform = cbuffer.Alloc(dev, &transformBuffer, sizeof(TransformBuffer));
-				cbuffer.Bind(cl, ctx, transformInfo.Transform);
+				visible.Transform = cbuffer.Alloc(dev, &transformBuffer, sizeof(TransformBuffer));
+				cbuffer.Bind(cl, ctx, visible.Transform);
 				ctx.Reset();
 
-				Settings::Data.get<Resource::Mesh>(visibleGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+				Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 				ZE_DRAW_TAG_END(dev, cl);
 			}
 			renderData.Buffers.EndRaster(cl);
@@ -140,23 +136,18 @@ namespace ZE::GFX::Pipeline::RenderPass::OutlineDraw
 			for (U64 i = 0; i < count; ++i)
 			{
 				ZE_PERF_GUARD("Outline Draw - single loop item");
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0xB9, 0xAB, 0x6E));
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0xB9, 0xAB, 0x6E));
 
-				EID entity = visibleGroup[i];
-				cbuffer.Bind(cl, ctx, visibleGroup.get<InsideFrustum>(entity).Transform);
+				const Utils::VisibleEntity& visible = visibleBuffer.Entities[i];
+				cbuffer.Bind(cl, ctx, visible.Transform);
 				ctx.Reset();
 
-				Settings::Data.get<Resource::Mesh>(visibleGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+				Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 				ZE_DRAW_TAG_END(dev, cl);
 			}
 			renderData.Buffers.EndRaster(cl);
 			ZE_PERF_STOP();
 			ZE_DRAW_TAG_END(dev, cl);
-
-			// Remove current visibility
-			ZE_PERF_START("Outline Draw - visibility clear");
-			Settings::Data.clear<InsideFrustum>();
-			ZE_PERF_STOP();
 			return true;
 		}
 		return false;
@@ -121,7 +121,7 @@ namespace ZE::GFX::Pipeline::RenderPass::PointLight
 					Math::XMMatrixTranspose(Math::XMMatrixScaling(light.Volume, light.Volume, light.Volume) *
 						Math::XMMatrixTranslationFromVector(Math::XMLoadFloat3(&transform.Position))));
 
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Point Light nr_" + std::to_string(i)).c_str(), Pixel(0xFD, 0xFB, 0xD3));
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Point Light nr_", i), Pixel(0xFD, 0xFB, 0xD3));
 				renderData.Buffers.BeginRaster(cl, ids.Lighting);
 				renderData.Buffers.Barrier(cl, BarrierTransition{ ids.ShadowMap, TextureLayout::RenderTarget, TextureLayout::ShaderResource,
 					Base(ResourceAccess::RenderTarget), Base(ResourceAccess::ShaderResource), Base(StageSync::RenderTarget), Base(StageSync::PixelShading) });
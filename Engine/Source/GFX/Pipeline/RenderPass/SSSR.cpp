@@ -117,6 +117,7 @@ namespace ZE::GFX::Pipeline::RenderPass::SSSR
 		desc.mostDetailedMip = data.MostDetailedMip;
 		desc.samplesPerQuad = data.SamplesPerQuad;
 		desc.temporalVarianceGuidedTracingEnabled = data.TemporalVarianceGuidedTracingEnabled;
+		const std::lock_guard<std::mutex> lock(FFX::GetDispatchLock());
 		ZE_FFX_THROW_FAILED(ffxSssrContextDispatch(&data.Ctx, &desc), "Error performing SSSR!");
 
 		ZE_DRAW_TAG_END(dev, cl);
@@ -70,7 +70,6 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 		}
 
 		Math::XMStoreFloat4x4(&passData.Projection, projection);
-		Settings::AssureEntityPools<InsideFrustumSolid, InsideFrustumNotSolid>();
 	}
 
 	Matrix Execute(Device& dev, CommandList& cl, RendererPassExecuteData& renderData,
@@ -95,14 +94,12 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 
 			// Compute visibility of objects inside camera view
 			ZE_PERF_START("Shadow Map - frustum culling");
-			Utils::FrustumCulling<InsideFrustumSolid, InsideFrustumNotSolid>(group, frustum);
+			Utils::VisibilityBuffer solidBuffer, transparentBuffer;
+			Utils::FrustumCulling(group, data.Culling, frustum, renderData.FrameArena, solidBuffer, &transparentBuffer);
 			ZE_PERF_STOP();
 
-			// Use new group visible only in current frustum and sort
-			auto solidGroup = Data::GetVisibleRenderGroup<Data::ShadowCaster, InsideFrustumSolid>();
-			auto transparentGroup = Data::GetVisibleRenderGroup<Data::ShadowCaster, InsideFrustumNotSolid>();
-			const U64 solidCount = solidGroup.size();
-			const U64 transparentCount = transparentGroup.size();
+			const U64 solidCount = solidBuffer.Count;
+			const U64 transparentCount = transparentBuffer.Count;
 
 			Binding::Context ctx{ renderData.Bindings.GetSchema(data.BindingIndex) };
 			auto& cbuffer = *renderData.DynamicBuffer;
@@ -115,7 +112,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 				ZE_PERF_GUARD("Shadow Map - solid present");
 
 				ZE_PERF_START("Shadow Map - solid view sort");
-				Utils::ViewSortAscending(solidGroup, position);
+				Utils::ViewSortAscending(solidBuffer, position, renderData.FrameArena);
 				ZE_PERF_STOP();
 
 				// Depth pre-pass
@@ -132,37 +129,33 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 				for (U64 i = 0; i < solidCount; ++i)
 				{
 					ZE_PERF_GUARD("Shadow Map Depth - single loop item");
-					ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), PixelVal::Gray);
+					ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), PixelVal::Gray);
 
-					EID entity = solidGroup[i];
-					const auto& transform = solidGroup.get<Data::TransformGlobal>(entity);
+					Utils::VisibleEntity& visible = solidBuffer.Entities[i];
 
 					ModelTransformBuffer transformBuffer;
-					const Matrix modelTransform = Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale));
+					const Matrix modelTransform = Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(visible.Entity).ModelTps);
 					Math::XMStoreFloat4x4(&transformBuffer.ModelTps, modelTransform);
 					Math::XMStoreFloat4x4(&transformBuffer.ModelViewProjectionTps, viewProjection * modelTransform);
 
-					auto& transformInfo = solidGroup.get<InsideFrustumSolid>(entity);
-					transformInfo.Transform = cbuffer.Alloc(dev, &transformBuffer, sizeof(ModelTransformBuffer));
-					cbuffer.Bind(cl, ctx, transformInfo.Transform);
+					visible.Transform = cbuffer.Alloc(dev, &transformBuffer, sizeof(ModelTransformBuffer));
+					cbuffer.Bind(cl, ctx, visible.Transform);
 					ctx.Reset();
 
-					Settings::Data.get<Resource::Mesh>(solidGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+					Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 					ZE_DRAW_TAG_END(dev, cl);
 				}
 				renderData.Buffers.EndRaster(cl);
 				ZE_PERF_STOP();
 				ZE_DRAW_TAG_END(dev, cl);
 
-				// Sort by pipeline state
+				// Sort by pipeline state and material
 				ZE_PERF_START("Shadow Map - solid material sort");
-				solidGroup.sort<Data::MaterialID>([&](const auto& m1, const auto& m2) -> bool
+				Utils::DrawKeySort(solidBuffer, position, renderData.FrameArena, [](EID material) -> U8
 					{
-						const U8 state1 = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(m1.ID) & SHADOW_PERMUTATIONS) });
-						const U8 state2 = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(m2.ID) & SHADOW_PERMUTATIONS) });
-						return state1 < state2;
+						return Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(material) & SHADOW_PERMUTATIONS) });
 					});
-				currentState = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(solidGroup.get<Data::MaterialID>(solidGroup[0]).ID) & SHADOW_PERMUTATIONS) });
+				currentState = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(Settings::Data.get<Data::MaterialID>(solidBuffer.Entities[0].Entity).ID) & SHADOW_PERMUTATIONS) });
 				ZE_PERF_STOP();
 
 				// Solid pass
@@ -181,12 +174,12 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 				for (U64 i = 0; i < solidCount; ++i)
 				{
 					ZE_PERF_GUARD("Shadow Map Solid - single loop item");
-					ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0x5D, 0x5E, 0x61));
+					ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0x5D, 0x5E, 0x61));
 
-					EID entity = solidGroup[i];
-					cbuffer.Bind(cl, ctx, solidGroup.get<InsideFrustumSolid>(entity).Transform);
+					const Utils::VisibleEntity& visible = solidBuffer.Entities[i];
+					cbuffer.Bind(cl, ctx, visible.Transform);
 
-					const Data::MaterialID material = solidGroup.get<Data::MaterialID>(entity);
+					const Data::MaterialID material = Settings::Data.get<Data::MaterialID>(visible.Entity);
 					if (currentMaterial != material.ID)
 					{
 						currentMaterial = material.ID;
@@ -205,7 +198,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 					}
 					ctx.Reset();
 
-					Settings::Data.get<Resource::Mesh>(solidGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+					Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 					ZE_DRAW_TAG_END(dev, cl);
 				}
 				ZE_PERF_STOP();
@@ -224,7 +217,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 				ZE_PERF_GUARD("Shadow Map - transparent present");
 
 				ZE_PERF_START("Shadow Map - transparent view sort");
-				Utils::ViewSortDescending(transparentGroup, position);
+				Utils::ViewSortDescending(transparentBuffer, position, renderData.FrameArena);
 				ZE_PERF_STOP();
 
 				ZE_DRAW_TAG_BEGIN(dev, cl, "Shadow Map Transparent", Pixel(0x79, 0x82, 0x8D));
@@ -240,18 +233,17 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 				for (U64 i = 0; i < transparentCount; ++i)
 				{
 					ZE_PERF_GUARD("Shadow Map Transparent - single loop item");
-					ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0x5D, 0x5E, 0x61));
+					ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0x5D, 0x5E, 0x61));
 
-					EID entity = transparentGroup[i];
-					const auto& transform = transparentGroup.get<Data::TransformGlobal>(entity);
+					const EID entity = transparentBuffer.Entities[i].Entity;
 
 					ModelTransformBuffer transformBuffer;
-					const Matrix modelTransform = Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale));
+					const Matrix modelTransform = Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(entity).ModelTps);
 					Math::XMStoreFloat4x4(&transformBuffer.ModelTps, modelTransform);
 					Math::XMStoreFloat4x4(&transformBuffer.ModelViewProjectionTps, viewProjection * modelTransform);
 					cbuffer.AllocBind(dev, cl, ctx, &transformBuffer, sizeof(ModelTransformBuffer));
 
-					const Data::MaterialID material = transparentGroup.get<Data::MaterialID>(entity);
+					const Data::MaterialID material = Settings::Data.get<Data::MaterialID>(entity);
 					if (currentMaterial != material.ID)
 					{
 						currentMaterial = material.ID;
@@ -270,17 +262,13 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMap
 					}
 					ctx.Reset();
 
-					Settings::Data.get<Resource::Mesh>(transparentGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+					Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(entity).ID).Draw(dev, cl);
 					ZE_DRAW_TAG_END(dev, cl);
 				}
 				renderData.Buffers.EndRaster(cl);
 				ZE_PERF_STOP();
 				ZE_DRAW_TAG_END(dev, cl);
 			}
-			// Remove current visibility indication
-			ZE_PERF_START("Shadow Map - visibility clear");
-			Settings::Data.clear<InsideFrustumSolid, InsideFrustumNotSolid>();
-			ZE_PERF_STOP();
 		}
 		return viewProjection;
 	}
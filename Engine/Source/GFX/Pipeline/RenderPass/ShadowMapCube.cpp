@@ -64,7 +64,6 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 		}
 
 		Math::XMStoreFloat4x4(&passData.Projection, Data::GetProjectionMatrix({ static_cast<float>(M_PI_2), 1.0f, 0.0001f }));
-		Settings::AssureEntityPools<Solid, Transparent>();
 	}
 
 	bool Execute(Device& dev, CommandList& cl, RendererPassExecuteData& renderData,
@@ -108,31 +107,41 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 			auto& cbuffer = *renderData.DynamicBuffer;
 			auto cubeBufferInfo = cbuffer.Alloc(dev, &viewBuffer, sizeof(CubeViewBuffer));
 
-			// Split into groups based on materials and if inside light volume
+			// Split into buffers based on materials and if inside light volume
 			ZE_PERF_START("Shadow Map Cube - visibility group split loop");
 			const Math::BoundingSphere lightSphere(lightPos, lightVolume);
-			for (EID entity : group)
-			{
-				ZE_PERF_GUARD("Shadow Map Cube - visibility group split single loop item");
-				const auto& transform = group.get<Data::TransformGlobal>(entity);
-
-				Math::BoundingBox box = Settings::Data.get<Math::BoundingBox>(group.get<Data::MeshID>(entity).ID);
-				box.Transform(box, Math::GetTransform(transform.Position, transform.Rotation, transform.Scale));
-
-				if (box.Intersects(lightSphere))
+			const U32 groupSize = ZE::Utils::SafeCast<U32>(group.size());
+			Utils::VisibilityBuffer solidBuffer, transparentBuffer;
+			solidBuffer.Entities = renderData.FrameArena.Alloc<Utils::VisibleEntity>(groupSize);
+			transparentBuffer.Entities = renderData.FrameArena.Alloc<Utils::VisibleEntity>(groupSize);
+
+			// Visibility tests are done on workers, then entities are placed in buffers keeping order of the group
+			enum class Split : U8 { Hidden, Solid, Transparent };
+			Split* split = renderData.FrameArena.Alloc<Split>(groupSize);
+			Settings::GetThreadPool().ParallelFor(std::views::iota(0U, groupSize), 0, [&](U32 i)
 				{
-					if (Settings::Data.all_of<Data::MaterialTransparent>(group.get<Data::MaterialID>(entity).ID))
-						Settings::Data.emplace<Transparent>(entity);
+					const EID entity = group[i];
+					Math::BoundingBox box = Settings::Data.get<Math::BoundingBox>(group.get<Data::MeshID>(entity).ID);
+					box.Transform(box, Math::XMMatrixTranspose(Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(entity).ModelTps)));
+
+					if (!box.Intersects(lightSphere))
+						split[i] = Split::Hidden;
+					else if (Settings::Data.all_of<Data::MaterialTransparent>(group.get<Data::MaterialID>(entity).ID))
+						split[i] = Split::Transparent;
 					else
-						Settings::Data.emplace<Solid>(entity);
-				}
+						split[i] = Split::Solid;
+				});
+			for (U32 i = 0; i < groupSize; ++i)
+			{
+				if (split[i] == Split::Solid)
+					solidBuffer.Entities[solidBuffer.Count++].Entity = group[i];
+				else if (split[i] == Split::Transparent)
+					transparentBuffer.Entities[transparentBuffer.Count++].Entity = group[i];
 			}
 			ZE_PERF_STOP();
 
-			auto solidGroup = Data::GetVisibleRenderGroup<Data::ShadowCaster, Solid>();
-			auto transparentGroup = Data::GetVisibleRenderGroup<Data::ShadowCaster, Transparent>();
-			const U64 solidCount = solidGroup.size();
-			const U64 transparentCount = transparentGroup.size();
+			const U64 solidCount = solidBuffer.Count;
+			const U64 transparentCount = transparentBuffer.Count;
 
 			EID currentMaterial = INVALID_EID;
 			U8 currentState = UINT8_MAX;
@@ -142,7 +151,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 				ZE_PERF_GUARD("Shadow Map Cube - solid present");
 
 				ZE_PERF_START("Shadow Map Cube - solid view sort");
-				Utils::ViewSortAscending(solidGroup, position);
+				Utils::ViewSortAscending(solidBuffer, position, renderData.FrameArena);
 				ZE_PERF_STOP();
 
 				// Depth pre-pass
@@ -161,20 +170,18 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 				for (U64 i = 0; i < solidCount; ++i)
 				{
 					ZE_PERF_GUARD("Shadow Map Cube Depth - single loop item");
-					ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), PixelVal::Gray);
+					ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), PixelVal::Gray);
 
-					EID entity = solidGroup[i];
-					const auto& transform = solidGroup.get<Data::TransformGlobal>(entity);
+					Utils::VisibleEntity& visible = solidBuffer.Entities[i];
 
 					TransformBuffer transformBuffer;
-					Math::XMStoreFloat4x4(&transformBuffer.TransformTps, Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale)));
+					Math::XMStoreFloat4x4(&transformBuffer.TransformTps, Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(visible.Entity).ModelTps));
 
-					auto& transformInfo = solidGroup.get<Solid>(entity);
-					transformInfo.Transform = cbuffer.Alloc(dev, &transformBuffer, sizeof(TransformBuffer));
-					cbuffer.Bind(cl, ctx, transformInfo.Transform);
+					visible.Transform = cbuffer.Alloc(dev, &transformBuffer, sizeof(TransformBuffer));
+					cbuffer.Bind(cl, ctx, visible.Transform);
 					ctx.Reset();
 
-					Settings::Data.get<Resource::Mesh>(solidGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+					Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 					ZE_DRAW_TAG_END(dev, cl);
 				}
 				ZE_PERF_STOP();
@@ -183,15 +190,13 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 				ZE_DRAW_TAG_END(dev, cl);
 				ZE_PERF_STOP();
 
-				// Sort by pipeline state
+				// Sort by pipeline state and material
 				ZE_PERF_START("Shadow Map Cube - solid material sort");
-				solidGroup.sort<Data::MaterialID>([&](const auto& m1, const auto& m2) -> bool
+				Utils::DrawKeySort(solidBuffer, position, renderData.FrameArena, [](EID material) -> U8
 					{
-						const U8 state1 = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(m1.ID) & SHADOW_PERMUTATIONS) });
-						const U8 state2 = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(m2.ID) & SHADOW_PERMUTATIONS) });
-						return state1 < state2;
+						return Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(material) & SHADOW_PERMUTATIONS) });
 					});
-				currentState = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(solidGroup.get<Data::MaterialID>(solidGroup[0]).ID) & SHADOW_PERMUTATIONS) });
+				currentState = Data::MaterialPBR::GetPipelineStateNumber({ static_cast<U8>(Settings::Data.get<Data::PBRFlags>(Settings::Data.get<Data::MaterialID>(solidBuffer.Entities[0].Entity).ID) & SHADOW_PERMUTATIONS) });
 				ZE_PERF_STOP();
 
 				// Solid pass
@@ -211,12 +216,12 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 				for (U64 i = 0; i < solidCount; ++i)
 				{
 					ZE_PERF_GUARD("Shadow Map Cube Solid - single loop item");
-					ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0x01, 0x60, 0x64));
+					ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0x01, 0x60, 0x64));
 
-					EID entity = solidGroup[i];
-					cbuffer.Bind(cl, ctx, solidGroup.get<Solid>(entity).Transform);
+					const Utils::VisibleEntity& visible = solidBuffer.Entities[i];
+					cbuffer.Bind(cl, ctx, visible.Transform);
 
-					const Data::MaterialID material = solidGroup.get<Data::MaterialID>(entity);
+					const Data::MaterialID material = Settings::Data.get<Data::MaterialID>(visible.Entity);
 					if (currentMaterial != material.ID)
 					{
 						currentMaterial = material.ID;
@@ -235,7 +240,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 					}
 					ctx.Reset();
 
-					Settings::Data.get<Resource::Mesh>(solidGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+					Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(visible.Entity).ID).Draw(dev, cl);
 					ZE_DRAW_TAG_END(dev, cl);
 				}
 				ZE_PERF_STOP();
@@ -254,7 +259,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 				ZE_PERF_GUARD("Shadow Map Cube - transparent present");
 
 				ZE_PERF_START("Shadow Map Cube - transparent view sort");
-				Utils::ViewSortDescending(transparentGroup, position);
+				Utils::ViewSortDescending(transparentBuffer, position, renderData.FrameArena);
 				ZE_PERF_STOP();
 
 				ZE_PERF_START("Shadow Map Cube Transparent");
@@ -272,16 +277,15 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 				for (U64 i = 0; i < transparentCount; ++i)
 				{
 					ZE_PERF_GUARD("Shadow Map Cube Transparent - single loop item");
-					ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0x01, 0x60, 0x64));
+					ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0x01, 0x60, 0x64));
 
-					EID entity = transparentGroup[i];
-					const auto& transform = transparentGroup.get<Data::TransformGlobal>(entity);
+					const EID entity = transparentBuffer.Entities[i].Entity;
 
 					TransformBuffer transformBuffer;
-					Math::XMStoreFloat4x4(&transformBuffer.TransformTps, Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale)));
+					Math::XMStoreFloat4x4(&transformBuffer.TransformTps, Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(entity).ModelTps));
 					cbuffer.AllocBind(dev, cl, ctx, &transformBuffer, sizeof(TransformBuffer));
 
-					const Data::MaterialID material = transparentGroup.get<Data::MaterialID>(entity);
+					const Data::MaterialID material = Settings::Data.get<Data::MaterialID>(entity);
 					if (currentMaterial != material.ID)
 					{
 						currentMaterial = material.ID;
@@ -300,7 +304,7 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 					}
 					ctx.Reset();
 
-					Settings::Data.get<Resource::Mesh>(transparentGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+					Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(entity).ID).Draw(dev, cl);
 					ZE_DRAW_TAG_END(dev, cl);
 				}
 				ZE_PERF_STOP();
@@ -309,10 +313,6 @@ namespace ZE::GFX::Pipeline::RenderPass::ShadowMapCube
 				ZE_DRAW_TAG_END(dev, cl);
 				ZE_PERF_STOP();
 			}
-			// Remove current material indication
-			ZE_PERF_START("Shadow Map Cube - visibility clear");
-			Settings::Data.clear<Solid, Transparent>();
-			ZE_PERF_STOP();
 			return true;
 		}
 		return false;
@@ -125,7 +125,7 @@ namespace ZE::GFX::Pipeline::RenderPass::SpotLight
 				ZE_PERF_STOP();
 
 				ZE_PERF_START("Spot Light - after shadow map");
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Spot Light nr_" + std::to_string(i)).c_str(), Pixel(0xFB, 0xE1, 0x06));
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Spot Light nr_", i), Pixel(0xFB, 0xE1, 0x06));
 				renderData.Buffers.BeginRaster(cl, ids.Lighting);
 				renderData.Buffers.Barrier(cl, BarrierTransition{ ids.ShadowMap, TextureLayout::RenderTarget, TextureLayout::ShaderResource,
 					Base(ResourceAccess::RenderTarget), Base(ResourceAccess::ShaderResource), Base(StageSync::RenderTarget), Base(StageSync::PixelShading) });
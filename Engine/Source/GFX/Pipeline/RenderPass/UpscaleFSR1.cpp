@@ -90,6 +90,7 @@ namespace ZE::GFX::Pipeline::RenderPass::UpscaleFSR1
 		desc.renderSize = { inputSize.X, inputSize.Y };
 		desc.enableSharpening = data.SharpeningEnabled;
 		desc.sharpness = data.Sharpness;
+		const std::lock_guard<std::mutex> lock(FFX::GetDispatchLock());
 		ZE_FFX_THROW_FAILED(ffxFsr1ContextDispatch(&data.Ctx, &desc), "Error performing FSR1!");
 
 		ZE_DRAW_TAG_END(dev, cl);
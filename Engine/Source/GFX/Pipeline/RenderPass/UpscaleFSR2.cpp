@@ -121,6 +121,7 @@ namespace ZE::GFX::Pipeline::RenderPass::UpscaleFSR2
 		desc.autoTcScale = 1.0f; // Smaller values will increase stability at hard edges of translucent objects
 		desc.autoReactiveScale = 5.00f; // Larger values result in more reactive pixels
 		desc.autoReactiveMax = 0.90f; // Maximum value reactivity can reach
+		const std::lock_guard<std::mutex> lock(FFX::GetDispatchLock());
 		ZE_FFX_THROW_FAILED(ffxFsr2ContextDispatch(&data.Ctx, &desc), "Error performing FSR2!");
 
 		ZE_DRAW_TAG_END(dev, cl);
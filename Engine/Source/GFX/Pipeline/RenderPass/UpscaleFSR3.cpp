@@ -121,6 +121,7 @@ namespace ZE::GFX::Pipeline::RenderPass::UpscaleFSR3
 		desc.cameraFovAngleVertical = Settings::Data.get<Data::Camera>(renderData.GraphData.CurrentCamera).Projection.FOV;
 		desc.viewSpaceToMetersFactor = 1.0f;
 		desc.flags = 0;
+		const std::lock_guard<std::mutex> lock(FFX::GetDispatchLock());
 		ZE_FFX_THROW_FAILED(ffxFsr3UpscalerContextDispatch(&data.Ctx, &desc), "Error performing FSR3!");
 
 		ZE_DRAW_TAG_END(dev, cl);
@@ -3,6 +3,54 @@
 
 namespace ZE::GFX::Pipeline::RenderPass::Utils
 {
+	void KeySort(VisibilityBuffer& buffer, SortEntry* entries, Allocator::FrameArena& arena) noexcept
+	{
+		constexpr U8 DIGIT_BITS = 8;
+		constexpr U16 DIGIT_RANGE = 1 << DIGIT_BITS;
+		constexpr U8 PASS_COUNT = sizeof(U64) * 8 / DIGIT_BITS;
+
+		if (buffer.Count < 2)
+			return;
+
+		// Gather histograms of all digits at once
+		std::array<std::array<U32, DIGIT_RANGE>, PASS_COUNT> histograms = {};
+		for (U32 i = 0; i < buffer.Count; ++i)
+		{
+			const U64 key = entries[i].Key;
+			for (U8 pass = 0; pass < PASS_COUNT; ++pass)
+				++histograms[pass][(key >> (pass * DIGIT_BITS)) & (DIGIT_RANGE - 1)];
+		}
+
+		SortEntry* source = entries;
+		SortEntry* destination = arena.Alloc<SortEntry>(buffer.Count);
+		for (U8 pass = 0; pass < PASS_COUNT; ++pass)
+		{
+			auto& histogram = histograms[pass];
+			const U32 shift = pass * DIGIT_BITS;
+
+			// Skip digits that are the same for all keys, usually most significant ones
+			if (histogram[(source[0].Key >> shift) & (DIGIT_RANGE - 1)] == buffer.Count)
+				continue;
+
+			U32 offset = 0;
+			for (U32& bucket : histogram)
+			{
+				const U32 bucketSize = bucket;
+				bucket = offset;
+				offset += bucketSize;
+			}
+			for (U32 i = 0; i < buffer.Count; ++i)
+				destination[histogram[(source[i].Key >> shift) & (DIGIT_RANGE - 1)]++] = source[i];
+			std::swap(source, destination);
+		}
+
+		// Reorder entities according to sorted keys
+		VisibleEntity* entities = arena.Alloc<VisibleEntity>(buffer.Count);
+		std::copy(buffer.Entities, buffer.Entities + buffer.Count, entities);
+		for (U32 i = 0; i < buffer.Count; ++i)
+			buffer.Entities[i] = entities[source[i].Index];
+	}
+
 	void ShowCubemapDebugUI(const char* title, const Data::CubemapSource& source, const char* newSourceDir, Data::CubemapSource& newSource, bool& updateData, bool& updateError) noexcept
 	{
 		ImGui::Text(title);
@@ -52,8 +52,6 @@ namespace ZE::GFX::Pipeline::RenderPass::Wireframe
 		psoDesc.InputLayout.emplace_back(Resource::InputParam::Pos3D);
 		ZE_PSO_SET_NAME(psoDesc, "Wireframe");
 		passData->State.Init(dev, psoDesc, buildData.BindingLib.GetSchema(passData->BindingIndex));
-
-		Settings::AssureEntityPools<InsideFrustum>();
 		return passData;
 	}
 
@@ -64,6 +62,8 @@ namespace ZE::GFX::Pipeline::RenderPass::Wireframe
 		if (count)
 		{
 			ZE_PERF_GUARD("Wireframe - present");
+			Resources ids = *passData.Resources.CastConst<Resources>();
+			ExecuteData& data = *passData.ExecData.Cast<ExecuteData>();
 			const Matrix viewProjection = Math::XMLoadFloat4x4(&renderData.DynamicData.ViewProjectionTps);
 
 			// Compute visibility of objects inside camera view
@@ -71,14 +71,10 @@ namespace ZE::GFX::Pipeline::RenderPass::Wireframe
 			Math::BoundingFrustum frustum = Data::GetFrustum(Math::XMLoadFloat4x4(&renderData.GraphData.Projection), Settings::MaxRenderDistance);
 			frustum.Transform(frustum, 1.0f, Math::XMLoadFloat4(&Settings::Data.get<Data::TransformGlobal>(renderData.GraphData.CurrentCamera).Rotation),
 				Math::XMLoadFloat3(&renderData.DynamicData.CameraPos));
-			Utils::FrustumCulling<InsideFrustum, InsideFrustum>(group, frustum);
+			Utils::VisibilityBuffer visibleBuffer;
+			Utils::FrustumCulling(group, data.Culling, frustum, renderData.FrameArena, visibleBuffer);
 			ZE_PERF_STOP();
-
-			auto visibleGroup = Data::GetVisibleRenderGroup<Data::RenderWireframe, InsideFrustum>();
-			count = visibleGroup.size();
-
-			Resources ids = *passData.Resources.CastConst<Resources>();
-			ExecuteData& data = *passData.ExecData.Cast<ExecuteData>();
+			count = visibleBuffer.Count;
 
 			ZE_DRAW_TAG_BEGIN(dev, cl, "Wireframe", Pixel(0xBC, 0x54, 0x4B));
 			renderData.Buffers.BeginRaster(cl, ids.RenderTarget, ids.DepthStencil);
@@ -97,29 +93,23 @@ namespace ZE::GFX::Pipeline::RenderPass::Wireframe
 			for (U64 i = 0; i < count; ++i)
 			{
 				ZE_PERF_GUARD("Wireframe - single loop item");
-				ZE_DRAW_TAG_BEGIN(dev, cl, ("Mesh_" + std::to_string(i)).c_str(), Pixel(0xE3, 0x24, 0x2B));
+				ZE_DRAW_TAG_BEGIN(dev, cl, renderData.FrameArena.Concat("Mesh_", i), Pixel(0xE3, 0x24, 0x2B));
 
-				auto entity = visibleGroup[i];
-				const auto& transform = visibleGroup.get<Data::TransformGlobal>(entity);
+				const EID entity = visibleBuffer.Entities[i].Entity;
 
 				TransformBuffer transformBuffer;
 				Math::XMStoreFloat4x4(&transformBuffer.TransformTps, viewProjection *
-					Math::XMMatrixTranspose(Math::GetTransform(transform.Position, transform.Rotation, transform.Scale)));
+					Math::XMLoadFloat4x4(&Settings::Data.get<Data::TransformMatrix>(entity).ModelTps));
 
 				cbuffer.AllocBind(dev, cl, ctx, &transformBuffer, sizeof(TransformBuffer));
 				ctx.Reset();
 
-				Settings::Data.get<Resource::Mesh>(visibleGroup.get<Data::MeshID>(entity).ID).Draw(dev, cl);
+				Settings::Data.get<Resource::Mesh>(Settings::Data.get<Data::MeshID>(entity).ID).Draw(dev, cl);
 				ZE_DRAW_TAG_END(dev, cl);
 			}
 			renderData.Buffers.EndRaster(cl);
 			ZE_PERF_STOP();
 			ZE_DRAW_TAG_END(dev, cl);
-
-			// Remove current visibility
-			ZE_PERF_START("Wireframe - visibility clear");
-			Settings::Data.clear<InsideFrustum>();
-			ZE_PERF_STOP();
 			return true;
 		}
 		return false;
@@ -1,42 +1,22 @@
 #include "IO/Compressor.h"
+#include "Settings.h"
 ZE_WARNING_PUSH
 #include "zlib.h"
 #include "bzlib.h"
+#include "lz4.h"
+#include "lz4hc.h"
+#include "zstd.h"
+#include "zdict.h"
 ZE_WARNING_POP
 
 namespace ZE::IO
 {
-	U32 Compressor::GetOriginalSize(const void* compressedBuffer, U32 compressedSize) const noexcept
+	void Compressor::CompressBlock(const void* input, U32 inputSize, std::vector<U8>& output) const noexcept
 	{
 		switch (format)
 		{
 		default:
 			ZE_ENUM_UNHANDLED();
-		case CompressionFormat::None:
-		{
-			ZE_WARNING("Unoptimal code path, codec shouldn't be used without compression!");
-			return compressedSize;
-		}
-		case CompressionFormat::ZLib:
-		case CompressionFormat::Bzip2:
-			return *reinterpret_cast<const U32*>(reinterpret_cast<const U8*>(compressedBuffer) + compressedSize - sizeof(U32) - 1);
-		}
-	}
-
-	std::vector<U8> Compressor::Compress(const void* input, U32 inputSize) const noexcept
-	{
-		std::vector<U8> compressed;
-		switch (format)
-		{
-		default:
-			ZE_ENUM_UNHANDLED();
-		case CompressionFormat::None:
-		{
-			ZE_WARNING("Unoptimal code path, compression codec shouldn't be used without compression!");
-			compressed.resize(inputSize);
-			std::memcpy(compressed.data(), input, inputSize);
-			break;
-		}
 		case CompressionFormat::ZLib:
 		{
 			z_stream strm = {};
@@ -48,13 +28,13 @@ namespace ZE::IO
 			strm.data_type = Z_BINARY;
 
 			// [9..15], [1..9], Z_RLE should be good for image data
-			[[maybe_unused]] S32 ret = deflateInit2(&strm, Z_BEST_COMPRESSION, Z_DEFLATED, 15, 9, Z_DEFAULT_STRATEGY);
+			[[maybe_unused]] S32 ret = deflateInit2(&strm, level == DEFAULT_LEVEL ? Z_BEST_COMPRESSION : level, Z_DEFLATED, 15, 9, Z_DEFAULT_STRATEGY);
 			ZE_ASSERT(ret == Z_OK, "Error initializing ZLIB deflate compression!");
 
 			// Get max size after decompression
 			strm.avail_out = deflateBound(&strm, inputSize);
-			compressed.resize(strm.avail_out);
-			strm.next_out = compressed.data();
+			output.resize(strm.avail_out);
+			strm.next_out = output.data();
 
 			ret = deflate(&strm, Z_FINISH);
 			ZE_ASSERT(ret == Z_STREAM_END && strm.avail_in == 0, "Error performing ZLIB deflate compression!");
@@ -62,48 +42,85 @@ namespace ZE::IO
 			ret = deflateEnd(&strm);
 			ZE_ASSERT(ret == Z_OK, "Error ending ZLIB deflate compression!");
 
-			// Resize to actual size and append original file size (2 bytes added at the end of stream so there would be no data errors)
-			compressed.resize(static_cast<U64>(strm.next_out - compressed.data()) + sizeof(U32) + 2);
-			*reinterpret_cast<U32*>(&compressed.at(compressed.size() - sizeof(U32) - 1)) = inputSize;
+			output.resize(static_cast<U64>(strm.next_out - output.data()));
 			break;
 		}
 		case CompressionFormat::Bzip2:
 		{
-			// Can't determine lower bound as in Zlib so assume at least current size
-			compressed.resize(inputSize);
+			// Worst case expansion of Bzip2 is 1% of input size plus 600 bytes
+			U32 compressedSize = inputSize + inputSize / 100 + 600;
+			output.resize(compressedSize);
 
-			U32 compressedSize = inputSize;
-			[[maybe_unused]] S32 ret = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(compressed.data()), &compressedSize,
-				reinterpret_cast<char*>(const_cast<void*>(input)), inputSize, 9, 0, 0);
+			[[maybe_unused]] S32 ret = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(output.data()), &compressedSize,
+				reinterpret_cast<char*>(const_cast<void*>(input)), inputSize, level == DEFAULT_LEVEL ? 9 : level, 0, 0);
 			ZE_ASSERT(ret == BZ_OK, "Error performing Bzip2 compression!");
 
-			// Resize to actual size and append original file size (2 bytes added at the end of stream so there would be no data errors)
-			compressed.resize(compressedSize + sizeof(U32) + 2);
-			*reinterpret_cast<U32*>(&compressed.at(compressed.size() - sizeof(U32) - 1)) = inputSize;
+			output.resize(compressedSize);
+			break;
+		}
+		case CompressionFormat::Lz4:
+		case CompressionFormat::Lz4HC:
+		{
+			const S32 maxSize = LZ4_compressBound(Utils::SafeCast<S32>(inputSize));
+			ZE_ASSERT(maxSize > 0, "Input too large for LZ4 compression!");
+			output.resize(maxSize);
+
+			S32 compressedSize = 0;
+			if (format == CompressionFormat::Lz4)
+			{
+				compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(input), reinterpret_cast<char*>(output.data()),
+					Utils::SafeCast<S32>(inputSize), maxSize, level == DEFAULT_LEVEL ? 1 : level);
+			}
+			else
+			{
+				compressedSize = LZ4_compress_HC(reinterpret_cast<const char*>(input), reinterpret_cast<char*>(output.data()),
+					Utils::SafeCast<S32>(inputSize), maxSize, level == DEFAULT_LEVEL ? LZ4HC_CLEVEL_MAX : level);
+			}
+			ZE_ASSERT(compressedSize > 0, "Error performing LZ4 compression!");
+
+			output.resize(compressedSize);
+			break;
+		}
+		case CompressionFormat::Zstd:
+		case CompressionFormat::ZstdDictionary:
+		{
+			output.resize(ZSTD_compressBound(inputSize));
+
+			// Levels above 19 require a lot of memory for decompression so are not used by default
+			U64 compressedSize = 0;
+			if (format == CompressionFormat::Zstd)
+				compressedSize = ZSTD_compress(output.data(), output.size(), input, inputSize, level == DEFAULT_LEVEL ? 19 : level);
+			else
+			{
+				ZE_ASSERT(dictionary && dictionarySize, "Dictionary not set for Zstd compression!");
+				// Dictionary is used for small buffers so skip all optional frame data (size is already stored in footer)
+				ZSTD_CCtx* ctx = ZSTD_createCCtx();
+				ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, level == DEFAULT_LEVEL ? 19 : level);
+				ZSTD_CCtx_setParameter(ctx, ZSTD_c_contentSizeFlag, 0);
+				ZSTD_CCtx_setParameter(ctx, ZSTD_c_dictIDFlag, 0);
+				ZSTD_CCtx_loadDictionary(ctx, dictionary, dictionarySize);
+				compressedSize = ZSTD_compress2(ctx, output.data(), output.size(), input, inputSize);
+				ZSTD_freeCCtx(ctx);
+			}
+			ZE_ASSERT(!ZSTD_isError(compressedSize), "Error performing Zstd compression!");
+
+			output.resize(compressedSize);
 			break;
 		}
 		}
-		return compressed;
 	}
 
-	void Compressor::Decompress(const void* src, U32 srcSize, void* dst, U32 dstSize) const noexcept
+	void Compressor::DecompressBlock(const void* src, U32 srcSize, void* dst, U32 dstSize) const noexcept
 	{
 		switch (format)
 		{
 		default:
 			ZE_ENUM_UNHANDLED();
-		case CompressionFormat::None:
-		{
-			ZE_WARNING("Unoptimal code path, decompression codec shouldn't be used without compression!");
-			ZE_ASSERT(srcSize == dstSize, "For not compressed data compressed and decompressed size should be equal!");
-			std::memcpy(dst, src, dstSize);
-			break;
-		}
 		case CompressionFormat::ZLib:
 		{
 			z_stream strm = {};
 			strm.next_in = reinterpret_cast<const U8*>(src);
-			strm.avail_in = srcSize - sizeof(U32);
+			strm.avail_in = srcSize;
 			strm.zalloc = nullptr;
 			strm.zfree = nullptr;
 			strm.opaque = nullptr;
@@ -115,7 +132,7 @@ namespace ZE::IO
 			strm.next_out = reinterpret_cast<U8*>(dst);
 			strm.avail_out = dstSize;
 			ret = inflate(&strm, Z_FINISH);
-			ZE_ASSERT(ret == Z_STREAM_END && strm.avail_in == 2 && strm.avail_out == 0,
+			ZE_ASSERT(ret == Z_STREAM_END && strm.avail_in == 0 && strm.avail_out == 0,
 				"Error performing ZLIB inflate decompression!");
 
 			ret = inflateEnd(&strm);
@@ -124,11 +141,192 @@ namespace ZE::IO
 		}
 		case CompressionFormat::Bzip2:
 		{
+			[[maybe_unused]] const U32 expectedSize = dstSize;
 			[[maybe_unused]] S32 ret = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(dst), &dstSize,
-				reinterpret_cast<char*>(const_cast<void*>(src)), srcSize - sizeof(U32) - 2, 0, 0);
-			ZE_ASSERT(ret == BZ_OK && GetOriginalSize(src, srcSize) == dstSize, "Error performing Bzip2 decompression!");
+				reinterpret_cast<char*>(const_cast<void*>(src)), srcSize, 0, 0);
+			ZE_ASSERT(ret == BZ_OK && dstSize == expectedSize, "Error performing Bzip2 decompression!");
+			break;
+		}
+		case CompressionFormat::Lz4:
+		case CompressionFormat::Lz4HC:
+		{
+			[[maybe_unused]] const S32 ret = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+				Utils::SafeCast<S32>(srcSize), Utils::SafeCast<S32>(dstSize));
+			ZE_ASSERT(ret >= 0 && static_cast<U32>(ret) == dstSize, "Error performing LZ4 decompression!");
 			break;
 		}
+		case CompressionFormat::Zstd:
+		case CompressionFormat::ZstdDictionary:
+		{
+			[[maybe_unused]] U64 ret = 0;
+			if (format == CompressionFormat::Zstd)
+				ret = ZSTD_decompress(dst, dstSize, src, srcSize);
+			else
+			{
+				ZE_ASSERT(dictionary && dictionarySize, "Dictionary not set for Zstd decompression!");
+				ZSTD_DCtx* ctx = ZSTD_createDCtx();
+				ZSTD_DCtx_loadDictionary(ctx, dictionary, dictionarySize);
+				ret = ZSTD_decompressDCtx(ctx, dst, dstSize, src, srcSize);
+				ZSTD_freeDCtx(ctx);
+			}
+			ZE_ASSERT(!ZSTD_isError(ret) && ret == dstSize, "Error performing Zstd decompression!");
+			break;
+		}
+		}
+	}
+
+	std::vector<U8> Compressor::TrainDictionary(const std::vector<U8>& samples, const std::vector<size_t>& sampleSizes, U32 maxSize) noexcept
+	{
+		std::vector<U8> dictionary(maxSize);
+		const U64 dictSize = ZDICT_trainFromBuffer(dictionary.data(), maxSize, samples.data(),
+			sampleSizes.data(), Utils::SafeCast<U32>(sampleSizes.size()));
+		if (ZDICT_isError(dictSize))
+			dictionary.clear();
+		else
+			dictionary.resize(dictSize);
+		return dictionary;
+	}
+
+	CompressionFormat Compressor::CompressBest(const void* input, U32 inputSize, float minSaving, std::vector<U8>& output, const void* dictionary, U32 dictionarySize) noexcept
+	{
+		// Bzip2 and Lz4 are skipped as they are always beaten by ZLib and Lz4HC respectively
+		const std::array<CompressionFormat, 3> candidates =
+		{
+			CompressionFormat::Lz4HC,
+			dictionary ? CompressionFormat::ZstdDictionary : CompressionFormat::Zstd,
+			CompressionFormat::ZLib
+		};
+
+		// Raw data is kept only when no codec gives enough savings, otherwise pick fastest to load
+		CompressionFormat bestFormat = CompressionFormat::None;
+		U64 bestCost = UINT64_MAX;
+		const U64 maxSize = static_cast<U64>(static_cast<double>(inputSize) * (1.0 - minSaving));
+		output.clear();
+		for (CompressionFormat format : candidates)
+		{
+			Compressor codec(format);
+			codec.SetDictionary(dictionary, dictionarySize);
+			std::vector<U8> compressed = codec.Compress(input, inputSize);
+
+			const U64 cost = GetLoadCost(format, compressed.size(), inputSize);
+			if (compressed.size() <= maxSize && cost < bestCost)
+			{
+				bestFormat = format;
+				bestCost = cost;
+				output = std::move(compressed);
+			}
+		}
+		return bestFormat;
+	}
+
+	U32 Compressor::GetOriginalSize(const void* compressedBuffer, U32 compressedSize) const noexcept
+	{
+		if (format == CompressionFormat::None)
+		{
+			ZE_WARNING("Unoptimal code path, codec shouldn't be used without compression!");
+			return compressedSize;
+		}
+		return *reinterpret_cast<const U32*>(reinterpret_cast<const U8*>(compressedBuffer) + compressedSize - sizeof(U32) - 1);
+	}
+
+	std::vector<U8> Compressor::Compress(const void* input, U32 inputSize, bool chunked) const noexcept
+	{
+		std::vector<U8> compressed;
+		if (format == CompressionFormat::None)
+		{
+			ZE_WARNING("Unoptimal code path, compression codec shouldn't be used without compression!");
+			compressed.resize(inputSize);
+			std::memcpy(compressed.data(), input, inputSize);
+			return compressed;
+		}
+
+		chunked &= inputSize > BLOCK_SIZE;
+		if (chunked)
+		{
+			const U32 blockCount = Math::DivideRoundUp(inputSize, BLOCK_SIZE);
+			const U32 tableSize = (blockCount + 2) * sizeof(U32);
+
+			// Blocks are independent so they can be compressed in parallel too
+			std::vector<std::vector<U8>> blocks(blockCount);
+			Settings::GetThreadPool().ProcessChunks(blockCount, ThreadPriority::Critical, [&](U64 chunk)
+				{
+					const U32 i = Utils::SafeCast<U32>(chunk);
+					const U8* blockInput = reinterpret_cast<const U8*>(input) + static_cast<U64>(i) * BLOCK_SIZE;
+					const U32 blockSize = std::min(BLOCK_SIZE, inputSize - i * BLOCK_SIZE);
+					CompressBlock(blockInput, blockSize, blocks.at(i));
+
+					// Data that cannot be compressed is stored as is
+					if (blocks.at(i).size() >= blockSize)
+					{
+						blocks.at(i).resize(blockSize);
+						std::memcpy(blocks.at(i).data(), blockInput, blockSize);
+					}
+				});
+
+			U64 dataSize = tableSize;
+			for (const auto& block : blocks)
+				dataSize += block.size();
+			compressed.resize(dataSize + FOOTER_SIZE);
+
+			U32* table = reinterpret_cast<U32*>(compressed.data());
+			table[0] = BLOCK_SIZE;
+			table[1] = blockCount;
+			for (U32 i = 0, blockEnd = 0; i < blockCount; ++i)
+			{
+				std::memcpy(compressed.data() + tableSize + blockEnd, blocks.at(i).data(), blocks.at(i).size());
+				blockEnd += Utils::SafeCast<U32>(blocks.at(i).size());
+				table[i + 2] = blockEnd;
+			}
+		}
+		else
+		{
+			CompressBlock(input, inputSize, compressed);
+			compressed.resize(compressed.size() + FOOTER_SIZE);
+		}
+
+		// Append original file size (2 bytes added at the end of stream so there would be no data errors, last one marks layout of stream)
+		*reinterpret_cast<U32*>(&compressed.at(compressed.size() - sizeof(U32) - 1)) = inputSize;
+		compressed.back() = chunked;
+		return compressed;
+	}
+
+	void Compressor::Decompress(const void* src, U32 srcSize, void* dst, U32 dstSize) const noexcept
+	{
+		if (format == CompressionFormat::None)
+		{
+			ZE_WARNING("Unoptimal code path, decompression codec shouldn't be used without compression!");
+			ZE_ASSERT(srcSize == dstSize, "For not compressed data compressed and decompressed size should be equal!");
+			std::memcpy(dst, src, dstSize);
+			return;
+		}
+		ZE_ASSERT(srcSize > FOOTER_SIZE && GetOriginalSize(src, srcSize) == dstSize, "Incorrect size of compressed stream!");
+
+		const U8* data = reinterpret_cast<const U8*>(src);
+		if (data[srcSize - 1])
+		{
+			const U32* table = reinterpret_cast<const U32*>(data);
+			const U32 blockSize = table[0];
+			const U32 blockCount = table[1];
+			const U32* blockEnds = table + 2;
+			const U8* blocks = reinterpret_cast<const U8*>(blockEnds + blockCount);
+			ZE_ASSERT(Math::DivideRoundUp(dstSize, blockSize) == blockCount, "Incorrect block table of chunked stream!");
+
+			// Workers write every block straight into it's final place
+			Settings::GetThreadPool().ProcessChunks(blockCount, ThreadPriority::Critical, [&](U64 chunk)
+				{
+					const U32 i = Utils::SafeCast<U32>(chunk);
+					const U32 blockStart = i ? blockEnds[i - 1] : 0;
+					const U32 compressedSize = blockEnds[i] - blockStart;
+					const U32 uncompressedSize = std::min(blockSize, dstSize - i * blockSize);
+					U8* blockDst = reinterpret_cast<U8*>(dst) + static_cast<U64>(i) * blockSize;
+
+					if (compressedSize == uncompressedSize)
+						std::memcpy(blockDst, blocks + blockStart, uncompressedSize);
+					else
+						DecompressBlock(blocks + blockStart, compressedSize, blockDst, uncompressedSize);
+				});
 		}
+		else
+			DecompressBlock(src, srcSize - FOOTER_SIZE, dst, dstSize);
 	}
 }
\ No newline at end of file
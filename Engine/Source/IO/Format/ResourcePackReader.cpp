@@ -0,0 +1,70 @@
+#include "IO/Format/ResourcePackReader.h"
+
+namespace ZE::IO::Format
+{
+	FileStatus ResourcePackReader::Open(std::string_view packFile) noexcept
+	{
+		Close();
+		if (!file.Open(packFile))
+			return FileStatus::ErrorOpeningFile;
+
+		if (file.GetSize() < sizeof(ResourcePackFileHeader))
+		{
+			Close();
+			return FileStatus::ErrorReading;
+		}
+		header = reinterpret_cast<const ResourcePackFileHeader*>(file.GetData());
+
+		// Check if signature is correct first and resources are present
+		if (std::memcmp(header->Signature, ResourcePackFileHeader::SIGNATURE_STR, 4) != 0)
+		{
+			Close();
+			return FileStatus::ErrorBadSignature;
+		}
+		if (header->ResourcesCount == 0)
+		{
+			Close();
+			return FileStatus::ErrorNoResources;
+		}
+
+		// Info section is laid out the same in every version, all structures are packed so no alignment is required
+		const U64 infoSectionSize = header->ResourcesCount * sizeof(ResourcePackEntry)
+			+ header->TexturesCount * sizeof(ResourcePackTextureEntry)
+			+ header->NameSectionSize;
+		if (file.GetSize() - sizeof(ResourcePackFileHeader) < infoSectionSize)
+		{
+			Close();
+			return FileStatus::ErrorReading;
+		}
+
+		const ResourcePackEntry* resources = reinterpret_cast<const ResourcePackEntry*>(file.GetData() + sizeof(ResourcePackFileHeader));
+		const ResourcePackTextureEntry* textures = reinterpret_cast<const ResourcePackTextureEntry*>(resources + header->ResourcesCount);
+		resourceTable = { resources, header->ResourcesCount };
+		textureTable = { textures, header->TexturesCount };
+		nameTable = { reinterpret_cast<const char*>(textures + header->TexturesCount), header->NameSectionSize };
+		return FileStatus::Ok;
+	}
+
+	void ResourcePackReader::Close() noexcept
+	{
+		header = nullptr;
+		resourceTable = {};
+		textureTable = {};
+		nameTable = {};
+		file.Close();
+	}
+
+	std::string_view ResourcePackReader::GetName(U32 index, U16 size) const noexcept
+	{
+		if (index > nameTable.size() || size > nameTable.size() - index)
+			return {};
+		return nameTable.substr(index, size);
+	}
+
+	std::span<const U8> ResourcePackReader::GetData(U64 offset, U32 bytes) const noexcept
+	{
+		if (offset > file.GetSize() || bytes > file.GetSize() - offset)
+			return {};
+		return { file.GetData() + offset, bytes };
+	}
+}
\ No newline at end of file
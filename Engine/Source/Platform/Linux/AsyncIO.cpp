@@ -0,0 +1,325 @@
+#include "Platform/Linux/AsyncIO.h"
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace ZE::Linux
+{
+	AsyncIO::AsyncIO() noexcept
+	{
+		if (InitRing())
+		{
+			threads.emplace_back(&AsyncIO::SubmitLoop, this);
+			threads.emplace_back(&AsyncIO::CompleteLoop, this);
+		}
+		else
+		{
+			for (U32 i = 0; i < FALLBACK_THREAD_COUNT; ++i)
+				threads.emplace_back(&AsyncIO::FallbackLoop, this);
+		}
+	}
+
+	bool AsyncIO::InitRing() noexcept
+	{
+		// Bigger completion queue allows for submitting new requests while previous completions are still processed
+		io_uring_params params = {};
+		params.flags = IORING_SETUP_CQSIZE;
+		params.cq_entries = QUEUE_DEPTH * 2;
+		ring.FD = static_cast<int>(syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params));
+		if (ring.FD < 0)
+		{
+			ring.FD = -1;
+			return false;
+		}
+		// IORING_OP_READ and IORING_OP_WRITE appeared together with this feature (kernel 5.6)
+		if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+		{
+			DestroyRing();
+			return false;
+		}
+
+		ring.SqMappingSize = params.sq_off.array + params.sq_entries * sizeof(U32);
+		ring.CqMappingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool singleMapping = params.features & IORING_FEAT_SINGLE_MMAP;
+		if (singleMapping)
+			ring.SqMappingSize = ring.CqMappingSize = std::max(ring.SqMappingSize, ring.CqMappingSize);
+
+		ring.SqMapping = mmap(nullptr, ring.SqMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.FD, IORING_OFF_SQ_RING);
+		if (ring.SqMapping == MAP_FAILED)
+		{
+			ring.SqMapping = nullptr;
+			DestroyRing();
+			return false;
+		}
+		if (singleMapping)
+			ring.CqMapping = ring.SqMapping;
+		else
+		{
+			ring.CqMapping = mmap(nullptr, ring.CqMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.FD, IORING_OFF_CQ_RING);
+			if (ring.CqMapping == MAP_FAILED)
+			{
+				ring.CqMapping = nullptr;
+				DestroyRing();
+				return false;
+			}
+		}
+		ring.SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = mmap(nullptr, ring.SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.FD, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED)
+		{
+			DestroyRing();
+			return false;
+		}
+		ring.Sqes = reinterpret_cast<io_uring_sqe*>(sqes);
+
+		ring.EventFD = eventfd(0, EFD_CLOEXEC);
+		if (ring.EventFD < 0 || syscall(__NR_io_uring_register, ring.FD, IORING_REGISTER_EVENTFD, &ring.EventFD, 1) < 0)
+		{
+			DestroyRing();
+			return false;
+		}
+
+		U8* sqRing = reinterpret_cast<U8*>(ring.SqMapping);
+		ring.SqTail = reinterpret_cast<U32*>(sqRing + params.sq_off.tail);
+		ring.SqMask = *reinterpret_cast<U32*>(sqRing + params.sq_off.ring_mask);
+		ring.SqArray = reinterpret_cast<U32*>(sqRing + params.sq_off.array);
+
+		U8* cqRing = reinterpret_cast<U8*>(ring.CqMapping);
+		ring.CqHead = reinterpret_cast<U32*>(cqRing + params.cq_off.head);
+		ring.CqTail = reinterpret_cast<U32*>(cqRing + params.cq_off.tail);
+		ring.CqMask = *reinterpret_cast<U32*>(cqRing + params.cq_off.ring_mask);
+		ring.Cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+		return true;
+	}
+
+	void AsyncIO::DestroyRing() noexcept
+	{
+		if (ring.Sqes)
+			munmap(ring.Sqes, ring.SqesSize);
+		if (ring.CqMapping && ring.CqMapping != ring.SqMapping)
+			munmap(ring.CqMapping, ring.CqMappingSize);
+		if (ring.SqMapping)
+			munmap(ring.SqMapping, ring.SqMappingSize);
+		if (ring.FD != -1)
+			close(ring.FD);
+		if (ring.EventFD >= 0)
+			close(ring.EventFD);
+		ring = {};
+	}
+
+	void AsyncIO::SubmitLoop() noexcept
+	{
+		std::vector<Request*> batch;
+		for (bool exit = false; !exit;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				queueCondition.wait(lock, [this]() { return (pending.size() && inFlight < QUEUE_DEPTH) || (shutdown && inFlight == 0); });
+
+				// Take as many requests as possible, single system call submits all of them
+				const U64 count = std::min(pending.size(), static_cast<U64>(QUEUE_DEPTH - inFlight));
+				batch.assign(pending.begin(), pending.begin() + count);
+				pending.erase(pending.begin(), pending.begin() + count);
+				inFlight += Utils::SafeCast<U32>(batch.size());
+
+				// Completion thread is signaled to finish only when nothing is in flight, as short transfers are resubmitted
+				if (batch.empty())
+				{
+					batch.emplace_back(nullptr);
+					++inFlight;
+					exit = true;
+				}
+			}
+
+			// Only this thread writes to submission queue
+			U32 tail = *ring.SqTail;
+			for (Request* request : batch)
+			{
+				const U32 index = tail++ & ring.SqMask;
+				io_uring_sqe& sqe = ring.Sqes[index];
+				std::memset(&sqe, 0, sizeof(io_uring_sqe));
+				if (request)
+				{
+					sqe.opcode = request->IsRead ? IORING_OP_READ : IORING_OP_WRITE;
+					sqe.fd = request->File;
+					sqe.addr = reinterpret_cast<U64>(reinterpret_cast<U8*>(request->Buffer) + request->Transferred);
+					sqe.len = request->Size - request->Transferred;
+					sqe.off = request->Offset + request->Transferred;
+					sqe.user_data = reinterpret_cast<U64>(request);
+				}
+				else
+				{
+					sqe.opcode = IORING_OP_NOP;
+					sqe.user_data = SHUTDOWN_TAG;
+				}
+				ring.SqArray[index] = index;
+			}
+			std::atomic_ref<U32>(*ring.SqTail).store(tail, std::memory_order_release);
+
+			for (U32 toSubmit = Utils::SafeCast<U32>(batch.size()); toSubmit;)
+			{
+				const int submitted = static_cast<int>(syscall(__NR_io_uring_enter, ring.FD, toSubmit, 0, 0, nullptr, 0));
+				if (submitted < 0)
+				{
+					if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+					ZE_WARNING("Cannot submit requests to io_uring, executing them synchronously!");
+
+					// Kernel consumes entries in order so only last ones are left in the queue, remove them and finish here
+					std::atomic_ref<U32>(*ring.SqTail).store(tail - toSubmit, std::memory_order_release);
+					bool skippedShutdown = false;
+					for (auto it = batch.end() - toSubmit; it != batch.end(); ++it)
+					{
+						if (Request* request = *it)
+						{
+							request->Result.set_value(request->Transferred + Transfer(request->File, request->IsRead,
+								reinterpret_cast<U8*>(request->Buffer) + request->Transferred, request->Size - request->Transferred,
+								request->Offset + request->Transferred));
+							delete request;
+						}
+						else
+							skippedShutdown = true;
+					}
+					{
+						std::lock_guard<std::mutex> lock(queueMutex);
+						inFlight -= toSubmit;
+						shutdownSkipped = skippedShutdown;
+					}
+					queueCondition.notify_all();
+					if (skippedShutdown)
+					{
+						const U64 signal = 1;
+						[[maybe_unused]] const ssize_t written = write(ring.EventFD, &signal, sizeof(signal));
+					}
+					break;
+				}
+				toSubmit -= static_cast<U32>(submitted);
+			}
+			batch.clear();
+		}
+	}
+
+	void AsyncIO::CompleteLoop() noexcept
+	{
+		std::vector<Request*> resubmit;
+		bool shutdownReceived = false;
+		for (bool exit = false; !exit;)
+		{
+			// Only this thread reads from completion queue
+			U32 head = *ring.CqHead;
+			const U32 tail = std::atomic_ref<U32>(*ring.CqTail).load(std::memory_order_acquire);
+			if (head == tail)
+			{
+				// Completions posted after checking the tail are already counted by the event so they are never missed
+				U64 signals = 0;
+				[[maybe_unused]] const ssize_t readBytes = read(ring.EventFD, &signals, sizeof(signals));
+
+				std::lock_guard<std::mutex> lock(queueMutex);
+				exit = shutdownSkipped && inFlight == 0;
+				continue;
+			}
+
+			const U32 completed = tail - head;
+			for (; head != tail; ++head)
+			{
+				const io_uring_cqe& cqe = ring.Cqes[head & ring.CqMask];
+				if (cqe.user_data == SHUTDOWN_TAG)
+					shutdownReceived = true;
+				else
+				{
+					Request* request = reinterpret_cast<Request*>(cqe.user_data);
+					if (cqe.res > 0)
+						request->Transferred += static_cast<U32>(cqe.res);
+
+					// Same as in Transfer(), remaining bytes are processed until end of file or error is reached
+					if ((cqe.res > 0 && request->Transferred < request->Size) || cqe.res == -EINTR || cqe.res == -EAGAIN)
+						resubmit.emplace_back(request);
+					else
+					{
+						request->Result.set_value(request->Transferred);
+						delete request;
+					}
+				}
+			}
+			std::atomic_ref<U32>(*ring.CqHead).store(head, std::memory_order_release);
+
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				pending.insert(pending.end(), resubmit.begin(), resubmit.end());
+				inFlight -= completed;
+				exit = shutdownReceived && inFlight == 0;
+			}
+			resubmit.clear();
+			queueCondition.notify_all();
+		}
+	}
+
+	void AsyncIO::FallbackLoop() noexcept
+	{
+		for (;;)
+		{
+			Request* request = nullptr;
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				queueCondition.wait(lock, [this]() { return shutdown || pending.size(); });
+				if (pending.empty())
+					break;
+				request = pending.back();
+				pending.pop_back();
+			}
+			request->Result.set_value(Transfer(request->File, request->IsRead, request->Buffer, request->Size, request->Offset));
+			delete request;
+		}
+	}
+
+	AsyncIO::~AsyncIO()
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			shutdown = true;
+		}
+		queueCondition.notify_all();
+		for (std::thread& thread : threads)
+			thread.join();
+		DestroyRing();
+	}
+
+	U32 AsyncIO::Transfer(int file, bool isRead, void* buffer, U32 size, U64 offset) noexcept
+	{
+		U32 transferred = 0;
+		while (transferred < size)
+		{
+			U8* data = reinterpret_cast<U8*>(buffer) + transferred;
+			const off_t position = static_cast<off_t>(offset + transferred);
+			const ssize_t result = isRead ? pread(file, data, size - transferred, position) : pwrite(file, data, size - transferred, position);
+			if (result < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				break;
+			}
+			// End of file reached
+			if (result == 0)
+				break;
+			transferred += static_cast<U32>(result);
+		}
+		return transferred;
+	}
+
+	std::future<U32> AsyncIO::Submit(int file, bool isRead, void* buffer, U32 size, U64 offset) noexcept
+	{
+		Request* request = new Request{ file, isRead, buffer, size, offset };
+		std::future<U32> result = request->Result.get_future();
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			pending.emplace_back(request);
+		}
+		queueCondition.notify_all();
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "Platform/Linux/File.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ZE::Linux
+{
+	bool File::PerformSyncOperation(bool isRead, void* buffer, U32 size, U64 offset) const noexcept
+	{
+		if (buffer == nullptr || size == 0)
+		{
+			ZE_FAIL("Invalid file buffer!");
+			return false;
+		}
+		return AsyncIO::Transfer(file, isRead, buffer, size, offset) == size;
+	}
+
+	std::future<U32> File::PerformAsyncOperation(bool isRead, void* buffer, U32 size, U64 offset) const noexcept
+	{
+		if (buffer == nullptr || size == 0)
+		{
+			ZE_FAIL("Invalid file buffer!");
+			std::promise<U32> promise;
+			promise.set_value(0);
+			return promise.get_future();
+		}
+		return AsyncIO::Get().Submit(file, isRead, buffer, size, offset);
+	}
+
+	bool File::Open(std::string_view fileName, IO::FileFlags flags) noexcept
+	{
+		const bool writeOnly = flags & IO::FileFlag::WriteOnly;
+		ZE_ASSERT(writeOnly != static_cast<bool>(flags & IO::FileFlag::GpuReading)
+			|| (flags & (IO::FileFlag::GpuReading | IO::FileFlag::WriteOnly)) == 0,
+			"Cannot open file for reading by GPU and in write only mode at the same time!");
+		if (writeOnly && (flags & IO::FileFlag::GpuReading))
+			return false;
+
+		Close();
+		// Same as on Windows, file have to exist before writing to it
+		const std::string path(fileName);
+		file = open(path.c_str(), (writeOnly ? O_WRONLY : O_RDONLY) | O_CLOEXEC);
+		if (file < 0)
+		{
+			file = -1;
+			return false;
+		}
+		return true;
+	}
+
+	void File::Close() noexcept
+	{
+		if (file != -1)
+		{
+			[[maybe_unused]] const int status = close(file);
+			file = -1;
+			ZE_ASSERT(status == 0, "Error closing file handle!");
+		}
+	}
+}
\ No newline at end of file
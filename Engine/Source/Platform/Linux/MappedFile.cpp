@@ -0,0 +1,44 @@
+#include "Platform/Linux/MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ZE::Linux
+{
+	bool MappedFile::Open(std::string_view fileName) noexcept
+	{
+		Close();
+
+		const std::string path(fileName);
+		const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file < 0)
+			return false;
+
+		// Empty files cannot be mapped, mapping stays valid after closing the file
+		struct stat info = {};
+		if (fstat(file, &info) == 0 && info.st_size > 0)
+		{
+			void* mapping = mmap(nullptr, static_cast<U64>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			if (mapping != MAP_FAILED)
+			{
+				data = reinterpret_cast<const U8*>(mapping);
+				size = static_cast<U64>(info.st_size);
+			}
+		}
+		[[maybe_unused]] const int status = close(file);
+		ZE_ASSERT(status == 0, "Error closing file handle!");
+		return data != nullptr;
+	}
+
+	void MappedFile::Close() noexcept
+	{
+		if (data)
+		{
+			[[maybe_unused]] const int status = munmap(const_cast<U8*>(data), size);
+			data = nullptr;
+			ZE_ASSERT(status == 0, "Error unmapping view of file!");
+		}
+		size = 0;
+	}
+}
\ No newline at end of file
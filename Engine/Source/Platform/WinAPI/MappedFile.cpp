@@ -0,0 +1,62 @@
+#include "Platform/WinAPI/MappedFile.h"
+
+namespace ZE::WinAPI
+{
+	bool MappedFile::Open(std::wstring_view fileName) noexcept
+	{
+		Close();
+
+		file = CreateFileW(fileName.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			file = nullptr;
+			return false;
+		}
+
+		// Empty files cannot be mapped
+		LARGE_INTEGER fileSize = {};
+		if (GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+		size = static_cast<U64>(fileSize.QuadPart);
+
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			Close();
+			return false;
+		}
+		data = reinterpret_cast<const U8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (data == nullptr)
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void MappedFile::Close() noexcept
+	{
+		if (data)
+		{
+			[[maybe_unused]] const BOOL status = UnmapViewOfFile(data);
+			data = nullptr;
+			ZE_ASSERT(status, "Error unmapping view of file!");
+		}
+		if (mapping)
+		{
+			[[maybe_unused]] const BOOL status = CloseHandle(mapping);
+			mapping = nullptr;
+			ZE_ASSERT(status, "Error closing file mapping handle!");
+		}
+		if (file)
+		{
+			[[maybe_unused]] const BOOL status = CloseHandle(file);
+			file = nullptr;
+			ZE_ASSERT(status, "Error closing file handle!");
+		}
+		size = 0;
+	}
+}
\ No newline at end of file
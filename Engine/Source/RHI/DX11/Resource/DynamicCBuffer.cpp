@@ -27,7 +27,7 @@ namespace ZE::RHI::DX11::Resource
 		ZE_DX_ENABLE(dev.Get().dx11);
 
 		const U32 newBlock = Math::AlignUp(bytes, 256U);
-#ifndef _ZE_RENDER_GRAPH_SINGLE_THREAD
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
 		const std::lock_guard<std::mutex> lock(allocLock);
 #endif
 		if (nextOffset + newBlock > BLOCK_SIZE)
@@ -65,25 +65,32 @@ namespace ZE::RHI::DX11::Resource
 		auto slotData = schema.GetSlotData(slotInfo.DataStart);
 		ZE_ASSERT(slotData.Count == 1, "Constant buffer slot should only be bound as single buffer!");
 
-		auto& buffer = blocks.at(allocInfo.Block).first;
 		const U32 offset = allocInfo.Offset / 16;
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		// Blocks can be reallocated by other recording threads
+		std::unique_lock<std::mutex> lock(allocLock);
+#endif
+		IBuffer* buffer = blocks.at(allocInfo.Block).first.Get();
 		const U32 size = blocks.at(allocInfo.Block).second.Get(allocInfo.Offset);
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
+		lock.unlock();
+#endif
 		auto* ctx = cl.Get().dx11.GetContext();
 
 		if (slotData.Shaders & GFX::Resource::ShaderType::Compute)
-			ctx->CSSetConstantBuffers1(slotData.BindStart, 1, buffer.GetAddressOf(), &offset, &size);
+			ctx->CSSetConstantBuffers1(slotData.BindStart, 1, &buffer, &offset, &size);
 		else
 		{
 			if (slotData.Shaders & GFX::Resource::ShaderType::Vertex)
-				ctx->VSSetConstantBuffers1(slotData.BindStart, 1, buffer.GetAddressOf(), &offset, &size);
+				ctx->VSSetConstantBuffers1(slotData.BindStart, 1, &buffer, &offset, &size);
 			if (slotData.Shaders & GFX::Resource::ShaderType::Domain)
-				ctx->DSSetConstantBuffers1(slotData.BindStart, 1, buffer.GetAddressOf(), &offset, &size);
+				ctx->DSSetConstantBuffers1(slotData.BindStart, 1, &buffer, &offset, &size);
 			if (slotData.Shaders & GFX::Resource::ShaderType::Hull)
-				ctx->HSSetConstantBuffers1(slotData.BindStart, 1, buffer.GetAddressOf(), &offset, &size);
+				ctx->HSSetConstantBuffers1(slotData.BindStart, 1, &buffer, &offset, &size);
 			if (slotData.Shaders & GFX::Resource::ShaderType::Geometry)
-				ctx->GSSetConstantBuffers1(slotData.BindStart, 1, buffer.GetAddressOf(), &offset, &size);
+				ctx->GSSetConstantBuffers1(slotData.BindStart, 1, &buffer, &offset, &size);
 			if (slotData.Shaders & GFX::Resource::ShaderType::Pixel)
-				ctx->PSSetConstantBuffers1(slotData.BindStart, 1, buffer.GetAddressOf(), &offset, &size);
+				ctx->PSSetConstantBuffers1(slotData.BindStart, 1, &buffer, &offset, &size);
 		}
 	}
 
@@ -20,9 +20,34 @@ namespace ZE::RHI::DX12
 			return DS_COMPRESSION_FORMAT_ZLIB;
 		case IO::CompressionFormat::Bzip2:
 			return DS_COMPRESSION_FORMAT_BZIP2;
+		case IO::CompressionFormat::Lz4:
+		case IO::CompressionFormat::Lz4HC:
+			return DS_COMPRESSION_FORMAT_LZ4;
+		case IO::CompressionFormat::Zstd:
+			return DS_COMPRESSION_FORMAT_ZSTD;
 		}
 	}
 
+	constexpr IO::CompressionFormat DiskManager::GetCodecFormat(DSTORAGE_COMPRESSION_FORMAT compression) noexcept
+	{
+		ZE_WARNING_PUSH;
+		ZE_WARNING_DISABLE_MSVC(4063);
+		switch (compression)
+		{
+		default:
+			ZE_ENUM_UNHANDLED();
+		case DS_COMPRESSION_FORMAT_ZLIB:
+			return IO::CompressionFormat::ZLib;
+		case DS_COMPRESSION_FORMAT_BZIP2:
+			return IO::CompressionFormat::Bzip2;
+		case DS_COMPRESSION_FORMAT_LZ4:
+			return IO::CompressionFormat::Lz4;
+		case DS_COMPRESSION_FORMAT_ZSTD:
+			return IO::CompressionFormat::Zstd;
+		}
+		ZE_WARNING_POP;
+	}
+
 	bool DiskManager::IsFileOnSSD(std::wstring_view path) noexcept
 	{
 		wchar_t volumePath[MAX_PATH];
@@ -89,7 +114,6 @@ namespace ZE::RHI::DX12
 			ZE_DX_THROW_FAILED(decompressQueue->GetRequests1(DSTORAGE_GET_REQUEST_FLAG_SELECT_CUSTOM, maxRequestCount, requests.get(), &requestCount));
 			for (U32 i = 0; i < requestCount; ++i)
 			{
-				bool bzip2 = false;
 				DSTORAGE_CUSTOM_DECOMPRESSION_REQUEST& req = requests[i];
 				DSTORAGE_CUSTOM_DECOMPRESSION_RESULT& res = results[i];
 				switch (req.CompressionFormat)
@@ -104,19 +128,19 @@ namespace ZE::RHI::DX12
 				}
 				ZE_WARNING_PUSH;
 				ZE_WARNING_DISABLE_MSVC(4063);
-				case DS_COMPRESSION_FORMAT_BZIP2:
-					bzip2 = true;
-					[[fallthrough]];
 				case DS_COMPRESSION_FORMAT_ZLIB:
+				case DS_COMPRESSION_FORMAT_BZIP2:
+				case DS_COMPRESSION_FORMAT_LZ4:
+				case DS_COMPRESSION_FORMAT_ZSTD:
 				{
 					decompresionTasks[i] = pool.Schedule(ThreadPriority::Normal,
-						[bzip2](const void* src, U32 srcSize, void* dst, U32 dstSize)
+						[](IO::CompressionFormat format, const void* src, U32 srcSize, void* dst, U32 dstSize)
 						{
-							IO::Compressor codec(bzip2 ? IO::CompressionFormat::Bzip2 : IO::CompressionFormat::ZLib);
+							IO::Compressor codec(format);
 							ZE_ASSERT(dstSize == codec.GetOriginalSize(src, srcSize), "Uncompressed sizes don't match!");
 							codec.Decompress(src, srcSize, dst, dstSize);
 						},
-						req.SrcBuffer, Utils::SafeCast<U32>(req.SrcSize), req.DstBuffer, Utils::SafeCast<U32>(req.DstSize));
+						GetCodecFormat(req.CompressionFormat), req.SrcBuffer, Utils::SafeCast<U32>(req.SrcSize), req.DstBuffer, Utils::SafeCast<U32>(req.DstSize));
 					break;
 				}
 				ZE_WARNING_POP;
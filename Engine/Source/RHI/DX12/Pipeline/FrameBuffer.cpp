@@ -1,4 +1,5 @@
 #include "RHI/DX12/Pipeline/FrameBuffer.h"
+#include "GFX/Pipeline/MemoryAliasing.h"
 #include "Data/Camera.h"
 #include "GFX/FfxApiFunctions.h"
 #include "GFX/XeSSException.h"
@@ -68,7 +69,6 @@ namespace ZE::RHI::DX12::Pipeline
 	{
 		U32 heapChunks = 0;
 
-		// Other algorithm: https://stackoverflow.com/questions/25683078/algorithm-for-packing-time-slots
 		if (flags & GFX::Pipeline::FrameBufferFlag::NoMemoryAliasing)
 		{
 			// No resource aliasing so place all of the one after another
@@ -80,7 +80,7 @@ namespace ZE::RHI::DX12::Pipeline
 				heapChunks += resBegin->Chunks;
 			}
 		}
-		else
+		else if (flags & GFX::Pipeline::FrameBufferFlag::MatrixCreationAlgorithmDX12)
 		{
 			// Find free memory regions for resources
 			std::vector<RID> memory;
@@ -139,6 +139,32 @@ namespace ZE::RHI::DX12::Pipeline
 			}
 			heapChunks = Utils::SafeCast<U32>(memory.size() / levelCount);
 		}
+		else
+		{
+			std::vector<GFX::Pipeline::AliasingRegion> regions;
+			regions.reserve(std::distance(resBegin, resEnd));
+			for (auto it = resBegin; it != resEnd; ++it)
+			{
+				GFX::Pipeline::AliasingRegion& region = regions.emplace_back();
+				region.Chunks = it->Chunks;
+				region.ChunkAlignment = Utils::SafeCast<U32>(it->Desc.Alignment / minimalChunkSize);
+				// Temporal resources are kept between frames so they cannot share memory with anything else
+				if (it->IsTemporal())
+				{
+					region.StartLevel = 0;
+					region.EndLevel = levelCount;
+				}
+				else
+				{
+					region.StartLevel = resourcesLifetime.at(it->Handle).first;
+					region.EndLevel = resourcesLifetime.at(it->Handle).second;
+				}
+			}
+
+			heapChunks = GFX::Pipeline::PlanMemoryAliasing(regions.data(), Utils::SafeCast<U32>(regions.size()));
+			for (const auto& region : regions)
+				(resBegin++)->ChunkOffset = region.ChunkOffset;
+		}
 		return Utils::SafeCast<U64>(heapChunks) * minimalChunkSize;
 	}
 
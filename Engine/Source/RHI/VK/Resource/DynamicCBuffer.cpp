@@ -57,7 +57,7 @@ namespace ZE::RHI::VK::Resource
 		ZE_ASSERT(bytes <= BLOCK_SIZE, "Structure too large for dynamic buffer!");
 
 		const U32 newBlock = Math::AlignUp(bytes, Utils::SafeCast<U32>(dev.Get().vk.GetLimits().minUniformBufferOffsetAlignment));
-#ifndef _ZE_RENDER_GRAPH_SINGLE_THREAD
+#if !_ZE_RENDER_GRAPH_SINGLE_THREAD
 		const std::lock_guard<std::mutex> lock(allocLock);
 #endif
 		if (nextOffset + newBlock > BLOCK_SIZE)
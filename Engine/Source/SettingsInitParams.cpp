@@ -26,6 +26,7 @@ namespace ZE
 		parser.AddOption("noCulling");
 		parser.AddOption("splitRenderSubmissions");
 		parser.AddOption("ibl");
+		parser.AddOption("renderGraphTiming");
 	}
 
 	SettingsInitParams SettingsInitParams::GetParsedParams(const CmdParser& parser, const char* appName, U32 appVersion, U8 staticThreadsCount, GfxApiType defApi) noexcept
@@ -78,6 +79,8 @@ namespace ZE
 			params.Flags |= SettingsInitFlag::SplitRenderSubmissions;
 		if (parser.GetOption("ibl"))
 			params.Flags |= SettingsInitFlag::EnableIBL;
+		if (parser.GetOption("renderGraphTiming"))
+			params.Flags |= SettingsInitFlag::RenderGraphTiming;
 
 		return params;
 	}
@@ -0,0 +1,40 @@
+#pragma once
+#include "TestUtils.h"
+#include "Allocator/ChunkedTLSF.h"
+#include <vector>
+
+namespace ZE::Test
+{
+	// Fake memory identified only by id, counting currently existing chunks
+	struct FakeMemory
+	{
+		static inline UA32 idCounter = 0;
+		static inline UA32 liveChunks = 0;
+
+		U32 ID;
+
+		static void Init(FakeMemory& memory, Allocator::TLSFMemoryChunkFlags flags, U64 size, void* userData) noexcept { memory.ID = ++idCounter; ++liveChunks; }
+		static void Destroy(FakeMemory& memory, void* userData) noexcept { --liveChunks; }
+	};
+
+	// Allocation recorded for overlap checks
+	struct Range
+	{
+		U32 Allocator;
+		U32 Memory;
+		U64 Offset;
+		U64 Size;
+	};
+
+	// Number of blocks currently allocated in all chunks of the allocator
+	template<typename TLSF>
+	U32 GetAllocationCount(const TLSF& allocator) noexcept
+	{
+		std::vector<Allocator::TLSFChunkStats> stats;
+		allocator.GetChunkStats(stats);
+		U32 count = 0;
+		for (const auto& chunk : stats)
+			count += chunk.AllocationCount;
+		return count;
+	}
+}
\ No newline at end of file
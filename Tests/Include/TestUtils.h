@@ -0,0 +1,27 @@
+#pragma once
+#include "Timer.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Checks condition of the test, on failure prints it's location and exits with error code.
+// Contrary to ZE_ASSERT it's always enabled regardless of build mode
+#define ZE_CHECK(condition) do { if (!(condition)) { std::printf("%s(%d): Check failed: %s\n", __FILE__, __LINE__, #condition); std::fflush(stdout); std::exit(EXIT_FAILURE); } } while (false)
+
+namespace ZE::Test
+{
+	// Runs function given number of times and returns shortest time of single run in milliseconds
+	template<typename Func>
+	double Measure(U32 runs, Func&& func) noexcept
+	{
+		double best = 0.0;
+		for (U32 i = 0; i < runs; ++i)
+		{
+			Timer timer;
+			func();
+			const double time = static_cast<double>(timer.Peek()) * 1000.0;
+			if (i == 0 || time < best)
+				best = time;
+		}
+		return best;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "TestUtils.h"
+#include "IO/Compressor.h"
+#include <cmath>
+#include <random>
+
+using namespace ZE;
+
+constexpr U32 DATA_SIZE = 4 * 1024 * 1024;
+constexpr U32 COMPRESS_RUNS = 1;
+constexpr U32 DECOMPRESS_RUNS = 5;
+
+// Vertex layout of typical static mesh
+struct Vertex
+{
+	float Position[3];
+	float Normal[3];
+	float UV[2];
+};
+
+// Displaced grid mesh followed by it's index buffer
+static std::vector<U8> GenerateGeometry() noexcept
+{
+	constexpr U32 GRID_SIZE = 320;
+	std::vector<U8> data;
+	data.reserve(DATA_SIZE);
+	for (U32 y = 0; y < GRID_SIZE; ++y)
+	{
+		for (U32 x = 0; x < GRID_SIZE; ++x)
+		{
+			const float u = static_cast<float>(x) / GRID_SIZE;
+			const float v = static_cast<float>(y) / GRID_SIZE;
+			const float height = std::sin(u * 12.0f) * std::cos(v * 9.0f) * 0.3f;
+			const Vertex vertex = { { u * 10.0f, height, v * 10.0f }, { -height * 0.5f, 1.0f, height * 0.3f }, { u, v } };
+			data.insert(data.end(), reinterpret_cast<const U8*>(&vertex), reinterpret_cast<const U8*>(&vertex + 1));
+		}
+	}
+	for (U32 y = 0; y + 1 < GRID_SIZE && data.size() < DATA_SIZE; ++y)
+	{
+		for (U32 x = 0; x + 1 < GRID_SIZE; ++x)
+		{
+			const U32 i = y * GRID_SIZE + x;
+			const U32 indices[6] = { i, i + GRID_SIZE, i + 1, i + 1, i + GRID_SIZE, i + GRID_SIZE + 1 };
+			data.insert(data.end(), reinterpret_cast<const U8*>(indices), reinterpret_cast<const U8*>(indices + 6));
+		}
+	}
+	data.resize(DATA_SIZE);
+	return data;
+}
+
+// RGBA texture with smooth gradients, noise and flat regions
+static std::vector<U8> GenerateTexture() noexcept
+{
+	constexpr U32 WIDTH = 1024;
+	std::mt19937 engine(7);
+	std::vector<U8> data(DATA_SIZE);
+	for (U32 i = 0; i < DATA_SIZE / 4; ++i)
+	{
+		const U32 x = i % WIDTH;
+		const U32 y = i / WIDTH;
+		const bool flat = (x / 128 + y / 128) % 3 == 0;
+		const U8 noise = flat ? 0 : static_cast<U8>(engine() % 8);
+		data.at(i * 4) = static_cast<U8>(x / 4 + noise);
+		data.at(i * 4 + 1) = static_cast<U8>(y / 4 + noise);
+		data.at(i * 4 + 2) = flat ? 128 : static_cast<U8>((x + y) / 8 + noise);
+		data.at(i * 4 + 3) = 255;
+	}
+	return data;
+}
+
+static void BenchmarkData(const char* name, const std::vector<U8>& data) noexcept
+{
+	std::printf("%s data (%u MB)\n", name, DATA_SIZE / (1024 * 1024));
+	std::printf("Format | Ratio | Compression [MB/s] | Decompression [MB/s] | Load cost [ms]\n");
+
+	const double megabytes = static_cast<double>(data.size()) / (1024.0 * 1024.0);
+	std::vector<U8> decompressed(data.size());
+	for (IO::CompressionFormat format : { IO::CompressionFormat::ZLib, IO::CompressionFormat::Bzip2, IO::CompressionFormat::Lz4, IO::CompressionFormat::Lz4HC, IO::CompressionFormat::Zstd })
+	{
+		// Single stream is used so only speed of the codec itself is measured
+		IO::Compressor codec(format);
+		std::vector<U8> compressed;
+		const double compressTime = Test::Measure(COMPRESS_RUNS, [&]() { compressed = codec.Compress(data.data(), DATA_SIZE, false); });
+		const double decompressTime = Test::Measure(DECOMPRESS_RUNS, [&]()
+			{
+				codec.Decompress(compressed.data(), Utils::SafeCast<U32>(compressed.size()), decompressed.data(), DATA_SIZE);
+			});
+		ZE_CHECK(decompressed == data);
+
+		std::printf("%6s | %5.2f | %18.1f | %20.1f | %14.3f\n", IO::GetCompressionFormatString(format),
+			static_cast<double>(data.size()) / static_cast<double>(compressed.size()),
+			megabytes / (compressTime / 1000.0), megabytes / (decompressTime / 1000.0),
+			static_cast<double>(IO::Compressor::GetLoadCost(format, compressed.size(), data.size())) / 1000000.0);
+	}
+}
+
+int main()
+{
+	BenchmarkData("Geometry", GenerateGeometry());
+	BenchmarkData("Texture", GenerateTexture());
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "TestUtils.h"
+#include "Allocator/ConcurrentTLSF.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace ZE;
+
+constexpr U32 OPERATION_COUNT = 200000;
+constexpr U32 MAX_LIVE = 64;
+constexpr U32 GRANULARITY = 256;
+constexpr U32 RUNS = 5;
+
+// Memory chunks are not backed by anything, only bookkeeping of allocators is measured
+struct FakeMemory
+{
+	static void Init(FakeMemory& memory, Allocator::TLSFMemoryChunkFlags flags, U64 size, void* userData) noexcept {}
+	static void Destroy(FakeMemory& memory, void* userData) noexcept {}
+};
+
+// Previous way of sharing allocator between threads with single lock around every operation
+class LockedTLSF final
+{
+public:
+	typedef Allocator::ChunkedTLSF<FakeMemory, 4, 2> Core;
+
+private:
+	std::mutex& mutex;
+	Core core;
+
+public:
+	LockedTLSF(Core::BlockAllocator& blockAllocator, Core::ChunkAllocator& chunkAllocator, std::mutex& mutex) noexcept
+		: mutex(mutex), core(blockAllocator, chunkAllocator) {}
+	ZE_CLASS_DELETE(LockedTLSF);
+	~LockedTLSF() = default;
+
+	void Init(U64 initialChunkSize, U32 granularity) { core.Init(0, initialChunkSize, granularity, 3); }
+	AllocHandle Alloc(U64 size, U64 alignment) { std::lock_guard<std::mutex> lock(mutex); return core.Alloc(size, alignment, nullptr); }
+	void Free(AllocHandle alloc) noexcept { std::lock_guard<std::mutex> lock(mutex); core.Free(alloc, nullptr); }
+	void DestroyFreeChunks() noexcept { std::lock_guard<std::mutex> lock(mutex); core.DestroyFreeChunks(nullptr); }
+};
+
+class CachedTLSF final
+{
+public:
+	typedef Allocator::ConcurrentTLSF<FakeMemory, 4, 2> Core;
+
+private:
+	Core core;
+
+public:
+	CachedTLSF(Core::BlockAllocator& blockAllocator, Core::ChunkAllocator& chunkAllocator, std::mutex& mutex) noexcept
+		: core(blockAllocator, chunkAllocator, mutex) {}
+	ZE_CLASS_DELETE(CachedTLSF);
+	~CachedTLSF() = default;
+
+	void Init(U64 initialChunkSize, U32 granularity) { core.Init(0, initialChunkSize, granularity, 3); }
+	AllocHandle Alloc(U64 size, U64 alignment) { return core.Alloc(size, alignment, nullptr); }
+	void Free(AllocHandle alloc) noexcept { core.Free(alloc, nullptr); }
+	void DestroyFreeChunks() noexcept { core.DestroyFreeChunks(nullptr); }
+};
+
+// Every thread performs random sequence of allocations and frees of small resources (up to 16KB) as done by streaming,
+// returns number of millions of operations per second
+template<typename TLSF>
+double BenchmarkThroughput(U32 threadCount) noexcept
+{
+	typename TLSF::Core::BlockAllocator blockAllocator(1024);
+	typename TLSF::Core::ChunkAllocator chunkAllocator(32);
+	std::mutex mutex;
+	TLSF allocator(blockAllocator, chunkAllocator, mutex);
+	allocator.Init(256ULL << 20, GRANULARITY);
+
+	const double time = Test::Measure(RUNS, [&]()
+		{
+			std::vector<std::thread> threads;
+			for (U32 t = 0; t < threadCount; ++t)
+			{
+				threads.emplace_back([&allocator, t]()
+					{
+						std::mt19937 engine(t);
+						std::vector<AllocHandle> live;
+						live.reserve(MAX_LIVE);
+						for (U32 i = 0; i < OPERATION_COUNT; ++i)
+						{
+							if (live.size() < MAX_LIVE && (live.empty() || engine() % 2))
+								live.emplace_back(allocator.Alloc(engine() % (16 * 1024) + 1, 1));
+							else
+							{
+								const U64 index = engine() % live.size();
+								allocator.Free(live.at(index));
+								live.at(index) = live.back();
+								live.pop_back();
+							}
+						}
+						for (AllocHandle alloc : live)
+							allocator.Free(alloc);
+					});
+			}
+			for (std::thread& thread : threads)
+				thread.join();
+		});
+	allocator.DestroyFreeChunks();
+	return static_cast<double>(threadCount) * OPERATION_COUNT / (time * 1000.0);
+}
+
+int main()
+{
+	const U32 maxThreads = std::max(std::thread::hardware_concurrency(), 4U);
+	std::printf("TLSF with %u operations per thread\n", OPERATION_COUNT);
+	std::printf("Threads | Thread caches [Mops/s] | Single lock [Mops/s] | Speedup\n");
+	for (U32 threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		const double cached = BenchmarkThroughput<CachedTLSF>(threads);
+		const double locked = BenchmarkThroughput<LockedTLSF>(threads);
+		std::printf("%7u | %22.2f | %20.2f | %7.2f\n", threads, cached, locked, cached / locked);
+	}
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
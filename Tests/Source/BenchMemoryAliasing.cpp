@@ -0,0 +1,107 @@
+#include "TestUtils.h"
+#include "GFX/Pipeline/MemoryAliasing.h"
+#include <algorithm>
+#include <random>
+
+using namespace ZE;
+using namespace ZE::GFX::Pipeline;
+
+constexpr U32 LAYOUT_COUNT = 200;
+constexpr U32 RUNS = 10;
+
+// Previous algorithm used by DX12 frame buffer (MatrixCreationAlgorithmDX12), searching
+// whole memory for free chunks with grid of every chunk and pass level. Returns required memory size in chunks
+static U32 PlanMemoryAliasingGrid(AliasingRegion* regions, U32 count, U32 levelCount) noexcept
+{
+	std::vector<U32> memory;
+	U32 allocatedChunks = 0;
+	for (U32 i = 0; i < count; ++i)
+	{
+		AliasingRegion& region = regions[i];
+		const U32 chunkAlignment = region.ChunkAlignment;
+
+		U32 foundOffset = UINT32_MAX, chunksFound = 0;
+		for (U32 offset = 0; offset < allocatedChunks; offset = Math::AlignUp(++offset, chunkAlignment))
+		{
+			if (foundOffset == UINT32_MAX)
+				foundOffset = offset;
+			for (U32 time = region.StartLevel; time < region.EndLevel; ++time)
+			{
+				if (memory.at(offset * levelCount + time) != UINT32_MAX)
+				{
+					foundOffset = UINT32_MAX;
+					break;
+				}
+			}
+			if (foundOffset != UINT32_MAX)
+			{
+				if (++chunksFound == region.Chunks)
+					break;
+			}
+			else
+			{
+				chunksFound = 0;
+				foundOffset = UINT32_MAX;
+			}
+		}
+
+		if (foundOffset == UINT32_MAX || chunksFound != region.Chunks)
+		{
+			foundOffset = Math::AlignUp(allocatedChunks, chunkAlignment);
+			allocatedChunks = foundOffset + region.Chunks;
+			memory.resize(static_cast<U64>(allocatedChunks) * levelCount, UINT32_MAX);
+		}
+		for (U32 chunk = 0; chunk < region.Chunks; ++chunk)
+			std::fill_n(memory.begin() + static_cast<U64>(foundOffset + chunk) * levelCount + region.StartLevel, region.EndLevel - region.StartLevel, i);
+		region.ChunkOffset = foundOffset;
+	}
+	return allocatedChunks;
+}
+
+int main()
+{
+	// Random layouts of frame buffers, regions sorted descending by size as done by frame buffers
+	std::mt19937 engine(7);
+	std::vector<std::pair<U32, std::vector<AliasingRegion>>> layouts(LAYOUT_COUNT);
+	for (auto& [levels, regions] : layouts)
+	{
+		levels = 4 + engine() % 40;
+		regions.resize(5 + engine() % 80);
+		for (AliasingRegion& region : regions)
+		{
+			region.Chunks = 1 + engine() % (engine() % 4 ? 200 : 2000);
+			region.ChunkAlignment = engine() % 5 == 0 ? 64 : 1;
+			region.StartLevel = engine() % levels;
+			region.EndLevel = region.StartLevel + 1 + engine() % (levels - region.StartLevel);
+		}
+		std::sort(regions.begin(), regions.end(), [](const AliasingRegion& r1, const AliasingRegion& r2) { return r1.Chunks > r2.Chunks; });
+	}
+
+	U64 gridChunks = 0, plannerChunks = 0;
+	std::vector<AliasingRegion> regions;
+	const double gridTime = Test::Measure(RUNS, [&]()
+		{
+			gridChunks = 0;
+			for (const auto& [levels, layout] : layouts)
+			{
+				regions = layout;
+				gridChunks += PlanMemoryAliasingGrid(regions.data(), Utils::SafeCast<U32>(regions.size()), levels);
+			}
+		});
+	const double plannerTime = Test::Measure(RUNS, [&]()
+		{
+			plannerChunks = 0;
+			for (const auto& [levels, layout] : layouts)
+			{
+				regions = layout;
+				plannerChunks += PlanMemoryAliasing(regions.data(), Utils::SafeCast<U32>(regions.size()));
+			}
+		});
+
+	std::printf("Aliasing of %u random frame buffer layouts\n", LAYOUT_COUNT);
+	std::printf("Algorithm   | Total heap size [chunks] | Planning time [ms]\n");
+	std::printf("Grid search | %24llu | %18.3f\n", static_cast<unsigned long long>(gridChunks), gridTime);
+	std::printf("Best-fit    | %24llu | %18.3f\n", static_cast<unsigned long long>(plannerChunks), plannerTime);
+	std::printf("Heap size change: %.2f%%, speedup: %.1fx\n", (static_cast<double>(plannerChunks) / static_cast<double>(gridChunks) - 1.0) * 100.0, gridTime / plannerTime);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+#include "TestUtils.h"
+#include "MipFilter.h"
+#include <cmath>
+#include <random>
+
+using namespace ZE;
+
+constexpr U32 SOURCE_BAND_ROWS = 256;
+constexpr U32 REFERENCE_ROWS = 32;
+constexpr U32 RUNS = 3;
+
+// Only rows of single band are stored and repeated over whole image to keep memory usage low, cost of filtering doesn't depend on the content
+struct Image
+{
+	U32 Width;
+	U32 Height;
+	std::vector<Float4> Rows;
+
+	const Float4* GetRow(U32 y) const noexcept { return Rows.data() + static_cast<U64>(y % SOURCE_BAND_ROWS) * Width; }
+};
+
+static Image GenerateImage(U32 size) noexcept
+{
+	std::mt19937 engine(5);
+	std::uniform_real_distribution<float> noise(0.0f, 0.1f);
+	Image image = { size, size };
+	image.Rows.reserve(static_cast<U64>(size) * SOURCE_BAND_ROWS);
+	for (U32 y = 0; y < SOURCE_BAND_ROWS; ++y)
+	{
+		for (U32 x = 0; x < size; ++x)
+		{
+			const float u = static_cast<float>(x) / static_cast<float>(size);
+			const float v = static_cast<float>(y) / static_cast<float>(SOURCE_BAND_ROWS);
+			image.Rows.emplace_back(u + noise(engine), v + noise(engine), std::sin(u * 40.0f) * 0.5f + 0.5f, 1.0f);
+		}
+	}
+	return image;
+}
+
+// Same passes as MipGen performs for separable filters, output holds either all generated rows or only the last one
+static void FilterSeparable(const Image& source, const std::vector<float>& taps, U32 windowSize, U32 rowCount, bool keepRows, std::vector<Float4>& output) noexcept
+{
+	const U32 mipWidth = source.Width / 2;
+	const S32 halfWindow = Utils::SafeCast<S32>(windowSize) >> 1;
+
+	std::vector<U32> columnOffsets(static_cast<U64>(mipWidth) * windowSize);
+	for (U32 x = 0, i = 0; x < mipWidth; ++x)
+	{
+		const S32 baseX = Utils::SafeCast<S32>(x * 2) + 1;
+		for (S32 j = -halfWindow - Utils::SafeCast<S32>(windowSize & 1); j < halfWindow; ++j, ++i)
+			columnOffsets.at(i) = Math::MirrorCoord(baseX + j, Utils::SafeCast<S32>(source.Width));
+	}
+	std::vector<Float4> filteredRows(static_cast<U64>(mipWidth) * windowSize);
+	std::vector<U32> filteredRowIndices(windowSize, UINT32_MAX);
+	output.resize(static_cast<U64>(mipWidth) * (keepRows ? rowCount : 1));
+
+	for (U32 y = 0; y < rowCount; ++y)
+	{
+		Float4* mipRow = output.data() + (keepRows ? static_cast<U64>(y) * mipWidth : 0);
+		std::fill(mipRow, mipRow + mipWidth, Float4(0.0f, 0.0f, 0.0f, 0.0f));
+
+		const S32 baseY = Utils::SafeCast<S32>(y * 2) + 1;
+		for (S32 i = -halfWindow - Utils::SafeCast<S32>(windowSize & 1), tap = 0; i < halfWindow; ++i, ++tap)
+		{
+			const U32 row = Math::MirrorCoord(baseY + i, Utils::SafeCast<S32>(source.Height));
+			const U32 slot = row % windowSize;
+			Float4* filteredRow = filteredRows.data() + static_cast<U64>(slot) * mipWidth;
+			if (filteredRowIndices.at(slot) != row)
+			{
+				filteredRowIndices.at(slot) = row;
+				MipFilter::FilterRow(source.GetRow(row), filteredRow, columnOffsets.data(), taps.data(), windowSize, mipWidth);
+			}
+			MipFilter::AccumulateRow(filteredRow, mipRow, taps.at(tap), mipWidth);
+		}
+	}
+}
+
+// Previous way of filtering every output pixel separately over whole window of samples
+static void FilterReference(const Image& source, Math::FilterType filter, const std::vector<float>& coeffs, U32 windowSize, U32 rowCount, std::vector<Float4>& output) noexcept
+{
+	const U32 mipWidth = source.Width / 2;
+	const S32 halfWindow = Utils::SafeCast<S32>(windowSize) >> 1;
+	output.resize(static_cast<U64>(mipWidth) * rowCount);
+
+	for (U32 y = 0; y < rowCount; ++y)
+	{
+		std::vector<U32> rowOffsets;
+		rowOffsets.reserve(windowSize);
+		const S32 baseY = Utils::SafeCast<S32>(y * 2) + 1;
+		for (S32 i = -halfWindow - Utils::SafeCast<S32>(windowSize & 1); i < halfWindow; ++i)
+			rowOffsets.emplace_back(Math::MirrorCoord(baseY + i, Utils::SafeCast<S32>(source.Height)));
+
+		for (U32 x = 0; x < mipWidth; ++x)
+		{
+			std::vector<U32> columnOffsets;
+			columnOffsets.reserve(windowSize);
+			const S32 baseX = Utils::SafeCast<S32>(x * 2) + 1;
+			for (S32 i = -halfWindow - Utils::SafeCast<S32>(windowSize & 1); i < halfWindow; ++i)
+				columnOffsets.emplace_back(Math::MirrorCoord(baseX + i, Utils::SafeCast<S32>(source.Width)));
+
+			std::vector<Float4> samples;
+			samples.reserve(static_cast<U64>(windowSize) * windowSize);
+			for (U32 rowOffset : rowOffsets)
+				for (U32 colOffset : columnOffsets)
+					samples.emplace_back(source.GetRow(rowOffset)[colOffset]);
+
+			Math::XMStoreFloat4(&output.at(static_cast<U64>(y) * mipWidth + x), Math::ApplyFilter(filter, samples, 0.5f, 0.5f, &coeffs));
+		}
+	}
+}
+
+static const char* GetFilterName(Math::FilterType filter) noexcept
+{
+	switch (filter)
+	{
+	case Math::FilterType::Kaiser:
+		return "Kaiser";
+	case Math::FilterType::Lanczos:
+		return "Lanczos";
+	case Math::FilterType::Gauss:
+		return "Gauss";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+int main()
+{
+	std::vector<Float4> output, reference;
+	for (U32 size : { 4096U, 8192U })
+	{
+		const Image source = GenerateImage(size);
+		const U32 mipHeight = size / 2;
+
+		// Previous filtering is too slow to run on whole mip so it's time is extrapolated from first rows
+		std::printf("Single mip from %ux%u float image, non-separable filtering measured on %u rows\n", size, size, REFERENCE_ROWS);
+		std::printf(" Filter | Window | Separable [ms] | Non-separable [ms] | Speedup\n");
+		for (Math::FilterType filter : { Math::FilterType::Kaiser, Math::FilterType::Lanczos, Math::FilterType::Gauss })
+		{
+			for (U32 windowSize : { 4U, 8U })
+			{
+				float coeffParam = 0.0f;
+				const std::vector<float> coeffs = MipFilter::GetCoeffs(filter, windowSize, coeffParam);
+				const std::vector<float> taps = MipFilter::GetTaps(coeffs, windowSize);
+
+				const double separable = Test::Measure(RUNS, [&]() { FilterSeparable(source, taps, windowSize, mipHeight, false, output); });
+				const double nonSeparable = Test::Measure(RUNS, [&]() { FilterReference(source, filter, coeffs, windowSize, REFERENCE_ROWS, reference); })
+					* static_cast<double>(mipHeight / REFERENCE_ROWS);
+
+				// Summation order is the same in both ways so results can only differ by rounding
+				FilterSeparable(source, taps, windowSize, REFERENCE_ROWS, true, output);
+				for (U64 i = 0; i < reference.size(); ++i)
+				{
+					ZE_CHECK(std::abs(output.at(i).x - reference.at(i).x) < 1e-4f);
+					ZE_CHECK(std::abs(output.at(i).y - reference.at(i).y) < 1e-4f);
+					ZE_CHECK(std::abs(output.at(i).z - reference.at(i).z) < 1e-4f);
+					ZE_CHECK(std::abs(output.at(i).w - reference.at(i).w) < 1e-4f);
+				}
+
+				std::printf("%7s | %6u | %14.1f | %18.1f | %7.2f\n", GetFilterName(filter), windowSize, separable, nonSeparable, nonSeparable / separable);
+			}
+		}
+	}
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
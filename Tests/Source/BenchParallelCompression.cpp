@@ -0,0 +1,58 @@
+#include "TestUtils.h"
+#include "IO/Compressor.h"
+#include "StartupConfig.h"
+#include <random>
+
+using namespace ZE;
+
+constexpr U32 DATA_SIZE = 16 * 1024 * 1024;
+constexpr U32 COMPRESS_RUNS = 1;
+constexpr U32 DECOMPRESS_RUNS = 5;
+
+// Mix of smooth and noisy regions so every block has similar cost
+static std::vector<U8> GenerateData() noexcept
+{
+	std::mt19937 engine(3);
+	std::vector<U8> data(DATA_SIZE);
+	for (U32 i = 0; i < DATA_SIZE; ++i)
+		data.at(i) = (i / 4096) % 4 == 0 ? static_cast<U8>(engine() % 16 + i / 64) : static_cast<U8>(i / 256);
+	return data;
+}
+
+int main()
+{
+	SettingsInitParams params = {};
+	params.GraphicsAPI = _ZE_RHI_DX12 ? GfxApiType::DX12 : GfxApiType::Vulkan;
+	params.BackbufferCount = 2;
+	StartupConfig config(params);
+
+	const std::vector<U8> data = GenerateData();
+	const double megabytes = static_cast<double>(DATA_SIZE) / (1024.0 * 1024.0);
+	std::vector<U8> decompressed(DATA_SIZE);
+
+	std::printf("Chunked streams of %u KB blocks, %u MB data, %u worker threads\n", IO::Compressor::BLOCK_SIZE / 1024, DATA_SIZE / (1024 * 1024), Settings::GetThreadPool().GetWorkerThreadsCount());
+	std::printf("Format | Compression single/chunked [MB/s] | Speedup | Decompression single/chunked [MB/s] | Speedup\n");
+	for (IO::CompressionFormat format : { IO::CompressionFormat::ZLib, IO::CompressionFormat::Lz4, IO::CompressionFormat::Lz4HC, IO::CompressionFormat::Zstd })
+	{
+		IO::Compressor codec(format);
+		std::vector<U8> single, chunked;
+		const double singleCompress = Test::Measure(COMPRESS_RUNS, [&]() { single = codec.Compress(data.data(), DATA_SIZE, false); });
+		const double chunkedCompress = Test::Measure(COMPRESS_RUNS, [&]() { chunked = codec.Compress(data.data(), DATA_SIZE, true); });
+
+		const double singleDecompress = Test::Measure(DECOMPRESS_RUNS, [&]()
+			{
+				codec.Decompress(single.data(), Utils::SafeCast<U32>(single.size()), decompressed.data(), DATA_SIZE);
+			});
+		ZE_CHECK(decompressed == data);
+		const double chunkedDecompress = Test::Measure(DECOMPRESS_RUNS, [&]()
+			{
+				codec.Decompress(chunked.data(), Utils::SafeCast<U32>(chunked.size()), decompressed.data(), DATA_SIZE);
+			});
+		ZE_CHECK(decompressed == data);
+
+		std::printf("%6s | %16.1f / %15.1f | %7.2f | %18.1f / %15.1f | %7.2f\n", IO::GetCompressionFormatString(format),
+			megabytes / (singleCompress / 1000.0), megabytes / (chunkedCompress / 1000.0), singleCompress / chunkedCompress,
+			megabytes / (singleDecompress / 1000.0), megabytes / (chunkedDecompress / 1000.0), singleDecompress / chunkedDecompress);
+	}
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
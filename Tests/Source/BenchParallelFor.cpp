@@ -0,0 +1,96 @@
+#include "TestUtils.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <random>
+#include <ranges>
+
+using namespace ZE;
+
+// Simplified data of single entity as used during visibility split of shadow casters
+struct Entity
+{
+	float Model[12];
+	float Center[3];
+	float Extents[3];
+	bool Transparent;
+};
+
+constexpr U32 ENTITY_COUNT = 100000;
+constexpr U32 RUNS = 20;
+
+// Transforms bounding box into world space and checks it against light volume, returns 0 when not visible, 1 for solid, 2 for transparent
+static U8 SplitEntity(const Entity& e, const float* lightPos, float lightRadius) noexcept
+{
+	float center[3], extents[3];
+	for (U8 i = 0; i < 3; ++i)
+	{
+		const float* row = e.Model + i * 4;
+		center[i] = row[0] * e.Center[0] + row[1] * e.Center[1] + row[2] * e.Center[2] + row[3];
+		extents[i] = std::abs(row[0]) * e.Extents[0] + std::abs(row[1]) * e.Extents[1] + std::abs(row[2]) * e.Extents[2];
+	}
+
+	float distance = 0.0f;
+	for (U8 i = 0; i < 3; ++i)
+	{
+		const float delta = std::max(std::abs(lightPos[i] - center[i]) - extents[i], 0.0f);
+		distance += delta * delta;
+	}
+	if (distance > lightRadius * lightRadius)
+		return 0;
+	return e.Transparent ? 2 : 1;
+}
+
+int main()
+{
+	std::mt19937 engine(0);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+	std::vector<Entity> entities(ENTITY_COUNT);
+	for (Entity& e : entities)
+	{
+		e = {};
+		e.Model[0] = scale(engine);
+		e.Model[5] = scale(engine);
+		e.Model[10] = scale(engine);
+		e.Model[3] = position(engine);
+		e.Model[7] = position(engine);
+		e.Model[11] = position(engine);
+		e.Extents[0] = e.Extents[1] = e.Extents[2] = 1.0f;
+		e.Transparent = (engine() & 7) == 0;
+	}
+	const float lightPos[3] = { 0.0f, 0.0f, 0.0f };
+	std::vector<U8> split(ENTITY_COUNT);
+
+	std::printf("Visibility split of %u entities\n", ENTITY_COUNT);
+	std::printf("Threads | ParallelFor [ms] | Speedup | ParallelReduce [ms] | Speedup\n");
+	const U32 maxThreads = std::clamp(std::thread::hardware_concurrency(), 1U, static_cast<U32>(UINT8_MAX));
+	double baseFor = 0.0, baseReduce = 0.0;
+	for (U32 threads = 1; threads <= maxThreads; threads = threads == maxThreads ? threads + 1 : std::min(threads * 2, maxThreads))
+	{
+		// Calling thread takes part in processing so one less worker is needed
+		ThreadPool pool;
+		pool.Init(0, threads == 1 ? UINT8_MAX : Utils::SafeCast<U8>(threads - 1));
+
+		const double timeFor = Test::Measure(RUNS, [&]()
+			{
+				pool.ParallelFor(std::views::iota(0U, ENTITY_COUNT), 0, [&](U32 i) { split[i] = SplitEntity(entities[i], lightPos, 300.0f); });
+			});
+		U64 visible = 0;
+		const double timeReduce = Test::Measure(RUNS, [&]()
+			{
+				visible = pool.ParallelReduce(entities, 0, static_cast<U64>(0),
+					[&](U64& count, const Entity& e) { count += SplitEntity(e, lightPos, 300.0f) != 0; },
+					[](U64& count, U64 partial) { count += partial; });
+			});
+		ZE_CHECK(visible == ENTITY_COUNT - static_cast<U64>(std::count(split.begin(), split.end(), 0)));
+
+		if (threads == 1)
+		{
+			baseFor = timeFor;
+			baseReduce = timeReduce;
+		}
+		std::printf("%7u | %16.3f | %7.2f | %19.3f | %7.2f\n", threads, timeFor, baseFor / timeFor, timeReduce, baseReduce / timeReduce);
+		pool.Stop();
+	}
+	return EXIT_SUCCESS;
+}
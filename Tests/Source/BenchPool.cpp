@@ -0,0 +1,232 @@
+#include "TestUtils.h"
+#include "Allocator/Pool.h"
+#include <algorithm>
+#include <random>
+
+using namespace ZE;
+
+constexpr U32 OPERATION_COUNT = 1000000;
+constexpr U32 RUNS = 5;
+
+namespace
+{
+	// Previous implementation of the pool searching linearly through growing blocks on every allocation and free
+	template<typename T>
+	class PoolReference final
+	{
+		union Item
+		{
+			// UINT64_MAX means end of list
+			U64 NextFreeIndex;
+			alignas(T) U8 Data[sizeof(T)];
+		};
+		struct ItemBlock
+		{
+			std::unique_ptr<Item[]> Items;
+			U64 Capacity;
+			U64 FirstFreeIndex;
+			U64 Allocated;
+		};
+
+		const U64 firstBlockCapacity;
+		bool freeBlock = false;
+		std::vector<ItemBlock> itemBlocks;
+
+		ItemBlock& CreateNewBlock() noexcept;
+
+	public:
+		PoolReference(U64 firstBlockCapacity) noexcept : firstBlockCapacity(firstBlockCapacity) {}
+		ZE_CLASS_DELETE(PoolReference);
+		~PoolReference() { Clear(); }
+
+		template<typename... Types>
+		T* Alloc(Types&&... args) noexcept;
+		void Free(T* ptr) noexcept;
+		// Use fast clears with POD that don't need invocation of destructor
+		void Clear(bool fastClear = false) noexcept;
+	};
+
+	template<typename T>
+	typename PoolReference<T>::ItemBlock& PoolReference<T>::CreateNewBlock() noexcept
+	{
+		U64 newBlockCapacity = itemBlocks.size() ? itemBlocks.back().Capacity * 3 / 2 : firstBlockCapacity;
+		ItemBlock& newBlock = itemBlocks.emplace_back(std::make_unique<Item[]>(newBlockCapacity), newBlockCapacity, 0, 0);
+		--newBlockCapacity;
+
+		// Setup singly-linked list of all free items in this block
+		for (U64 i = 0; i < newBlockCapacity; ++i)
+			newBlock.Items[i].NextFreeIndex = i + 1;
+
+		newBlock.Items[newBlockCapacity].NextFreeIndex = UINT64_MAX;
+		freeBlock = false;
+		return newBlock;
+	}
+
+	template<typename T> template<typename... Types>
+	T* PoolReference<T>::Alloc(Types&&... args) noexcept
+	{
+		for (U64 i = itemBlocks.size(); i;)
+		{
+			ItemBlock& block = itemBlocks.at(--i);
+
+			// This block has some free items, use first one
+			if (block.FirstFreeIndex != UINT64_MAX)
+			{
+				ZE_ASSERT(block.FirstFreeIndex < block.Capacity, "Incorrect index!");
+				ZE_ASSERT(block.Allocated < block.Capacity, "Block is already full!");
+				if (block.Allocated++ == 0)
+					freeBlock = false;
+
+				Item* item = &block.Items[block.FirstFreeIndex];
+				block.FirstFreeIndex = item->NextFreeIndex;
+
+				T* result = reinterpret_cast<T*>(&item->Data);
+				new(result) T(std::forward<Types>(args)...);
+				return result;
+			}
+		}
+
+		// No block has free item, create new one
+		ItemBlock& newBlock = CreateNewBlock();
+		Item* item = &newBlock.Items[0];
+		newBlock.FirstFreeIndex = item->NextFreeIndex;
+		++newBlock.Allocated;
+
+		T* result = reinterpret_cast<T*>(&item->Data);
+		new(result) T(std::forward<Types>(args)...);
+		return result;
+	}
+
+	template<typename T>
+	void PoolReference<T>::Free(T* ptr) noexcept
+	{
+		ZE_ASSERT(ptr, "Invalid pointer!");
+
+		Item* item = reinterpret_cast<Item*>(ptr);
+		// Search all memory blocks to find ptr
+		for (U64 i = itemBlocks.size(); i;)
+		{
+			ItemBlock& block = itemBlocks.at(--i);
+
+			// Check if item is in address range of this block
+			if (item >= block.Items.get() && item < block.Items.get() + block.Capacity)
+			{
+				ptr->~T();
+
+				item->NextFreeIndex = block.FirstFreeIndex;
+				block.FirstFreeIndex = static_cast<U64>(item - block.Items.get());
+
+				ZE_ASSERT(block.Allocated > 0, "Trying to dealocate on empty list!");
+				if (--block.Allocated == 0)
+				{
+					if (freeBlock)
+						itemBlocks.erase(itemBlocks.begin() + i, itemBlocks.begin() + i + 1);
+					else
+						freeBlock = true;
+				}
+				return;
+			}
+		}
+		ZE_FAIL("Pointer doesn't belong to this memory pool!");
+	}
+
+	template<typename T>
+	void PoolReference<T>::Clear(bool fastClear) noexcept
+	{
+		if (!fastClear)
+		{
+			for (auto& block : itemBlocks)
+			{
+				// No need to gather free elements
+				if (block.FirstFreeIndex == UINT64_MAX)
+				{
+					for (U64 i = 0; i < block.Capacity; ++i)
+						reinterpret_cast<T*>(block.Items[i].Data)->~T();
+				}
+				else
+				{
+					// Traverse free list to know which element to delete
+					std::vector<bool> isInUse(block.Capacity, true);
+					do
+					{
+						ZE_ASSERT(block.FirstFreeIndex < block.Capacity, "Incorrect index!");
+
+						isInUse.at(block.FirstFreeIndex) = false;
+						block.FirstFreeIndex = block.Items[block.FirstFreeIndex].NextFreeIndex;
+					} while (block.FirstFreeIndex != UINT64_MAX);
+
+					// Delete remaining elements
+					for (U64 i = 0; i < block.Capacity; ++i)
+						if (isInUse.at(i))
+							reinterpret_cast<T*>(block.Items[i].Data)->~T();
+				}
+			}
+		}
+		itemBlocks.clear();
+	}
+}
+
+// Object of typical size stored in pools
+struct Item
+{
+	U64 Data[6];
+};
+
+// Performs random sequence of allocations and frees (2 to 1 ratio) and frees remaining items at the end
+template<typename PoolType>
+double BenchmarkMixed() noexcept
+{
+	std::vector<Item*> items;
+	items.reserve(OPERATION_COUNT);
+	return Test::Measure(RUNS, [&]()
+		{
+			PoolType pool(1024);
+			std::mt19937 engine(1);
+			for (U32 i = 0; i < OPERATION_COUNT; ++i)
+			{
+				if (items.empty() || engine() % 3)
+					items.emplace_back(pool.Alloc());
+				else
+				{
+					const U64 index = engine() % items.size();
+					pool.Free(items.at(index));
+					items.at(index) = items.back();
+					items.pop_back();
+				}
+			}
+			for (Item* item : items)
+				pool.Free(item);
+			items.clear();
+		});
+}
+
+// Allocates all items first, then frees them in random order
+template<typename PoolType>
+double BenchmarkBulk() noexcept
+{
+	std::vector<Item*> items;
+	items.reserve(OPERATION_COUNT);
+	return Test::Measure(RUNS, [&]()
+		{
+			PoolType pool(1024);
+			for (U32 i = 0; i < OPERATION_COUNT; ++i)
+				items.emplace_back(pool.Alloc());
+			std::shuffle(items.begin(), items.end(), std::mt19937(1));
+			for (Item* item : items)
+				pool.Free(item);
+			items.clear();
+		});
+}
+
+int main()
+{
+	std::printf("Pool with %u operations\n", OPERATION_COUNT);
+	std::printf("Scenario            | Slab pool [ms] | Previous pool [ms] | Speedup\n");
+	const double slabMixed = BenchmarkMixed<Allocator::Pool<Item>>();
+	const double referenceMixed = BenchmarkMixed<PoolReference<Item>>();
+	std::printf("Mixed alloc/free    | %14.3f | %18.3f | %7.1f\n", slabMixed, referenceMixed, referenceMixed / slabMixed);
+	const double slabBulk = BenchmarkBulk<Allocator::Pool<Item>>();
+	const double referenceBulk = BenchmarkBulk<PoolReference<Item>>();
+	std::printf("Alloc all, free all | %14.3f | %18.3f | %7.1f\n", slabBulk, referenceBulk, referenceBulk / slabBulk);
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "TestTLSF.h"
+#include "Allocator/ChunkedTLSF.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <tuple>
+
+using namespace ZE;
+using namespace ZE::Test;
+
+typedef Allocator::ChunkedTLSF<FakeMemory, 4, 2> TLSF;
+
+constexpr U64 CHUNK_SIZE = 1024;
+
+int main()
+{
+	TLSF::BlockAllocator blockAllocator(64);
+	TLSF::ChunkAllocator chunkAllocator(8);
+	std::vector<Allocator::TLSFChunkStats> stats;
+
+	// Chunks emptied by freeing their last block are kept once and released afterwards
+	{
+		TLSF allocator(blockAllocator, chunkAllocator);
+		allocator.Init(0, CHUNK_SIZE, 1, 3);
+
+		std::array<AllocHandle, 5> allocs;
+		for (AllocHandle& alloc : allocs)
+			alloc = allocator.Alloc(CHUNK_SIZE / 2, 1, nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 3);
+
+		allocator.Free(allocs.at(0), nullptr);
+		allocator.Free(allocs.at(1), nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 3);
+		allocator.Free(allocs.at(2), nullptr);
+		allocator.Free(allocs.at(3), nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 2);
+		allocator.GetChunkStats(stats);
+		ZE_CHECK(stats.size() == 2);
+		ZE_CHECK(stats.front().FreeSize == CHUNK_SIZE);
+
+		// Kept chunk is reused before creating new one
+		AllocHandle whole = allocator.Alloc(CHUNK_SIZE, 1, nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 2);
+
+		allocator.Free(whole, nullptr);
+		allocator.Free(allocs.at(4), nullptr);
+		allocator.DestroyFreeChunks(nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 0);
+	}
+
+	// Defragmentation frees sources in ascending order, so source chunk is emptied by its last block
+	{
+		TLSF allocator(blockAllocator, chunkAllocator);
+		allocator.Init(0, CHUNK_SIZE, 1, 3);
+
+		AllocHandle whole = allocator.Alloc(CHUNK_SIZE, 1, nullptr);
+		std::array<AllocHandle, 4> dense, sparse;
+		for (AllocHandle& alloc : dense)
+			alloc = allocator.Alloc(CHUNK_SIZE / 4, 1, nullptr);
+		for (AllocHandle& alloc : sparse)
+			alloc = allocator.Alloc(CHUNK_SIZE / 4, 1, nullptr);
+		AllocHandle last = allocator.Alloc(CHUNK_SIZE / 2, 1, nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 4);
+
+		allocator.Free(whole, nullptr);
+		allocator.Free(dense.at(1), nullptr);
+		allocator.Free(dense.at(2), nullptr);
+		for (U8 i = 0; i < 3; ++i)
+			allocator.Free(sparse.at(i), nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 4);
+
+		std::vector<Allocator::TLSFDefragMove> moves;
+		ZE_CHECK(allocator.Defragment(UINT64_MAX, 1, moves));
+		ZE_CHECK(moves.size() == 1 && moves.front().Source == sparse.at(3));
+		allocator.CommitDefragmentation(moves, nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 3);
+		ZE_CHECK(GetAllocationCount(allocator) == 4);
+
+		allocator.Free(moves.front().Destination, nullptr);
+		allocator.Free(dense.at(0), nullptr);
+		allocator.Free(dense.at(3), nullptr);
+		allocator.Free(last, nullptr);
+		allocator.DestroyFreeChunks(nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 0);
+	}
+
+	// Random allocations spanning all memory classes cannot overlap and leave no chunks behind
+	{
+		TLSF allocator(blockAllocator, chunkAllocator);
+		allocator.Init(0, 64ULL << 20, 256, 3);
+
+		std::mt19937 engine(1);
+		std::vector<AllocHandle> live;
+		for (U32 i = 0; i < 200000; ++i)
+		{
+			if (live.size() < 64 && (live.empty() || engine() % 2))
+			{
+				const U64 size = engine() % 8 == 0 ? engine() % (1 << 20) + 1 : engine() % 8192 + 1;
+				const U64 alignment = 1ULL << (engine() % 3);
+				AllocHandle alloc = allocator.Alloc(size, alignment, nullptr);
+				ZE_CHECK(alloc);
+				ZE_CHECK(allocator.GetSize(alloc) >= size);
+				ZE_CHECK((allocator.GetOffset(alloc) / allocator.GetChunkSizeGranularity()) % alignment == 0);
+				live.emplace_back(alloc);
+			}
+			else
+			{
+				const U64 index = engine() % live.size();
+				allocator.Free(live.at(index), nullptr);
+				live.at(index) = live.back();
+				live.pop_back();
+			}
+
+			if (i % 1000 == 0)
+			{
+				std::vector<Range> ranges;
+				for (AllocHandle alloc : live)
+					ranges.emplace_back(0U, allocator.GetMemory(alloc).ID, allocator.GetOffset(alloc), allocator.GetSize(alloc));
+				std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return std::tie(a.Memory, a.Offset) < std::tie(b.Memory, b.Offset); });
+				for (U64 j = 1; j < ranges.size(); ++j)
+					ZE_CHECK(ranges.at(j - 1).Memory != ranges.at(j).Memory || ranges.at(j - 1).Offset + ranges.at(j - 1).Size <= ranges.at(j).Offset);
+			}
+		}
+		for (AllocHandle alloc : live)
+			allocator.Free(alloc, nullptr);
+		ZE_CHECK(GetAllocationCount(allocator) == 0);
+		allocator.DestroyFreeChunks(nullptr);
+		ZE_CHECK(FakeMemory::liveChunks == 0);
+	}
+
+	std::printf("ChunkedTLSF tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
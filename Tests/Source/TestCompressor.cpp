@@ -0,0 +1,92 @@
+#include "TestUtils.h"
+#include "IO/Compressor.h"
+#include <cstring>
+#include <random>
+
+using namespace ZE;
+
+constexpr U32 ENTRY_COUNT = 256;
+constexpr U32 MAX_DICTIONARY_SIZE = 16 * 1024;
+constexpr float MIN_SAVING = 0.05f;
+
+// Small entries resembling material buffers: mostly shared layout with few varying parameters
+struct Entry
+{
+	float Color[4];
+	float Specular[4];
+	float Parameters[8];
+	U32 Flags;
+	U32 TextureIndices[7];
+};
+
+// Compresses every entry with best codec and checks that it decompresses back with the recorded format.
+// Returns how many times each format has been chosen
+static std::vector<U32> RoundTrip(const std::vector<Entry>& entries, const std::vector<U8>& dictionary) noexcept
+{
+	std::vector<U32> formatCounts(static_cast<U64>(IO::CompressionFormat::ZstdDictionary) + 1, 0);
+	std::vector<U8> compressed;
+	for (const Entry& entry : entries)
+	{
+		const IO::CompressionFormat format = IO::Compressor::CompressBest(&entry, sizeof(Entry), MIN_SAVING, compressed,
+			dictionary.size() ? dictionary.data() : nullptr, Utils::SafeCast<U32>(dictionary.size()));
+		++formatCounts.at(static_cast<U64>(format));
+
+		if (format == IO::CompressionFormat::None)
+		{
+			ZE_CHECK(compressed.empty());
+			continue;
+		}
+		ZE_CHECK(format != IO::CompressionFormat::Lz4 && format != IO::CompressionFormat::Bzip2);
+		ZE_CHECK(dictionary.size() || format != IO::CompressionFormat::ZstdDictionary);
+		ZE_CHECK(compressed.size() <= static_cast<U64>(sizeof(Entry) * (1.0f - MIN_SAVING)));
+
+		IO::Compressor codec(format);
+		codec.SetDictionary(dictionary.data(), Utils::SafeCast<U32>(dictionary.size()));
+		ZE_CHECK(codec.GetOriginalSize(compressed.data(), Utils::SafeCast<U32>(compressed.size())) == sizeof(Entry));
+
+		Entry decompressed = {};
+		codec.Decompress(compressed.data(), Utils::SafeCast<U32>(compressed.size()), &decompressed, sizeof(Entry));
+		ZE_CHECK(std::memcmp(&decompressed, &entry, sizeof(Entry)) == 0);
+	}
+	return formatCounts;
+}
+
+int main()
+{
+	std::mt19937 engine(11);
+	std::vector<Entry> entries(ENTRY_COUNT);
+	std::vector<U8> samples;
+	std::vector<size_t> sampleSizes;
+	for (Entry& entry : entries)
+	{
+		const float tint = static_cast<float>(engine() % 4) * 0.25f;
+		entry = { { tint, tint, 1.0f, 1.0f }, { 0.04f, 0.04f, 0.04f, 1.0f }, { 0.5f, static_cast<float>(engine() % 8) * 0.125f, 1.0f, 0.0f, 0.1f, 0.0f, 0.0f, 1.0f },
+			engine() % 4, { 0, 1, 2, 3, UINT32_MAX, UINT32_MAX, UINT32_MAX } };
+		samples.insert(samples.end(), reinterpret_cast<const U8*>(&entry), reinterpret_cast<const U8*>(&entry + 1));
+		sampleSizes.emplace_back(sizeof(Entry));
+	}
+
+	// Not enough data for training
+	ZE_CHECK(IO::Compressor::TrainDictionary({ samples.begin(), samples.begin() + sizeof(Entry) }, { sizeof(Entry) }, MAX_DICTIONARY_SIZE).empty());
+
+	const std::vector<U8> dictionary = IO::Compressor::TrainDictionary(samples, sampleSizes, MAX_DICTIONARY_SIZE);
+	ZE_CHECK(dictionary.size() && dictionary.size() <= MAX_DICTIONARY_SIZE);
+
+	// Small entries only benefit from Zstd when dictionary is present
+	const std::vector<U32> withDictionary = RoundTrip(entries, dictionary);
+	ZE_CHECK(withDictionary.at(static_cast<U64>(IO::CompressionFormat::ZstdDictionary)) > 0);
+	const std::vector<U32> withoutDictionary = RoundTrip(entries, {});
+	ZE_CHECK(withoutDictionary.at(static_cast<U64>(IO::CompressionFormat::ZstdDictionary)) == 0);
+	ZE_CHECK(withDictionary.at(static_cast<U64>(IO::CompressionFormat::None)) <= withoutDictionary.at(static_cast<U64>(IO::CompressionFormat::None)));
+
+	// Data without any redundancy is left raw
+	std::vector<U8> noise(4096);
+	for (U8& byte : noise)
+		byte = static_cast<U8>(engine());
+	std::vector<U8> compressed;
+	ZE_CHECK(IO::Compressor::CompressBest(noise.data(), Utils::SafeCast<U32>(noise.size()), MIN_SAVING, compressed, dictionary.data(), Utils::SafeCast<U32>(dictionary.size())) == IO::CompressionFormat::None);
+	ZE_CHECK(compressed.empty());
+
+	std::printf("Compressor tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "TestTLSF.h"
+#include "Allocator/ConcurrentTLSF.h"
+#include <algorithm>
+#include <latch>
+#include <random>
+#include <thread>
+#include <tuple>
+
+using namespace ZE;
+using namespace ZE::Test;
+
+typedef Allocator::ConcurrentTLSF<FakeMemory, 4, 2> TLSF;
+
+constexpr U32 ROUNDS = 12;
+constexpr U32 THREADS_PER_ROUND = 8;
+constexpr U32 OPERATIONS = 20000;
+constexpr U32 MAX_LIVE = 64;
+constexpr U32 GRANULARITY = 256;
+
+int main()
+{
+	TLSF::BlockAllocator blockAllocator(200);
+	TLSF::ChunkAllocator chunkAllocator(30);
+	std::mutex coreMutex;
+	std::array<TLSF, 2> allocators = { TLSF(blockAllocator, chunkAllocator, coreMutex), TLSF(blockAllocator, chunkAllocator, coreMutex) };
+	allocators.at(0).Init(0, 64ULL << 20, GRANULARITY, 3);
+	allocators.at(1).Init(0, 64ULL << 20, 1, 3);
+
+	// Sizes are rounded up to one of 4 classes between powers of 2
+	for (TLSF& allocator : allocators)
+	{
+		const U64 unit = allocator.GetChunkSizeGranularity();
+		for (U64 units : { 1ULL, 3ULL, 5ULL, 9ULL, 33ULL, 100ULL })
+		{
+			AllocHandle alloc = allocator.Alloc(units * unit, 1, nullptr);
+			ZE_CHECK(alloc);
+			const U64 size = allocator.GetSize(alloc) / unit;
+			ZE_CHECK(size >= units && size * 4 <= units * 5);
+			allocator.Free(alloc, nullptr);
+		}
+	}
+
+	// Every round starts new set of threads, more in total than available thread slots,
+	// they exit without flushing their caches so blocks have to be reclaimed by the allocators
+	for (U32 round = 0; round < ROUNDS; ++round)
+	{
+		std::array<std::vector<Range>, THREADS_PER_ROUND> ranges;
+		std::latch collected(THREADS_PER_ROUND);
+		std::latch checked(1);
+		std::vector<std::thread> threads;
+		for (U32 t = 0; t < THREADS_PER_ROUND; ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					std::mt19937 engine(round * THREADS_PER_ROUND + t);
+					std::vector<std::pair<AllocHandle, U32>> live;
+					for (U32 i = 0; i < OPERATIONS; ++i)
+					{
+						if (live.size() < MAX_LIVE && (live.empty() || engine() % 2))
+						{
+							const U32 index = engine() % 2;
+							TLSF& allocator = allocators.at(index);
+							const U64 size = engine() % 8 == 0 ? engine() % (1 << 20) + 1 : engine() % 8192 + 1;
+							const U64 alignment = 1ULL << (engine() % 3);
+
+							AllocHandle alloc = allocator.Alloc(size, alignment, nullptr);
+							ZE_CHECK(alloc);
+							ZE_CHECK(allocator.GetSize(alloc) >= size);
+							ZE_CHECK((allocator.GetOffset(alloc) / allocator.GetChunkSizeGranularity()) % alignment == 0);
+							live.emplace_back(alloc, index);
+						}
+						else
+						{
+							const U64 pos = engine() % live.size();
+							allocators.at(live.at(pos).second).Free(live.at(pos).first, nullptr);
+							live.at(pos) = live.back();
+							live.pop_back();
+						}
+					}
+
+					for (const auto& [alloc, index] : live)
+					{
+						const TLSF& allocator = allocators.at(index);
+						ranges.at(t).emplace_back(index, allocator.GetMemory(alloc).ID, allocator.GetOffset(alloc), allocator.GetSize(alloc));
+					}
+					collected.count_down();
+					checked.wait();
+
+					for (const auto& [alloc, index] : live)
+						allocators.at(index).Free(alloc, nullptr);
+				});
+		}
+
+		// Live allocations of all threads cannot overlap
+		collected.wait();
+		std::vector<Range> all;
+		for (const auto& threadRanges : ranges)
+			all.insert(all.end(), threadRanges.begin(), threadRanges.end());
+		std::sort(all.begin(), all.end(), [](const Range& a, const Range& b) { return std::tie(a.Allocator, a.Memory, a.Offset) < std::tie(b.Allocator, b.Memory, b.Offset); });
+		for (U64 i = 1; i < all.size(); ++i)
+		{
+			const Range& prev = all.at(i - 1);
+			const Range& cur = all.at(i);
+			ZE_CHECK(prev.Allocator != cur.Allocator || prev.Memory != cur.Memory || prev.Offset + prev.Size <= cur.Offset);
+		}
+		checked.count_down();
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	// Any locked operation returns blocks left in caches of exited threads
+	for (TLSF& allocator : allocators)
+	{
+		allocator.FlushThreadCache(nullptr);
+		AllocHandle alloc = allocator.Alloc(1 << 20, 1, nullptr);
+		ZE_CHECK(alloc);
+		allocator.Free(alloc, nullptr);
+		ZE_CHECK(GetAllocationCount(allocator) == 0);
+	}
+
+	for (TLSF& allocator : allocators)
+		allocator.DestroyFreeChunks(nullptr);
+	ZE_CHECK(FakeMemory::liveChunks == 0);
+
+	std::printf("ConcurrentTLSF tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
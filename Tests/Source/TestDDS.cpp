@@ -0,0 +1,159 @@
+#include "TestUtils.h"
+#include "DDS/Utils.h"
+#include "GFX/Surface.h"
+#include <cstring>
+#include <filesystem>
+
+using namespace ZE;
+
+// Magic number followed by both headers
+constexpr U64 HEADERS_SIZE = sizeof(U32) + sizeof(DDS::Header) + sizeof(DDS::HeaderDXT10);
+
+struct TextureDesc
+{
+	U32 Width;
+	U32 Height;
+	U16 Depth;
+	U16 MipCount;
+	U16 ArraySize;
+	PixelFormat Format;
+	bool Alpha;
+};
+
+static std::vector<U8> ReadFile(const std::string& path) noexcept
+{
+	std::vector<U8> content(std::filesystem::file_size(path));
+	FILE* file = fopen(path.c_str(), "rb");
+	ZE_CHECK(file);
+	ZE_CHECK(content.empty() || fread(content.data(), content.size(), 1, file) == 1);
+	fclose(file);
+	return content;
+}
+
+// Image data is laid out the same way as inside DDS file: array slices containing whole mip chains, mips containing all their depth levels
+static void CheckTexture(const TextureDesc& desc, const std::string& path, const std::string& headerPath) noexcept
+{
+	const U8 pixelSize = Utils::GetFormatBitCount(desc.Format) / 8;
+	U64 dataSize = 0;
+	for (U16 a = 0; a < desc.ArraySize; ++a)
+	{
+		for (U16 mip = 0; mip < desc.MipCount; ++mip)
+		{
+			const U32 width = std::max(desc.Width >> mip, 1U);
+			const U32 height = std::max(desc.Height >> mip, 1U);
+			U32 rowSize = 0, rowCount = 0;
+			DDS::GetSurfaceInfo(width, height, desc.Format, rowSize, rowCount);
+			ZE_CHECK(rowSize == width * pixelSize && rowCount == height);
+
+			for (U16 d = 0; d < std::max(desc.Depth >> mip, 1); ++d)
+			{
+				ZE_CHECK(DDS::GetImageFileOffset(desc.Width, desc.Height, desc.Depth, desc.MipCount, desc.Format, a, mip, d) == dataSize);
+				dataSize += static_cast<U64>(rowSize) * rowCount;
+			}
+		}
+	}
+	// Offset past the last array slice is the size of whole surface data
+	ZE_CHECK(DDS::GetImageFileOffset(desc.Width, desc.Height, desc.Depth, desc.MipCount, desc.Format, desc.ArraySize, 0, 0) == dataSize);
+
+	std::vector<U8> data(dataSize);
+	for (U64 i = 0; i < dataSize; ++i)
+		data.at(i) = static_cast<U8>(i * 7 + i / 251);
+	GFX::Surface surface(desc.Width, desc.Height, desc.Depth, desc.MipCount, desc.ArraySize, desc.Format, desc.Alpha, data.data());
+	const DDS::SurfaceData surfaceData = { desc.Format, desc.Alpha, desc.Width, desc.Height, desc.Depth, desc.MipCount, desc.ArraySize, surface.GetMemory() };
+
+	// Padded images in memory contain the same rows as images in the file
+	for (U16 a = 0; a < desc.ArraySize; ++a)
+	{
+		for (U16 mip = 0; mip < desc.MipCount; ++mip)
+		{
+			const U32 rowSize = std::max(desc.Width >> mip, 1U) * pixelSize;
+			const U32 rowCount = std::max(desc.Height >> mip, 1U);
+			for (U16 d = 0; d < std::max(desc.Depth >> mip, 1); ++d)
+			{
+				const U8* image = surface.GetImage(a, mip, d);
+				const U8* fileImage = data.data() + DDS::GetImageFileOffset(desc.Width, desc.Height, desc.Depth, desc.MipCount, desc.Format, a, mip, d);
+				for (U32 y = 0; y < rowCount; ++y)
+					ZE_CHECK(std::memcmp(image + y * surface.GetRowByteSize(mip), fileImage + y * rowSize, rowSize) == 0);
+			}
+		}
+	}
+
+	// Padding of rows in memory is removed when saving
+	FILE* file = fopen(path.c_str(), "wb");
+	ZE_CHECK(file);
+	ZE_CHECK(DDS::EncodeFile(file, surfaceData) == DDS::FileResult::Ok);
+	fclose(file);
+	const std::vector<U8> encoded = ReadFile(path);
+	ZE_CHECK(encoded.size() == HEADERS_SIZE + dataSize);
+	ZE_CHECK(std::equal(data.begin(), data.end(), encoded.begin() + HEADERS_SIZE));
+
+	// Headers alone are the same as the beginning of whole file
+	file = fopen(headerPath.c_str(), "wb");
+	ZE_CHECK(file);
+	ZE_CHECK(DDS::EncodeFileHeader(file, surfaceData) == DDS::FileResult::Ok);
+	fclose(file);
+	const std::vector<U8> headers = ReadFile(headerPath);
+	ZE_CHECK(headers.size() == HEADERS_SIZE && std::equal(headers.begin(), headers.end(), encoded.begin()));
+
+	// Parsing headers leaves file at the start of surface data
+	file = fopen(path.c_str(), "rb");
+	ZE_CHECK(file);
+	DDS::FileData fileData = {};
+	ZE_CHECK(DDS::ParseFileHeader(file, fileData) == DDS::FileResult::Ok);
+	ZE_CHECK(static_cast<U64>(ftell(file)) == HEADERS_SIZE);
+	ZE_CHECK(fileData.Format == desc.Format && fileData.Alpha == desc.Alpha);
+	ZE_CHECK(fileData.Width == desc.Width && fileData.Height == desc.Height && fileData.Depth == desc.Depth);
+	ZE_CHECK(fileData.MipCount == desc.MipCount && fileData.ArraySize == desc.ArraySize);
+	ZE_CHECK(fileData.ImageMemory == nullptr);
+	fclose(file);
+
+	// Whole file loaded and saved again stays the same
+	file = fopen(path.c_str(), "rb");
+	ZE_CHECK(file);
+	ZE_CHECK(DDS::ParseFile(file, fileData) == DDS::FileResult::Ok);
+	fclose(file);
+	file = fopen(path.c_str(), "wb");
+	ZE_CHECK(file);
+	ZE_CHECK(DDS::EncodeFile(file, { fileData.Format, fileData.Alpha, fileData.Width, fileData.Height, fileData.Depth, fileData.MipCount, fileData.ArraySize, fileData.ImageMemory }) == DDS::FileResult::Ok);
+	fclose(file);
+	ZE_CHECK(ReadFile(path) == encoded);
+}
+
+int main()
+{
+	// Rows of uncompressed formats are stored without padding, compressed ones as rows of 4x4 blocks
+	U32 rowSize = 0, rowCount = 0;
+	DDS::GetSurfaceInfo(5, 3, PixelFormat::R8G8B8A8_UNorm, rowSize, rowCount);
+	ZE_CHECK(rowSize == 20 && rowCount == 3);
+	DDS::GetSurfaceInfo(3, 2, PixelFormat::R32G32B32_Float, rowSize, rowCount);
+	ZE_CHECK(rowSize == 36 && rowCount == 2);
+	DDS::GetSurfaceInfo(5, 5, PixelFormat::BC1_UNorm, rowSize, rowCount);
+	ZE_CHECK(rowSize == 16 && rowCount == 2);
+	DDS::GetSurfaceInfo(8, 4, PixelFormat::BC3_UNorm, rowSize, rowCount);
+	ZE_CHECK(rowSize == 32 && rowCount == 1);
+	DDS::GetSurfaceInfo(1, 1, PixelFormat::BC7_UNorm, rowSize, rowCount);
+	ZE_CHECK(rowSize == 16 && rowCount == 1);
+
+	// Offsets of compressed mips are counted in blocks
+	ZE_CHECK(DDS::GetImageFileOffset(16, 8, 1, 3, PixelFormat::BC1_UNorm, 0, 1, 0) == 4 * 2 * 8);
+	ZE_CHECK(DDS::GetImageFileOffset(16, 8, 1, 3, PixelFormat::BC1_UNorm, 0, 2, 0) == 4 * 2 * 8 + 2 * 8);
+	ZE_CHECK(DDS::GetImageFileOffset(16, 8, 1, 3, PixelFormat::BC1_UNorm, 1, 0, 0) == 4 * 2 * 8 + 2 * 8 + 8);
+
+	const std::string path = (std::filesystem::temp_directory_path() / "ZETestDDS.dds").string();
+	const std::string headerPath = (std::filesystem::temp_directory_path() / "ZETestDDSHeader.dds").string();
+	// Array with odd sizes, full mip chain with rows matching alignment, cubemap, volume texture and 1D texture
+	for (const TextureDesc& desc : {
+		TextureDesc{ 13, 7, 1, 4, 3, PixelFormat::R8G8B8A8_UNorm, true },
+		TextureDesc{ 64, 64, 1, 7, 1, PixelFormat::R8G8B8A8_UNorm, false },
+		TextureDesc{ 16, 16, 1, 5, 6, PixelFormat::R16G16B16A16_Float, false },
+		TextureDesc{ 9, 5, 4, 3, 1, PixelFormat::R32G32B32A32_Float, true },
+		TextureDesc{ 300, 1, 1, 1, 1, PixelFormat::R32_Float, false } })
+	{
+		CheckTexture(desc, path, headerPath);
+	}
+	std::filesystem::remove(path);
+	std::filesystem::remove(headerPath);
+
+	std::printf("DDS tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "TestUtils.h"
+#include "Platform/Linux/File.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace ZE;
+
+constexpr U32 FILE_SIZE = 8 * 1024 * 1024;
+constexpr U32 CHUNK_SIZE = 4096;
+
+int main()
+{
+	// Files are only opened for writing when they already exist
+	const std::string path = (std::filesystem::temp_directory_path() / "ZETestFile.bin").string();
+	{
+		std::ofstream create(path, std::ios::binary | std::ios::trunc);
+		ZE_CHECK(create.good());
+	}
+	std::printf("Asynchronous operations using %s\n", Linux::AsyncIO::Get().IsUsingRing() ? "io_uring" : "IO threads");
+
+	std::mt19937 engine(17);
+	std::vector<U8> data(FILE_SIZE);
+	for (U8& byte : data)
+		byte = static_cast<U8>(engine());
+
+	// Write first half at once and rest in many small chunks submitted together
+	{
+		Linux::File file;
+		ZE_CHECK(file.Open(path, IO::FileFlag::WriteOnly));
+		ZE_CHECK(file.Write(data.data(), FILE_SIZE / 2, 0));
+
+		std::vector<std::future<U32>> writes;
+		for (U32 offset = FILE_SIZE / 2; offset < FILE_SIZE; offset += CHUNK_SIZE)
+			writes.emplace_back(file.WriteAsync(data.data() + offset, CHUNK_SIZE, offset));
+		for (auto& write : writes)
+			ZE_CHECK(write.get() == CHUNK_SIZE);
+
+		// Reading from write only file fails
+		U8 byte = 0;
+		ZE_CHECK(!file.Read(&byte, 1, 0));
+		ZE_CHECK(file.ReadAsync(&byte, 1, 0).get() == 0);
+	}
+	ZE_CHECK(std::filesystem::file_size(path) == FILE_SIZE);
+
+	{
+		Linux::File file;
+		ZE_CHECK(file.Open(path, IO::FileFlag::None));
+
+		std::vector<U8> readData(FILE_SIZE);
+		ZE_CHECK(file.Read(readData.data(), FILE_SIZE, 0));
+		ZE_CHECK(readData == data);
+
+		// Chunks in random order mixed with single big read
+		std::fill(readData.begin(), readData.end(), 0);
+		std::vector<U32> offsets;
+		for (U32 offset = 0; offset < FILE_SIZE / 2; offset += CHUNK_SIZE)
+			offsets.emplace_back(offset);
+		std::shuffle(offsets.begin(), offsets.end(), engine);
+
+		std::vector<std::future<U32>> reads;
+		reads.emplace_back(file.ReadAsync(readData.data() + FILE_SIZE / 2, FILE_SIZE / 2, FILE_SIZE / 2));
+		for (U32 offset : offsets)
+			reads.emplace_back(file.ReadAsync(readData.data() + offset, CHUNK_SIZE, offset));
+		ZE_CHECK(reads.front().get() == FILE_SIZE / 2);
+		for (U64 i = 1; i < reads.size(); ++i)
+			ZE_CHECK(reads.at(i).get() == CHUNK_SIZE);
+		ZE_CHECK(readData == data);
+
+		// Only bytes before end of file are returned
+		ZE_CHECK(file.ReadAsync(readData.data(), CHUNK_SIZE, FILE_SIZE - 100).get() == 100);
+		ZE_CHECK(!file.Read(readData.data(), CHUNK_SIZE, FILE_SIZE - 100));
+		ZE_CHECK(std::equal(readData.begin(), readData.begin() + 100, data.end() - 100));
+
+		// Moved handle keeps the file open
+		Linux::File moved(std::move(file));
+		U8 byte = 0;
+		ZE_CHECK(moved.Read(&byte, 1, 12345) && byte == data.at(12345));
+		ZE_CHECK(!file.Read(&byte, 1, 0));
+	}
+
+	Linux::File missing;
+	ZE_CHECK(!missing.Open((std::filesystem::temp_directory_path() / "ZETestFileMissing.bin").string(), IO::FileFlag::None));
+
+	std::filesystem::remove(path);
+	std::printf("File tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
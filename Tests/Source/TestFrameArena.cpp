@@ -0,0 +1,130 @@
+#include "TestUtils.h"
+#include "Allocator/FrameArena.h"
+#include "ThreadPool.h"
+#include <string>
+
+using namespace ZE;
+
+constexpr U64 PAGE_SIZE = 4096;
+constexpr U32 CHUNK_COUNT = 64;
+constexpr U32 ALLOC_COUNT = 200;
+
+// Array filled with the same value, size depends on it's position so allocations of single chunk cross page boundaries
+struct Allocation
+{
+	U32* Data;
+	U32 Count;
+};
+
+// Allocates from the arena on every worker of the pool and checks that no memory was shared between allocations
+static void AllocFrame(const ThreadPool& pool, Allocator::FrameArena& arena, std::vector<std::vector<Allocation>>& allocations) noexcept
+{
+	pool.ProcessChunks(CHUNK_COUNT, ThreadPriority::Critical, [&](U64 chunk)
+		{
+			std::vector<Allocation>& chunkAllocations = allocations.at(chunk);
+			chunkAllocations.clear();
+			for (U32 i = 0; i < ALLOC_COUNT; ++i)
+			{
+				const U32 value = Utils::SafeCast<U32>(chunk) * ALLOC_COUNT + i;
+				Allocation& alloc = chunkAllocations.emplace_back(arena.Alloc<U32>(i % 50 + 1), i % 50 + 1);
+				ZE_CHECK(reinterpret_cast<U64>(alloc.Data) % alignof(U32) == 0);
+				std::fill_n(alloc.Data, alloc.Count, value);
+			}
+
+			// Stricter alignment in between regular allocations
+			void* aligned = arena.Alloc(24, 64);
+			ZE_CHECK(reinterpret_cast<U64>(aligned) % 64 == 0);
+			std::memset(aligned, 0xFF, 24);
+		});
+
+	for (U32 chunk = 0; chunk < CHUNK_COUNT; ++chunk)
+	{
+		for (U32 i = 0; i < ALLOC_COUNT; ++i)
+		{
+			const Allocation& alloc = allocations.at(chunk).at(i);
+			for (U32 j = 0; j < alloc.Count; ++j)
+				ZE_CHECK(alloc.Data[j] == chunk * ALLOC_COUNT + i);
+		}
+	}
+}
+
+int main()
+{
+	// Fixed number of workers so allocations are always done concurrently, regardless of the machine
+	ThreadPool pool;
+	pool.Init(0, 4);
+	Allocator::FrameArena arena(PAGE_SIZE);
+	std::vector<std::vector<Allocation>> allocations(CHUNK_COUNT);
+
+	// Same amount of work every frame only reuses pages of previous frames
+	AllocFrame(pool, arena, allocations);
+	ZE_CHECK(arena.GetLastFrameUsage() == 0 && arena.GetPeakUsage() == 0);
+	arena.Reset();
+	const U64 firstUsage = arena.GetLastFrameUsage();
+	ZE_CHECK(firstUsage >= CHUNK_COUNT * (ALLOC_COUNT / 50) * (50 * 51 / 2) * sizeof(U32));
+	ZE_CHECK(arena.GetPeakUsage() == firstUsage);
+	ZE_CHECK(arena.GetCapacity() >= firstUsage);
+
+	// Pages taken by workers are dropped on reset, when stale page would be reused old data would be overwritten
+	// and check of every allocation would fail in the next frame
+	const U64 capacity = arena.GetCapacity();
+	for (U32 frame = 0; frame < 10; ++frame)
+	{
+		AllocFrame(pool, arena, allocations);
+		arena.Reset();
+		ZE_CHECK(arena.GetLastFrameUsage() <= arena.GetPeakUsage());
+	}
+	ZE_CHECK(arena.GetCapacity() <= capacity * 2);
+
+	// Empty frame keeps the peak
+	arena.Reset();
+	ZE_CHECK(arena.GetLastFrameUsage() == 0);
+	ZE_CHECK(arena.GetPeakUsage() >= firstUsage);
+
+	// Allocations bigger than the page get their own page
+	U8* big = arena.Alloc<U8>(PAGE_SIZE * 3);
+	std::memset(big, 1, PAGE_SIZE * 3);
+	U8* small = arena.Alloc<U8>(16);
+	ZE_CHECK(small + 16 <= big || small >= big + PAGE_SIZE * 3);
+
+	// Thread switching between arenas doesn't keep using page from the other one
+	Allocator::FrameArena otherArena(PAGE_SIZE);
+	U32* first = arena.Alloc<U32>(4);
+	U32* other = otherArena.Alloc<U32>(4);
+	U32* second = arena.Alloc<U32>(4);
+	std::fill_n(first, 4, 1);
+	std::fill_n(other, 4, 2);
+	std::fill_n(second, 4, 3);
+	ZE_CHECK(first[3] == 1 && other[0] == 2 && other[3] == 2 && second[0] == 3);
+	otherArena.Reset();
+	ZE_CHECK(otherArena.GetLastFrameUsage() == 4 * sizeof(U32));
+
+	// Debug tags
+	const std::string_view tag = arena.Concat("Mesh_", 1234);
+	ZE_CHECK(tag == "Mesh_1234" && tag.data()[tag.size()] == '\0');
+	const std::string_view maxTag = arena.Concat("Max ", UINT64_MAX);
+	ZE_CHECK(maxTag == "Max " + std::to_string(UINT64_MAX) && maxTag.data()[maxTag.size()] == '\0');
+	const std::string_view emptyTag = arena.Concat("", 0);
+	ZE_CHECK(emptyTag == "0" && emptyTag.data()[emptyTag.size()] == '\0');
+	ZE_CHECK(tag == "Mesh_1234");
+
+	// Vectors growing from multiple workers, every reallocation leaves previous storage in the arena
+	arena.Reset();
+	pool.ProcessChunks(8, ThreadPriority::Critical, [&](U64 chunk)
+		{
+			Allocator::FrameVector<U64> values(arena);
+			for (U64 i = 0; i < 5000; ++i)
+				values.emplace_back(chunk * 5000 + i);
+			for (U64 i = 0; i < values.size(); ++i)
+				ZE_CHECK(values.at(i) == chunk * 5000 + i);
+
+			Allocator::FrameVector<U8> bytes(PAGE_SIZE * 2, 7, Allocator::FrameAllocator<U8>(arena));
+			bytes.resize(PAGE_SIZE * 5, 9);
+			ZE_CHECK(bytes.at(PAGE_SIZE * 2 - 1) == 7 && bytes.back() == 9);
+		});
+	arena.Reset();
+	ZE_CHECK(arena.GetLastFrameUsage() >= 8 * (5000 * sizeof(U64) + PAGE_SIZE * 5));
+
+	std::printf("Frame arena tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "TestUtils.h"
+#include "GFX/Pipeline/MemoryAliasing.h"
+#include <algorithm>
+#include <random>
+
+using namespace ZE;
+using namespace ZE::GFX::Pipeline;
+
+// Checks that regions alive at the same time don't share memory and that all are placed correctly inside it
+static void CheckPlacement(const std::vector<AliasingRegion>& regions, U32 memoryChunks) noexcept
+{
+	for (U32 i = 0; i < regions.size(); ++i)
+	{
+		const AliasingRegion& region = regions.at(i);
+		ZE_CHECK(region.ChunkOffset % region.ChunkAlignment == 0);
+		ZE_CHECK(region.ChunkOffset + region.Chunks <= memoryChunks);
+		for (U32 j = 0; j < i; ++j)
+		{
+			const AliasingRegion& other = regions.at(j);
+			const bool lifetimeOverlap = region.StartLevel < other.EndLevel && other.StartLevel < region.EndLevel;
+			const bool memoryOverlap = region.ChunkOffset < other.ChunkOffset + other.Chunks && other.ChunkOffset < region.ChunkOffset + region.Chunks;
+			ZE_CHECK(!(lifetimeOverlap && memoryOverlap));
+		}
+	}
+}
+
+int main()
+{
+	ZE_CHECK(PlanMemoryAliasing(nullptr, 0) == 0);
+
+	// Disjoint lifetimes share memory, overlapping one is placed after them
+	std::vector<AliasingRegion> regions =
+	{
+		{ 10, 1, 0, 2 },
+		{ 10, 1, 2, 4 },
+		{ 5, 1, 1, 3 },
+	};
+	ZE_CHECK(PlanMemoryAliasing(regions.data(), Utils::SafeCast<U32>(regions.size())) == 15);
+	ZE_CHECK(regions.at(0).ChunkOffset == 0);
+	ZE_CHECK(regions.at(1).ChunkOffset == 0);
+	ZE_CHECK(regions.at(2).ChunkOffset == 10);
+
+	// Smallest fitting gap is selected and alignment is respected
+	regions =
+	{
+		{ 10, 1, 0, 1 },
+		{ 2, 1, 0, 3 },
+		{ 3, 1, 0, 3 },
+		{ 3, 1, 0, 1 },
+		{ 2, 1, 1, 2 },
+		{ 3, 4, 2, 3 },
+	};
+	ZE_CHECK(PlanMemoryAliasing(regions.data(), Utils::SafeCast<U32>(regions.size())) == 18);
+	ZE_CHECK(regions.at(3).ChunkOffset == 15);
+	ZE_CHECK(regions.at(4).ChunkOffset == 15);
+	ZE_CHECK(regions.at(5).ChunkOffset == 0);
+
+	// Random layouts of frame buffers
+	std::mt19937 engine(7);
+	for (U32 layout = 0; layout < 500; ++layout)
+	{
+		const U32 levels = 4 + engine() % 40;
+		regions.resize(5 + engine() % 80);
+		for (AliasingRegion& region : regions)
+		{
+			region.Chunks = 1 + engine() % (engine() % 4 ? 200 : 2000);
+			region.ChunkAlignment = engine() % 5 == 0 ? 64 : 1;
+			region.StartLevel = engine() % levels;
+			region.EndLevel = region.StartLevel + 1 + engine() % (levels - region.StartLevel);
+			region.ChunkOffset = 0;
+		}
+		std::sort(regions.begin(), regions.end(), [](const AliasingRegion& r1, const AliasingRegion& r2) { return r1.Chunks > r2.Chunks; });
+		CheckPlacement(regions, PlanMemoryAliasing(regions.data(), Utils::SafeCast<U32>(regions.size())));
+	}
+
+	std::printf("Memory aliasing tests passed\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+#include "TestUtils.h"
+#include "DDS/Utils.h"
+#include "GFX/Surface.h"
+#include "MipGen.h"
+#include <filesystem>
+
+using namespace ZE;
+
+// Magic number followed by both headers
+constexpr U64 HEADERS_SIZE = sizeof(U32) + sizeof(DDS::Header) + sizeof(DDS::HeaderDXT10);
+
+// Source texture containing only the top level
+struct SourceDesc
+{
+	U32 Width;
+	U32 Height;
+	U16 Depth;
+	U16 ArraySize;
+	PixelFormat Format;
+};
+
+static std::vector<U8> ReadFile(const std::string& path) noexcept
+{
+	std::vector<U8> content(std::filesystem::file_size(path));
+	FILE* file = fopen(path.c_str(), "rb");
+	ZE_CHECK(file);
+	ZE_CHECK(content.empty() || fread(content.data(), content.size(), 1, file) == 1);
+	fclose(file);
+	return content;
+}
+
+static void CreateSource(const SourceDesc& desc, const std::string& path) noexcept
+{
+	const U8 channelCount = Utils::GetChannelCount(desc.Format);
+	const bool floatFormat = desc.Format == PixelFormat::R32G32B32A32_Float;
+	const U64 pixelCount = static_cast<U64>(desc.Width) * desc.Height * std::max(desc.Depth, desc.ArraySize);
+
+	// Values vary in every direction so rows and columns of the window are never the same
+	std::vector<U8> data(pixelCount * Utils::GetFormatBitCount(desc.Format) / 8);
+	for (U64 i = 0; i < pixelCount * channelCount; ++i)
+	{
+		const U64 pixel = i / channelCount;
+		const U8 value = static_cast<U8>((pixel % desc.Width) * 7 + (pixel / desc.Width) * 13 + (i % channelCount) * 61 + pixel / 97);
+		if (floatFormat)
+			reinterpret_cast<float*>(data.data())[i] = static_cast<float>(value) / UINT8_MAX;
+		else
+			data.at(i) = value;
+	}
+
+	GFX::Surface surface(desc.Width, desc.Height, desc.Depth, 1, desc.ArraySize, desc.Format, true, data.data());
+	ZE_CHECK(surface.Save(path));
+}
+
+static void RunJobs(MipParams& job, const std::string& memoryOut, const std::string& streamOut, const ToolRuntime& runtime) noexcept
+{
+	job.OutFile = memoryOut;
+	job.Stream = false;
+	ZE_CHECK(RunJob(job, runtime) == ResultCode::Success);
+	job.OutFile = streamOut;
+	job.Stream = true;
+	ZE_CHECK(RunJob(job, runtime) == ResultCode::Success);
+}
+
+int main()
+{
+	// Tiles of regular mode are processed concurrently, streaming mode always runs on the calling thread
+	ToolRuntime runtime(4);
+	const std::filesystem::path dir = std::filesystem::temp_directory_path();
+	const std::string source = (dir / "ZETestMipGenSource.dds").string();
+	const std::string memoryOut = (dir / "ZETestMipGenMemory.dds").string();
+	const std::string streamOut = (dir / "ZETestMipGenStream.dds").string();
+	const std::string inPlace = (dir / "ZETestMipGenInPlace.dds").string();
+
+	// Odd sizes, single pixel wide texture, array and volume
+	for (const SourceDesc& desc : {
+		SourceDesc{ 37, 23, 1, 1, PixelFormat::R8G8B8A8_UNorm },
+		SourceDesc{ 64, 16, 1, 3, PixelFormat::R32G32B32A32_Float },
+		SourceDesc{ 1, 45, 1, 1, PixelFormat::R8G8B8A8_UNorm },
+		SourceDesc{ 20, 12, 5, 1, PixelFormat::R8G8B8A8_UNorm } })
+	{
+		CreateSource(desc, source);
+
+		// Separable filters use the same passes in both modes so results have to be identical
+		for (Math::FilterType filter : { Math::FilterType::Kaiser, Math::FilterType::Lanczos, Math::FilterType::Gauss })
+		{
+			for (U32 windowSize : { 2U, 3U, 6U })
+			{
+				MipParams job = {};
+				job.Source = source;
+				job.Filter = filter;
+				job.WindowSize = windowSize;
+				RunJobs(job, memoryOut, streamOut, runtime);
+				ZE_CHECK(ReadFile(memoryOut) == ReadFile(streamOut));
+			}
+		}
+
+		// Regular mode averages whole window at once while streaming applies it as separable filter, values can differ only by rounding
+		if (desc.Format == PixelFormat::R8G8B8A8_UNorm)
+		{
+			for (U32 windowSize : { 2U, 4U })
+			{
+				MipParams job = {};
+				job.Source = source;
+				job.Filter = Math::FilterType::Box;
+				job.WindowSize = windowSize;
+				RunJobs(job, memoryOut, streamOut, runtime);
+
+				const std::vector<U8> memory = ReadFile(memoryOut);
+				const std::vector<U8> stream = ReadFile(streamOut);
+				ZE_CHECK(memory.size() == stream.size());
+				ZE_CHECK(std::equal(memory.begin(), memory.begin() + HEADERS_SIZE, stream.begin()));
+				for (U64 i = HEADERS_SIZE; i < memory.size(); ++i)
+					ZE_CHECK(std::abs(memory.at(i) - stream.at(i)) <= 1);
+			}
+		}
+
+		// Source overwritten by streaming mode is only replaced after all mips are written
+		std::filesystem::copy_file(source, inPlace, std::filesystem::copy_options::overwrite_existing);
+		MipParams job = {};
+		job.Source = inPlace;
+		job.OutFile = inPlace;
+		job.Filter = Math::FilterType::Gauss;
+		job.WindowSize = 4;
+		job.Stream = true;
+		ZE_CHECK(RunJob(job, runtime) == ResultCode::Success);
+		job.Source = source;
+		job.OutFile = memoryOut;
+		job.Stream = false;
+		ZE_CHECK(RunJob(job, runtime) == ResultCode::Success);
+		ZE_CHECK(ReadFile(inPlace) == ReadFile(memoryOut));
+		ZE_CHECK(!std::filesystem::exists(inPlace + ".stream"));
+	}
+
+	for (const std::string& path : { source, memoryOut, streamOut, inPlace })
+		std::filesystem::remove(path);
+	std::printf("MipGen tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "TestUtils.h"
+#include "Allocator/PageRing.h"
+#include <thread>
+
+using namespace ZE;
+
+constexpr U32 PAGE_SIZE = 1024;
+constexpr U32 THREAD_COUNT = 8;
+constexpr U32 VALUE_COUNT = 20;
+
+// Page backed by regular CPU memory instead of mapped GPU buffer
+struct FakePage
+{
+	std::unique_ptr<U8[]> Memory;
+};
+
+int main()
+{
+	Allocator::PageRing<FakePage, PAGE_SIZE> ring;
+	UA32 livePages = 0;
+	auto createPage = [&livePages](FakePage& page) -> U8*
+		{
+			ZE_CHECK(page.Memory == nullptr);
+			page.Memory = std::make_unique<U8[]>(PAGE_SIZE);
+			livePages.fetch_add(1, std::memory_order_relaxed);
+			return page.Memory.get();
+		};
+	auto freePage = [&livePages](FakePage& page)
+		{
+			ZE_CHECK(page.Memory != nullptr);
+			page.Memory = nullptr;
+			livePages.fetch_sub(1, std::memory_order_relaxed);
+		};
+
+	for (U32 frame = 0; frame < 40; ++frame)
+	{
+		// Every few frames number of allocations is big enough to need thousands of pages
+		const U32 allocCount = frame % 8 == 7 ? 3000 : (frame % 5 + 1) * 100;
+		const U32 alignment = frame % 2 ? 256 : 16;
+
+		std::vector<std::vector<Allocator::PageRing<FakePage, PAGE_SIZE>::Allocation>> allocations(THREAD_COUNT);
+		std::vector<std::thread> threads;
+		for (U32 t = 0; t < THREAD_COUNT; ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					for (U32 i = 0; i < allocCount; ++i)
+					{
+						U32 values[VALUE_COUNT];
+						std::fill_n(values, VALUE_COUNT, t * 1000000 + i);
+						const auto alloc = ring.Alloc(values, sizeof(values), alignment, createPage);
+						ZE_CHECK(alloc.Offset % alignment == 0);
+						ZE_CHECK(alloc.Offset + sizeof(values) <= PAGE_SIZE);
+						allocations.at(t).emplace_back(alloc);
+					}
+				});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// Data of every thread is intact so no page have been shared between threads
+		for (U32 t = 0; t < THREAD_COUNT; ++t)
+		{
+			for (U32 i = 0; i < allocCount; ++i)
+			{
+				const auto& alloc = allocations.at(t).at(i);
+				ZE_CHECK(alloc.Page < ring.GetPageCount());
+				U32 values[VALUE_COUNT];
+				std::memcpy(values, ring.GetPage(alloc.Page).Memory.get() + alloc.Offset, sizeof(values));
+				for (U32 value : values)
+					ZE_CHECK(value == t * 1000000 + i);
+			}
+		}
+		ZE_CHECK(livePages == ring.GetPageCount());
+
+		ring.Reset(freePage);
+		ZE_CHECK(livePages == ring.GetPageCount());
+	}
+	ring.Free(freePage);
+	ZE_CHECK(livePages == 0);
+
+	std::printf("PageRing tests passed\n");
+	return EXIT_SUCCESS;
+}
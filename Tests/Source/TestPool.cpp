@@ -0,0 +1,77 @@
+#include "TestUtils.h"
+#include "Allocator/Pool.h"
+#include <random>
+
+using namespace ZE;
+
+// Object tracking number of currently living instances
+struct Tracked
+{
+	U64 Value;
+	S32* Alive;
+
+	Tracked(U64 value, S32* alive) noexcept : Value(value), Alive(alive) { ++*Alive; }
+	~Tracked() { --*Alive; }
+};
+
+int main()
+{
+	S32 alive = 0;
+	{
+		Allocator::Pool<Tracked> pool(16);
+		std::vector<Tracked*> items;
+		for (U64 i = 0; i < 5000; ++i)
+			items.emplace_back(pool.Alloc(i, &alive));
+		for (U64 i = 0; i < items.size(); ++i)
+			ZE_CHECK(items.at(i)->Value == i);
+
+		// Freed items are reused and remaining ones destroyed on clear
+		for (U64 i = 0; i < items.size(); i += 2)
+			pool.Free(items.at(i));
+		ZE_CHECK(alive == 2500);
+		for (U64 i = 0; i < items.size(); i += 2)
+			items.at(i) = pool.Alloc(i, &alive);
+		for (U64 i = 0; i < items.size(); ++i)
+			ZE_CHECK(items.at(i)->Value == i);
+		pool.Clear();
+		ZE_CHECK(alive == 0);
+
+		// Random pattern of allocations crossing slab boundaries
+		items.clear();
+		std::mt19937 engine(1);
+		for (U32 i = 0; i < 200000; ++i)
+		{
+			if (items.empty() || engine() % 3)
+				items.emplace_back(pool.Alloc(i, &alive));
+			else
+			{
+				const U64 index = engine() % items.size();
+				pool.Free(items.at(index));
+				items.at(index) = items.back();
+				items.pop_back();
+			}
+		}
+		ZE_CHECK(alive == static_cast<S32>(items.size()));
+
+		// Moved pool takes ownership of all items, source can be still used
+		Allocator::Pool<Tracked> movedPool(std::move(pool));
+		for (Tracked* item : items)
+			movedPool.Free(item);
+		ZE_CHECK(alive == 0);
+		Tracked* item = pool.Alloc(1, &alive);
+		pool.Free(item);
+
+		items.clear();
+		for (U64 i = 0; i < 1000; ++i)
+			items.emplace_back(movedPool.Alloc(i, &alive));
+		pool = std::move(movedPool);
+		for (U64 i = 0; i < 500; ++i)
+			pool.Free(items.at(i));
+		ZE_CHECK(alive == 500);
+	}
+	// Remaining items destroyed only once by the owning pool
+	ZE_CHECK(alive == 0);
+
+	std::printf("Pool tests passed\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#include "TestUtils.h"
+#include "ThreadPool.h"
+#include <numeric>
+#include <ranges>
+
+using namespace ZE;
+
+// Element which size is not power of two
+struct Element12
+{
+	U32 X, Y, Z;
+};
+
+int main()
+{
+	// Fixed number of workers so jobs are always processed concurrently, regardless of the machine
+	ThreadPool pool;
+	pool.Init(0, 4);
+
+	// Every element visited exactly once with explicit grain
+	std::vector<UA32> visits(1000);
+	pool.ParallelFor(std::views::iota(0U, Utils::SafeCast<U32>(visits.size())), 1, [&](U32 i) { visits.at(i).fetch_add(1, std::memory_order_relaxed); });
+	for (const UA32& visit : visits)
+		ZE_CHECK(visit == 1);
+
+	// Automatic chunks for elements that don't divide cache line
+	std::vector<Element12> elements(100003);
+	pool.ParallelFor(elements, 0, [](Element12& e) { e.X = 1; e.Z = 2; });
+	for (const Element12& e : elements)
+		ZE_CHECK(e.X == 1 && e.Y == 0 && e.Z == 2);
+
+	const U64 sum = pool.ParallelReduce(std::views::iota(0U, 100000U), 0, static_cast<U64>(0),
+		[](U64& value, U32 i) { value += i; }, [](U64& value, U64 partial) { value += partial; });
+	ZE_CHECK(sum == 99999ULL * 100000ULL / 2);
+
+	// Counters on the stack are destroyed right after waiting, every job have to finish accessing them before
+	for (U32 i = 0; i < 10000; ++i)
+	{
+		UA64 processed = 0;
+		pool.ProcessChunks(8, ThreadPriority::Critical, [&](U64 chunk) { processed.fetch_add(chunk + 1, std::memory_order_relaxed); });
+		ZE_CHECK(processed == 36);
+	}
+
+	std::vector<Task<U64>> tasks;
+	for (U64 i = 0; i < 1000; ++i)
+		tasks.emplace_back(pool.Schedule(ThreadPriority::Normal, [](U64 x) { return x * 2; }, i));
+	U64 taskSum = 0;
+	for (Task<U64>& task : tasks)
+		taskSum += task.Get();
+	ZE_CHECK(taskSum == 999ULL * 1000ULL);
+
+	std::printf("ThreadPool tests passed\n");
+	return EXIT_SUCCESS;
+}
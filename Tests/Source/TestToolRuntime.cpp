@@ -0,0 +1,163 @@
+#include "TestUtils.h"
+#include "ToolRuntime.h"
+#include <chrono>
+
+using namespace ZE;
+
+// Image split into tiles, every pixel have to be visited exactly once
+struct Image
+{
+	U32 Width;
+	U32 Height;
+	U32 TileWidth;
+	U32 TileHeight;
+};
+
+static void CheckTiles(const ToolRuntime& runtime) noexcept
+{
+	const std::vector<Image> images = { { 200, 130, 64, 64 }, { 1, 1, 64, 64 }, { 128, 64, 64, 64 }, { 65, 3, 64, 2 }, { 7, 300, 3, 17 } };
+	std::vector<ToolTile> tiles;
+	std::vector<std::vector<UA32>> hits;
+	for (U16 i = 0; i < images.size(); ++i)
+	{
+		const Image& image = images.at(i);
+		ToolRuntime::AddTiles(tiles, image.Width, image.Height, image.TileWidth, image.TileHeight, i, Utils::SafeCast<U16>(i + 1));
+		hits.emplace_back(static_cast<U64>(image.Width) * image.Height);
+	}
+	// Empty image doesn't produce any tiles
+	const U64 tilesCount = tiles.size();
+	ToolRuntime::AddTiles(tiles, 0, 10);
+	ZE_CHECK(tiles.size() == tilesCount);
+
+	runtime.ForEachTile(tiles, [&](const ToolTile& tile)
+		{
+			const Image& image = images.at(tile.Slice);
+			ZE_CHECK(tile.Level == tile.Slice + 1);
+			ZE_CHECK(tile.Width && tile.Width <= image.TileWidth && tile.X + tile.Width <= image.Width);
+			ZE_CHECK(tile.Height && tile.Height <= image.TileHeight && tile.Y + tile.Height <= image.Height);
+			for (U32 y = tile.Y; y < tile.Y + tile.Height; ++y)
+				for (U32 x = tile.X; x < tile.X + tile.Width; ++x)
+					hits.at(tile.Slice).at(static_cast<U64>(y) * image.Width + x).fetch_add(1, std::memory_order_relaxed);
+		});
+	for (const auto& imageHits : hits)
+		for (const UA32& hit : imageHits)
+			ZE_CHECK(hit == 1);
+}
+
+static void CheckBatch(const ToolRuntime& runtime) noexcept
+{
+	// Paths of dependent files are written differently but point to the same location
+	const std::vector<ToolJobFiles> jobs =
+	{
+		{ { "src/a.png" }, { "dir/../out/a.dds" } },
+		// Read after write of job 0
+		{ { "./out/a.dds" }, { "out/b.dds" } },
+		{ { "src/c.png" }, { "out//c.dds" } },
+		// Write after write of job 2
+		{ { "src/d.png" }, { "out/c.dds" } },
+		{ { "src/e.png" }, { "out/e.dds" } },
+		// Write after read of job 4
+		{ { "src/f.png" }, { "src/../src/e.png" } },
+		// Independent of every other job
+		{ { "src/g.png" }, { "out/g.dds" } },
+		// Write after read of job 0 and read after write of job 5
+		{ { "src/e.png" }, { "src/a.png" } },
+	};
+	const std::vector<std::vector<U64>> dependencies = { {}, { 0 }, {}, { 2 }, {}, { 4 }, {}, { 0, 5 } };
+
+	UA32 sequence = 0;
+	std::vector<U32> starts(jobs.size()), finishes(jobs.size());
+	ZE_CHECK(runtime.RunBatch(jobs, [&](U64 i) -> int
+		{
+			starts.at(i) = sequence.fetch_add(1);
+			// Jobs split their own work into tiles on the same pool
+			std::vector<ToolTile> tiles;
+			ToolRuntime::AddTiles(tiles, 256, 256, 16, 16);
+			UA64 pixels = 0;
+			runtime.ForEachTile(tiles, [&](const ToolTile& tile) { pixels.fetch_add(tile.Width * tile.Height, std::memory_order_relaxed); });
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			finishes.at(i) = sequence.fetch_add(1);
+			return pixels == 256 * 256 ? 0 : -1;
+		}) == 0);
+
+	for (U64 i = 0; i < jobs.size(); ++i)
+		for (U64 dependency : dependencies.at(i))
+			ZE_CHECK(starts.at(i) > finishes.at(dependency));
+	// Independent jobs are run in first group so they don't wait for jobs with dependencies
+	ZE_CHECK(finishes.at(6) < starts.at(1) && finishes.at(4) < starts.at(3));
+
+	// First failed job in batch order is reported even when it finishes later than other failing ones,
+	// jobs depending on failed group are never started
+	UA32 laterCalls = 0;
+	ZE_CHECK(runtime.RunBatch(jobs, [&](U64 i) -> int
+		{
+			switch (i)
+			{
+			case 2:
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				return -7;
+			}
+			case 4:
+				return -3;
+			case 1:
+			case 3:
+			case 5:
+			case 7:
+			{
+				laterCalls.fetch_add(1);
+				return -5;
+			}
+			default:
+				return 0;
+			}
+		}) == -7);
+	ZE_CHECK(laterCalls == 0);
+
+	// Failure in later group after successful ones
+	ZE_CHECK(runtime.RunBatch(jobs, [](U64 i) { return i == 7 ? 2 : 0; }) == 2);
+	ZE_CHECK(runtime.RunBatch({}, [](U64) { return -1; }) == 0);
+}
+
+int main()
+{
+	// Single core creates no workers so all work is done inline on calling thread
+	for (U32 cores : { 0U, 1U })
+	{
+		ToolRuntime runtime(cores);
+		ZE_CHECK(runtime.GetThreadsCount() == 1);
+
+		const std::thread::id caller = std::this_thread::get_id();
+		U64 visited = 0;
+		runtime.ForEach(100, [&](U64 i)
+			{
+				ZE_CHECK(std::this_thread::get_id() == caller);
+				ZE_CHECK(i == visited++);
+			});
+		ZE_CHECK(visited == 100);
+
+		std::vector<U64> order;
+		ZE_CHECK(runtime.RunBatch({ { { "a" }, { "b" } }, { { "c" }, { "d" } } }, [&](U64 i)
+			{
+				ZE_CHECK(std::this_thread::get_id() == caller);
+				order.emplace_back(i);
+				return 0;
+			}) == 0);
+		ZE_CHECK(order.size() == 2 && order.front() == 0 && order.back() == 1);
+
+		CheckTiles(runtime);
+		CheckBatch(runtime);
+	}
+
+	// Multiple workers run tiles and independent jobs concurrently
+	for (U32 cores : { 2U, 4U, 8U })
+	{
+		ToolRuntime runtime(cores);
+		ZE_CHECK(runtime.GetThreadsCount() == cores);
+		CheckTiles(runtime);
+		CheckBatch(runtime);
+	}
+
+	std::printf("Tool runtime tests passed\n");
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
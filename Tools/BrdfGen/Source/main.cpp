@@ -1,5 +1,6 @@
 #include "GFX/Surface.h"
 #include "CmdParser.h"
+#include "ToolRuntime.h"
 #include "json.hpp"
 
 namespace json = nlohmann;
@@ -12,8 +13,17 @@ enum ResultCode : int
 	CannotSaveFile = -2
 };
 
-ResultCode ProcessJsonCommand(const json::json& command) noexcept;
-ResultCode RunJob(std::string_view output, U32 size, U32 samples, U32 cores, bool fp16) noexcept;
+struct LutParams
+{
+	std::string_view Output = "";
+	U32 Size = 1024;
+	U32 Samples = 2048;
+	U32 Cores = 1;
+	bool Fp16 = false;
+};
+
+ResultCode ProcessJsonCommand(const json::json& command, LutParams& params) noexcept;
+ResultCode RunJob(const LutParams& params, const ToolRuntime& runtime) noexcept;
 
 int main(int argc, char* argv[])
 {
@@ -26,6 +36,9 @@ int main(int argc, char* argv[])
 	parser.AddString("json", "", 'j');
 	parser.Parse(argc, argv);
 
+	// Jobs from JSON batch file are run together with the one from command line, JSON data have to outlive them
+	std::vector<LutParams> jobs;
+	json::json jsonArray;
 	std::string_view json = parser.GetString("json");
 	if (!json.empty())
 	{
@@ -37,126 +50,117 @@ int main(int argc, char* argv[])
 		}
 		else
 		{
-			json::json jsonArray;
 			fin >> jsonArray;
-			ResultCode retCode = ResultCode::Success;
 			if (jsonArray.is_array())
 			{
 				for (const auto& item : jsonArray)
 				{
-					retCode = ProcessJsonCommand(item);
+					ResultCode retCode = ProcessJsonCommand(item, jobs.emplace_back());
 					if (retCode != ResultCode::Success)
 						return retCode;
 				}
 			}
 			else
-				retCode = ProcessJsonCommand(jsonArray);
-			if (retCode != ResultCode::Success)
-				return retCode;
+			{
+				ResultCode retCode = ProcessJsonCommand(jsonArray, jobs.emplace_back());
+				if (retCode != ResultCode::Success)
+					return retCode;
+			}
 		}
 	}
 
-	std::string_view output = parser.GetString("out");
-	if (output.empty())
+	LutParams params = {};
+	params.Output = parser.GetString("out");
+	if (params.Output.empty())
 	{
-		if (!json.empty())
-			return ResultCode::Success;
-		Logger::Error("No output file specified to generate LUT!");
-		return ResultCode::NoOutputFile;
+		if (json.empty())
+		{
+			Logger::Error("No output file specified to generate LUT!");
+			return ResultCode::NoOutputFile;
+		}
+	}
+	else
+	{
+		params.Fp16 = parser.GetOption("fp16");
+		params.Size = parser.GetNumber("size");
+		params.Samples = parser.GetNumber("samples");
+		params.Cores = parser.GetNumber("cores");
+		jobs.emplace_back(params);
 	}
 
-	bool fp16 = parser.GetOption("fp16");
-	U32 size = parser.GetNumber("size");
-	U32 samples = parser.GetNumber("samples");
 	U32 cores = parser.GetNumber("cores");
+	std::vector<ToolJobFiles> jobFiles;
+	jobFiles.reserve(jobs.size());
+	for (const LutParams& job : jobs)
+	{
+		cores = std::max(cores, job.Cores);
+		jobFiles.push_back({ {}, { job.Output } });
+	}
 
-	return RunJob(output, size, samples, cores, fp16);
+	ToolRuntime runtime(cores);
+	return runtime.RunBatch(jobFiles, [&](U64 i) { return RunJob(jobs.at(i), runtime); });
 }
 
-ResultCode ProcessJsonCommand(const json::json& command) noexcept
+ResultCode ProcessJsonCommand(const json::json& command, LutParams& params) noexcept
 {
-	std::string_view output = "";
 	if (command.contains("out"))
-		output = command["out"].get<std::string_view>();
+		params.Output = command["out"].get<std::string_view>();
 	else
 	{
 		Logger::Error("JSON command missing required \"out\" parameter!");
 		return ResultCode::NoOutputFile;
 	}
 
-	bool fp16 = false;
 	if (command.contains("fp16"))
-		fp16 = command["fp16"].get<bool>();
-	U32 size = 1024;
+		params.Fp16 = command["fp16"].get<bool>();
 	if (command.contains("size"))
-		size = command["size"].get<U32>();
-	U32 samples = 2048;
+		params.Size = command["size"].get<U32>();
 	if (command.contains("samples"))
-		samples = command["samples"].get<U32>();
-	U32 cores = 1;
+		params.Samples = command["samples"].get<U32>();
 	if (command.contains("cores"))
-		cores = command["cores"].get<U32>();
-
-	return RunJob(output, size, samples, cores, fp16);
+		params.Cores = command["cores"].get<U32>();
+	return ResultCode::Success;
 }
 
-ResultCode RunJob(std::string_view output, U32 size, U32 samples, U32 cores, bool fp16) noexcept
+ResultCode RunJob(const LutParams& params, const ToolRuntime& runtime) noexcept
 {
-	Logger::InfoNoFile("Building BRDF LUT [" + std::to_string(size) + "x" + std::to_string(size) + "], "
-		+ std::to_string(samples) + " samples, " + (fp16 ? "16 bit" : "32 bit") + ", output file: " + std::string(output));
+	Logger::InfoNoFile("Building BRDF LUT [" + std::to_string(params.Size) + "x" + std::to_string(params.Size) + "], "
+		+ std::to_string(params.Samples) + " samples, " + (params.Fp16 ? "16 bit" : "32 bit") + ", output file: " + std::string(params.Output));
 
-	GFX::Surface lut(size, size, fp16 ? PixelFormat::R16G16_Float : PixelFormat::R32G32_Float);
+	GFX::Surface lut(params.Size, params.Size, params.Fp16 ? PixelFormat::R16G16_Float : PixelFormat::R32G32_Float);
 
-	const float step = 1.0f / static_cast<float>(size);
+	const float step = 1.0f / static_cast<float>(params.Size);
 	const U32 rowSize = lut.GetRowByteSize();
 	U8* image = lut.GetBuffer();
 
-	auto brdfGen = [step, rowSize, samples, fp16](U32 begin, U32 end, U32 size, U8* image)
+	std::vector<ToolTile> tiles;
+	ToolRuntime::AddTiles(tiles, params.Size, params.Size);
+	runtime.ForEachTile(tiles, [&](const ToolTile& tile)
 		{
-			for (U32 y = begin; y < end; ++y)
+			for (U32 y = tile.Y; y < tile.Y + tile.Height; ++y)
 			{
-				for (U32 x = 0; x < size; ++x)
+				U8* row = image + static_cast<U64>(y) * rowSize;
+				for (U32 x = tile.X; x < tile.X + tile.Width; ++x)
 				{
 					const float NdotV = (static_cast<float>(x) + 0.5f) * step;
 					const float roughness = (static_cast<float>(y) + 0.5f) * step;
-					Float2 sample = Math::Light::IntegrateBRDF(NdotV, roughness, samples);
+					Float2 sample = Math::Light::IntegrateBRDF(NdotV, roughness, params.Samples);
 
-					if (fp16)
+					if (params.Fp16)
 					{
 						U32 packedValue = Math::FP16::EncodeFloat16(sample.x);
 						packedValue |= static_cast<U32>(Math::FP16::EncodeFloat16(sample.y)) << 16;
-						reinterpret_cast<U32*>(image)[x] = packedValue;
+						reinterpret_cast<U32*>(row)[x] = packedValue;
 					}
 					else
-						reinterpret_cast<Float2*>(image)[x] = sample;
+						reinterpret_cast<Float2*>(row)[x] = sample;
 				}
-				image += rowSize;
 			}
-		};
-
-	if (cores > 1)
-	{
-		cores = std::clamp(cores, 2U, size);
-		U32 jobRowCount = size / cores;
-		--cores;
-		std::vector<std::thread> workers;
-		workers.reserve(cores);
-		for (U32 i = 0; i < cores; ++i)
-		{
-			U32 jobOffset = i * jobRowCount;
-			workers.emplace_back(brdfGen, jobOffset, jobOffset + jobRowCount, size, image);
-			image += jobRowCount * rowSize;
-		}
-		brdfGen(jobRowCount * cores, size, size, image);
-		for (auto& worker : workers)
-			worker.join();
-	}
-	else
-		brdfGen(0, size, size, image);
+		});
 
-	if (!lut.Save(output))
+	if (!lut.Save(params.Output))
 	{
-		Logger::Error("Cannot save BRDF LUT to file \"" + std::string(output) + "\"!");
+		Logger::Error("Cannot save BRDF LUT to file \"" + std::string(params.Output) + "\"!");
 		return ResultCode::CannotSaveFile;
 	}
 	return ResultCode::Success;
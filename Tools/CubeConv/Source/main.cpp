@@ -1,5 +1,6 @@
 #include "GFX/Surface.h"
 #include "CmdParser.h"
+#include "ToolRuntime.h"
 #include "json.hpp"
 
 namespace json = nlohmann;
@@ -15,6 +16,13 @@ enum ResultCode : int
 	NotCubemap = -5,
 };
 
+// Number of spherical harmonics coefficients up to order 3 (SH9)
+constexpr U8 SH_COEFFICIENTS_COUNT = 9;
+// Number of samples processed at once during prefiltering
+constexpr U32 PREFILTER_BATCH_SIZE = 8;
+// Number of source rows summed together during SH projection
+constexpr U32 SH_PROJECTION_BAND_ROWS = 16;
+
 struct ConvolutionParams
 {
 	std::string_view OutputFile = "";
@@ -22,16 +30,48 @@ struct ConvolutionParams
 	bool Fp16 = false;
 	bool Specular = false;
 	bool SampleMipAdjst = false;
+	bool SphericalHarmonics = false;
+	bool SHCoefficients = false;
 	float SampleDelta = 0.025f;
 	U32 SamplesCount = 1024;
 	U32 Cores = 1;
 	U32 ConvolutionSize = 0;
 };
 
-ResultCode ProcessJsonCommand(const json::json& command) noexcept;
-ResultCode RunJob(ConvolutionParams& params) noexcept;
-void ConvoluteIrradiance(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, ConvolutionParams& params) noexcept;
-void ConvolutePrefiltered(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, ConvolutionParams& params) noexcept;
+// Source cubemap decoded to floats, every mip level holds all 6 faces one after another
+struct PrefilterSource
+{
+	U32 Size = 0;
+	std::vector<std::vector<Float4>> Mips;
+};
+
+// GGX samples for single roughness in tangent space (normal along Z), only ones with positive NdotL are kept.
+// Padded with zero weight samples to multiple of PREFILTER_BATCH_SIZE
+struct PrefilterSamples
+{
+	std::vector<float> DirX;
+	std::vector<float> DirY;
+	std::vector<float> DirZ;
+	std::vector<float> Weight;
+	std::vector<float> SourceMip;
+	float TotalWeight = 0.0f;
+};
+
+ResultCode ProcessJsonCommand(const json::json& command, ConvolutionParams& params) noexcept;
+ResultCode RunJob(ConvolutionParams& params, const ToolRuntime& runtime) noexcept;
+void ConvoluteIrradiance(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, const ConvolutionParams& params, const ToolRuntime& runtime) noexcept;
+// Decodes all source mips when sampling with mip adjustment, otherwise only first one
+PrefilterSource DecodePrefilterSource(const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, bool sampleMips) noexcept;
+PrefilterSamples GetPrefilterSamples(float roughness, const PrefilterSource& source, const ConvolutionParams& params) noexcept;
+// Bilinear lookup inside single face, coords are clamped to the edges of the face
+Vector SampleBilinear(const PrefilterSource& source, U16 mip, U32 face, float u, float v) noexcept;
+void ConvolutePrefiltered(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, const ConvolutionParams& params, const ToolRuntime& runtime) noexcept;
+// Real spherical harmonics basis up to order 3 for given normalized direction
+std::array<float, SH_COEFFICIENTS_COUNT> GetSHBasis(const Vector& direction) noexcept;
+// Projects whole cubemap onto SH9 basis and convolves it with clamped cosine lobe, so irradiance is just dot product with the basis.
+// Coefficients are scaled the same way as output of sampled convolution (irradiance divided by PI)
+std::array<Float4, SH_COEFFICIENTS_COUNT> ProjectIrradianceSH(const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, const ToolRuntime& runtime) noexcept;
+void EvaluateIrradianceSH(GFX::Surface& convolution, const std::array<Float4, SH_COEFFICIENTS_COUNT>& coefficients, const ToolRuntime& runtime) noexcept;
 
 int main(int argc, char* argv[])
 {
@@ -39,9 +79,12 @@ int main(int argc, char* argv[])
 	parser.AddOption("fp16");
 	parser.AddOption("specular");
 	parser.AddOption("sample-mip-adjst");
+	parser.AddOption("sh");
+	parser.AddOption("sh-coeffs");
 	parser.AddOption("help-sample-delta");
 	parser.AddOption("help-samples-count");
 	parser.AddOption("help-sample-mip-adjst");
+	parser.AddOption("help-sh");
 	parser.AddFloat("sample-delta", 0.025f, 'd');
 	parser.AddNumber("samples-count", 1024);
 	parser.AddNumber("cores", 1, 'c');
@@ -83,6 +126,20 @@ int main(int argc, char* argv[])
 		return ResultCode::Success;
 	}
 
+	if (parser.GetOption("help-sh"))
+	{
+		Logger::InfoNoFile("Cubemap irradiance spherical harmonics help:");
+		Logger::InfoNoFile("  With <sh> option source cubemap is projected once onto 9 spherical harmonics coefficients (order 3)");
+		Logger::InfoNoFile("  and irradiance is evaluated from them analytically, which is much faster than sampling the hemisphere per texel.");
+		Logger::InfoNoFile("  With <sh-coeffs> option only coefficients are saved as 9x1 R32G32B32A32_Float texture in the order of");
+		Logger::InfoNoFile("  (l, m) = (0, 0), (1, -1), (1, 0), (1, 1), (2, -2), (2, -1), (2, 0), (2, 1), (2, 2), already convolved with cosine lobe.");
+		Logger::InfoNoFile("  Not used when <specular> option is specified.");
+		return ResultCode::Success;
+	}
+
+	// Jobs from JSON batch file are run together with the one from command line, JSON data have to outlive them
+	std::vector<ConvolutionParams> jobs;
+	json::json jsonArray;
 	std::string_view json = parser.GetString("json");
 	if (!json.empty())
 	{
@@ -94,22 +151,22 @@ int main(int argc, char* argv[])
 		}
 		else
 		{
-			json::json jsonArray;
 			fin >> jsonArray;
-			ResultCode retCode = ResultCode::Success;
 			if (jsonArray.is_array())
 			{
 				for (const auto& item : jsonArray)
 				{
-					retCode = ProcessJsonCommand(item);
+					ResultCode retCode = ProcessJsonCommand(item, jobs.emplace_back());
 					if (retCode != ResultCode::Success)
 						return retCode;
 				}
 			}
 			else
-				retCode = ProcessJsonCommand(jsonArray);
-			if (retCode != ResultCode::Success)
-				return retCode;
+			{
+				ResultCode retCode = ProcessJsonCommand(jsonArray, jobs.emplace_back());
+				if (retCode != ResultCode::Success)
+					return retCode;
+			}
 		}
 	}
 
@@ -117,70 +174,92 @@ int main(int argc, char* argv[])
 	params.OutputFile = parser.GetString("out");
 	if (params.OutputFile.empty())
 	{
-		if (!json.empty())
-			return ResultCode::Success;
-		Logger::Error("No output file specified for cubemap convolution!");
-		return ResultCode::NoOutputFile;
+		if (json.empty())
+		{
+			Logger::Error("No output file specified for cubemap convolution!");
+			return ResultCode::NoOutputFile;
+		}
 	}
-
-	std::string_view source = parser.GetString("source");
-	if (source.empty())
+	else
 	{
-		bool hasAllFaces = true, anyFace = false;
-		params.SourceFiles.reserve(6);
-		anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-px")).empty();
-		anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-nx")).empty();
-		anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-py")).empty();
-		anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-ny")).empty();
-		anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-pz")).empty();
-		anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-nz")).empty();
-
-		for (const auto& face : params.SourceFiles)
+		std::string_view source = parser.GetString("source");
+		if (source.empty())
 		{
-			if (face.empty())
+			bool hasAllFaces = true, anyFace = false;
+			params.SourceFiles.reserve(6);
+			anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-px")).empty();
+			anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-nx")).empty();
+			anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-py")).empty();
+			anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-ny")).empty();
+			anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-pz")).empty();
+			anyFace |= !params.SourceFiles.emplace_back(parser.GetString("source-nz")).empty();
+
+			for (const auto& face : params.SourceFiles)
+			{
+				if (face.empty())
+				{
+					hasAllFaces = false;
+					break;
+				}
+			}
+
+			if (!hasAllFaces)
 			{
-				hasAllFaces = false;
-				break;
+				if (anyFace)
+				{
+					Logger::Error("Not all faces specified for cubemap to convolute!");
+					return ResultCode::NoSourceFile;
+				}
+				if (json.empty())
+				{
+					Logger::Error("No source cubemap specified to convolute!");
+					return ResultCode::NoSourceFile;
+				}
+				params.SourceFiles.clear();
 			}
 		}
+		else
+			params.SourceFiles.emplace_back(source);
 
-		if (!hasAllFaces)
+		if (params.SourceFiles.size())
 		{
-			if (anyFace)
-				Logger::Error("Not all faces specified for cubemap to convolute!");
-			else if (!json.empty())
-				return ResultCode::Success;
-			else
-				Logger::Error("No source cubemap specified to convolute!");
-			return ResultCode::NoSourceFile;
+			params.Fp16 = parser.GetOption("fp16");
+			params.Specular = parser.GetOption("specular");
+			params.SampleMipAdjst = parser.GetOption("sample-mip-adjst");
+			params.SphericalHarmonics = parser.GetOption("sh");
+			params.SHCoefficients = parser.GetOption("sh-coeffs");
+			params.SampleDelta = parser.GetFloat("sample-delta");
+			params.SamplesCount = parser.GetNumber("samples-count");
+			params.Cores = parser.GetNumber("cores");
+			params.ConvolutionSize = parser.GetNumber("resize");
+			jobs.emplace_back(params);
 		}
 	}
-	else
-		params.SourceFiles.emplace_back(source);
 
-	params.Fp16 = parser.GetOption("fp16");
-	params.Specular = parser.GetOption("specular");
-	params.SampleMipAdjst = parser.GetOption("sample-mip-adjst");
-	params.SampleDelta = parser.GetFloat("sample-delta");
-	params.SamplesCount = parser.GetNumber("samples-count");
-	params.Cores = parser.GetNumber("cores");
-	params.ConvolutionSize = parser.GetNumber("resize");
+	U32 cores = parser.GetNumber("cores");
+	std::vector<ToolJobFiles> jobFiles;
+	jobFiles.reserve(jobs.size());
+	for (const ConvolutionParams& job : jobs)
+	{
+		cores = std::max(cores, job.Cores);
+		jobFiles.push_back({ job.SourceFiles, { job.OutputFile } });
+	}
 
-	return RunJob(params);
+	ToolRuntime runtime(cores);
+	return runtime.RunBatch(jobFiles, [&](U64 i) { return RunJob(jobs.at(i), runtime); });
 }
 
-ResultCode ProcessJsonCommand(const json::json& command) noexcept
+ResultCode ProcessJsonCommand(const json::json& command, ConvolutionParams& params) noexcept
 {
-	std::string_view output = "";
 	if (command.contains("out"))
-		output = command["out"].get<std::string_view>();
+		params.OutputFile = command["out"].get<std::string_view>();
 	else
 	{
 		Logger::Error("JSON command missing required \"out\" parameter!");
 		return ResultCode::NoOutputFile;
 	}
 
-	std::vector<std::string_view> sourceArray;
+	std::vector<std::string_view>& sourceArray = params.SourceFiles;
 	if (command.contains("source"))
 		sourceArray.emplace_back(command["source"].get<std::string_view>());
 	else
@@ -220,13 +299,16 @@ ResultCode ProcessJsonCommand(const json::json& command) noexcept
 		}
 	}
 
-	ConvolutionParams params = {};
 	if (command.contains("fp16"))
 		params.Fp16 = command["fp16"].get<bool>();
 	if (command.contains("specular"))
 		params.Specular = command["specular"].get<bool>();
 	if (command.contains("sample-mip-adjst"))
 		params.SampleMipAdjst = command["sample-mip-adjst"].get<bool>();
+	if (command.contains("sh"))
+		params.SphericalHarmonics = command["sh"].get<bool>();
+	if (command.contains("sh-coeffs"))
+		params.SHCoefficients = command["sh-coeffs"].get<bool>();
 	if (command.contains("sample-delta"))
 		params.SampleDelta = command["sample-delta"].get<float>();
 	if (command.contains("samples-count"))
@@ -235,11 +317,10 @@ ResultCode ProcessJsonCommand(const json::json& command) noexcept
 		params.Cores = command["cores"].get<U32>();
 	if (command.contains("resize"))
 		params.ConvolutionSize = command["resize"].get<U32>();
-
-	return RunJob(params);
+	return ResultCode::Success;
 }
 
-ResultCode RunJob(ConvolutionParams& params) noexcept
+ResultCode RunJob(ConvolutionParams& params, const ToolRuntime& runtime) noexcept
 {
 	if (params.SampleDelta <= FLT_EPSILON)
 	{
@@ -353,12 +434,28 @@ ResultCode RunJob(ConvolutionParams& params) noexcept
 	if (params.Specular)
 		mipLevels = Math::GetMipLevels(params.ConvolutionSize, params.ConvolutionSize);
 
-	GFX::Surface convolution(params.ConvolutionSize, params.ConvolutionSize, 1, mipLevels, 6, format, false);
-
+	GFX::Surface convolution;
 	if (params.Specular)
-		ConvolutePrefiltered(convolution, faces, cubemap, params);
+	{
+		convolution = GFX::Surface(params.ConvolutionSize, params.ConvolutionSize, 1, mipLevels, 6, format, false);
+		ConvolutePrefiltered(convolution, faces, cubemap, params, runtime);
+	}
+	else if (params.SphericalHarmonics || params.SHCoefficients)
+	{
+		const std::array<Float4, SH_COEFFICIENTS_COUNT> coefficients = ProjectIrradianceSH(faces, cubemap, runtime);
+		if (params.SHCoefficients)
+			convolution = GFX::Surface(SH_COEFFICIENTS_COUNT, 1, PixelFormat::R32G32B32A32_Float, coefficients.data());
+		else
+		{
+			convolution = GFX::Surface(params.ConvolutionSize, params.ConvolutionSize, 1, mipLevels, 6, format, false);
+			EvaluateIrradianceSH(convolution, coefficients, runtime);
+		}
+	}
 	else
-		ConvoluteIrradiance(convolution, faces, cubemap, params);
+	{
+		convolution = GFX::Surface(params.ConvolutionSize, params.ConvolutionSize, 1, mipLevels, 6, format, false);
+		ConvoluteIrradiance(convolution, faces, cubemap, params, runtime);
+	}
 
 	if (!convolution.Save(params.OutputFile))
 	{
@@ -368,10 +465,9 @@ ResultCode RunJob(ConvolutionParams& params) noexcept
 	return ResultCode::Success;
 }
 
-void ConvoluteIrradiance(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, ConvolutionParams& params) noexcept
+void ConvoluteIrradiance(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, const ConvolutionParams& params, const ToolRuntime& runtime) noexcept
 {
 	const bool convFp16 = Utils::GetChannelSize(convolution.GetFormat()) == 2;
-	const U64 sliceSize = convolution.GetSliceByteSize();
 	const U32 rowSize = convolution.GetRowByteSize();
 	const U8 pixelSize = convolution.GetPixelSize();
 
@@ -382,346 +478,518 @@ void ConvoluteIrradiance(GFX::Surface& convolution, const std::vector<U8*>& face
 
 	const Vector up = Math::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
 
-	auto convolute = [&](U8* image, U16 begin, U16 end, U32 beginRow, U32 endRow)
+	auto convolute = [&](const ToolTile& tile)
 		{
-			for (U16 a = begin; a < end; ++a)
+			U8* image = convolution.GetImage(tile.Slice, 0, 0);
+			const Math::CubemapFaceTraversalDesc& faceDesc = Math::CUBEMAP_FACES_INFO.at(tile.Slice);
+			const Vector faceStart = Math::XMLoadFloat3(&faceDesc.StartPos);
+			const Vector xDir = Math::XMLoadFloat3(&faceDesc.DirX);
+			const Vector yDir = Math::XMLoadFloat3(&faceDesc.DirY);
+
+			for (U32 y = tile.Y; y < tile.Y + tile.Height; ++y)
 			{
-				const Math::CubemapFaceTraversalDesc& faceDesc = Math::CUBEMAP_FACES_INFO.at(a);
-				const Vector faceStart = Math::XMLoadFloat3(&faceDesc.StartPos);
-				const Vector xDir = Math::XMLoadFloat3(&faceDesc.DirX);
-				const Vector yDir = Math::XMLoadFloat3(&faceDesc.DirY);
+				const Vector yScale = Math::XMVectorReplicate((static_cast<float>(y) + 0.5f) / static_cast<float>(params.ConvolutionSize));
+				const Vector rowPos = Math::XMVectorMultiplyAdd(yDir, yScale, faceStart);
 
-				for (U32 y = a == begin ? beginRow : 0, rows = a == end - 1 ? endRow : params.ConvolutionSize; y < rows; ++y)
+				for (U32 x = tile.X; x < tile.X + tile.Width; ++x)
 				{
-					const Vector yScale = Math::XMVectorReplicate((static_cast<float>(y) + 0.5f) / static_cast<float>(params.ConvolutionSize));
-					const Vector rowPos = Math::XMVectorMultiplyAdd(yDir, yScale, faceStart);
+					const Vector xScale = Math::XMVectorReplicate((static_cast<float>(x) + 0.5f) / static_cast<float>(params.ConvolutionSize));
+					const Vector hemisphereNormal = Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(xDir, xScale, rowPos));
+					Vector tan = Math::XMVector3Normalize(Math::XMVector3Cross(up, hemisphereNormal));
+					const Vector bitan = Math::XMVector3Normalize(Math::XMVector3Cross(hemisphereNormal, tan));
+					tan = Math::XMVector3Normalize(Math::XMVector3Cross(bitan, hemisphereNormal));
 
-					for (U32 x = 0; x < params.ConvolutionSize; ++x)
-					{
-						const Vector xScale = Math::XMVectorReplicate((static_cast<float>(x) + 0.5f) / static_cast<float>(params.ConvolutionSize));
-						const Vector hemisphereNormal = Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(xDir, xScale, rowPos));
-						Vector tan = Math::XMVector3Normalize(Math::XMVector3Cross(up, hemisphereNormal));
-						const Vector bitan = Math::XMVector3Normalize(Math::XMVector3Cross(hemisphereNormal, tan));
-						tan = Math::XMVector3Normalize(Math::XMVector3Cross(bitan, hemisphereNormal));
-
-						U64 samples = 0;
-						Vector irradiance = { 0.0f, 0.0f, 0.0f, 0.0f };
+					U64 samples = 0;
+					Vector irradiance = { 0.0f, 0.0f, 0.0f, 0.0f };
 
-						for (float phi = 0.0f; phi < Math::PI2; phi += params.SampleDelta)
+					for (float phi = 0.0f; phi < Math::PI2; phi += params.SampleDelta)
+					{
+						const float phiSin = std::sinf(phi);
+						const float phiCos = std::cosf(phi);
+						for (float theta = params.SampleDelta; theta < static_cast<float>(M_PI_2); theta += params.SampleDelta)
 						{
-							const float phiSin = std::sinf(phi);
-							const float phiCos = std::cosf(phi);
-							for (float theta = params.SampleDelta; theta < static_cast<float>(M_PI_2); theta += params.SampleDelta)
+							// Spherical to cartesian in tangent space
+							const float thetaSin = std::sinf(theta);
+							const float thetaCos = std::cosf(theta);
+							if (thetaSin == 0.0f || thetaCos == 0.0f)
+								continue;
+
+							// Tangent space to world
+							const Vector sampleDir = Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(tan, Math::XMVectorReplicate(thetaSin * phiCos),
+								Math::XMVectorMultiplyAdd(bitan, Math::XMVectorReplicate(thetaSin * phiSin),
+									Math::XMVectorMultiply(hemisphereNormal, Math::XMVectorReplicate(thetaCos)))));
+
+							UInt3 sampledFace = Math::SampleCubemap(sampleDir, cubemapSize);
+							U8* sampleFace = faces.at(sampledFace.Z);
+
+							Vector sample = {};
+							const U64 sampleOffset = static_cast<U64>(sampledFace.Y) * cubemapRowSize + static_cast<U64>(sampledFace.X) * cubemapPixelSize;
+							if (cubemapFp16)
 							{
-								// Spherical to cartesian in tangent space
-								const float thetaSin = std::sinf(theta);
-								const float thetaCos = std::cosf(theta);
-								if (thetaSin == 0.0f || thetaCos == 0.0f)
-									continue;
-
-								// Tangent space to world
-								const Vector sampleDir = Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(tan, Math::XMVectorReplicate(thetaSin * phiCos),
-									Math::XMVectorMultiplyAdd(bitan, Math::XMVectorReplicate(thetaSin * phiSin),
-										Math::XMVectorMultiply(hemisphereNormal, Math::XMVectorReplicate(thetaCos)))));
-
-								UInt3 sampledFace = Math::SampleCubemap(sampleDir, cubemapSize);
-								U8* sampleFace = faces.at(sampledFace.Z);
-
-								Vector sample = {};
-								const U64 sampleOffset = static_cast<U64>(sampledFace.Y) * cubemapRowSize + static_cast<U64>(sampledFace.X) * cubemapPixelSize;
-								if (cubemapFp16)
-								{
-									sample = Math::XMVectorSet(
-										Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset)),
-										Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset + 2)),
-										Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset + 4)),
-										0.0f);
-								}
-								else
-									sample = Math::XMLoadFloat3(reinterpret_cast<Float3*>(sampleFace + sampleOffset)); // Alpha can be ignored since only RGB is important
-
-								irradiance = Math::XMVectorMultiplyAdd(sample, Math::XMVectorReplicate(thetaSin * thetaCos), irradiance);
-								++samples;
+								sample = Math::XMVectorSet(
+									Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset)),
+									Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset + 2)),
+									Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset + 4)),
+									0.0f);
 							}
+							else
+								sample = Math::XMLoadFloat3(reinterpret_cast<Float3*>(sampleFace + sampleOffset)); // Alpha can be ignored since only RGB is important
+
+							irradiance = Math::XMVectorMultiplyAdd(sample, Math::XMVectorReplicate(thetaSin * thetaCos), irradiance);
+							++samples;
 						}
+					}
 
-						irradiance = Math::XMVectorMultiply(irradiance, Math::XMVectorReplicate(Math::PI / static_cast<float>(samples)));
+					irradiance = Math::XMVectorMultiply(irradiance, Math::XMVectorReplicate(Math::PI / static_cast<float>(samples)));
 
-						const U64 convolutionOffset = Utils::SafeCast<U64>(y) * rowSize + Utils::SafeCast<U64>(x) * pixelSize;
-						if (convFp16)
-						{
-							*reinterpret_cast<U16*>(image + convolutionOffset) = Math::FP16::EncodeFloat16(Math::XMVectorGetX(irradiance));
-							*reinterpret_cast<U16*>(image + convolutionOffset + 2) = Math::FP16::EncodeFloat16(Math::XMVectorGetY(irradiance));
-							*reinterpret_cast<U16*>(image + convolutionOffset + 4) = Math::FP16::EncodeFloat16(Math::XMVectorGetZ(irradiance));
-							*reinterpret_cast<U16*>(image + convolutionOffset + 6) = Math::FP16::EncodeFloat16(0.0f);
-						}
-						else
-							Math::XMStoreFloat3(reinterpret_cast<Float3*>(image + convolutionOffset), irradiance);
+					const U64 convolutionOffset = Utils::SafeCast<U64>(y) * rowSize + Utils::SafeCast<U64>(x) * pixelSize;
+					if (convFp16)
+					{
+						*reinterpret_cast<U16*>(image + convolutionOffset) = Math::FP16::EncodeFloat16(Math::XMVectorGetX(irradiance));
+						*reinterpret_cast<U16*>(image + convolutionOffset + 2) = Math::FP16::EncodeFloat16(Math::XMVectorGetY(irradiance));
+						*reinterpret_cast<U16*>(image + convolutionOffset + 4) = Math::FP16::EncodeFloat16(Math::XMVectorGetZ(irradiance));
+						*reinterpret_cast<U16*>(image + convolutionOffset + 6) = Math::FP16::EncodeFloat16(0.0f);
 					}
+					else
+						Math::XMStoreFloat3(reinterpret_cast<Float3*>(image + convolutionOffset), irradiance);
 				}
-				image += sliceSize;
 			}
 		};
 
-	U8* convolutionBuffer = convolution.GetBuffer();
-	if (params.Cores > 1)
+	std::vector<ToolTile> tiles;
+	for (U16 face = 0; face < 6; ++face)
+		ToolRuntime::AddTiles(tiles, params.ConvolutionSize, params.ConvolutionSize, ToolRuntime::DEFAULT_TILE_SIZE, ToolRuntime::DEFAULT_TILE_SIZE, face);
+	runtime.ForEachTile(tiles, convolute);
+}
+
+PrefilterSource DecodePrefilterSource(const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, bool sampleMips) noexcept
+{
+	const PixelFormat cubemapFormat = cubemap.front().GetFormat();
+	const bool cubemapFp16 = Utils::GetChannelSize(cubemapFormat) == 2;
+	const U32 cubemapPixelSize = cubemap.front().GetPixelSize();
+
+	PrefilterSource source;
+	source.Size = cubemap.front().GetWidth();
+	source.Mips.resize(sampleMips ? cubemap.front().GetMipCount() : 1);
+	for (U16 mip = 0; mip < source.Mips.size(); ++mip)
 	{
-		const U32 jobsCount = params.ConvolutionSize * 6;
-		params.Cores = std::clamp(params.Cores, 2U, jobsCount);
-		const U32 batchSize = jobsCount / params.Cores;
-		--params.Cores;
-
-		U16 arrayOffset = 0;
-		U32 rowOffset = 0;
-		std::vector<std::thread> workers;
-		workers.reserve(params.Cores);
-		for (U32 i = 0; i < params.Cores; ++i)
+		const U32 mipSize = std::max(source.Size >> mip, 1U);
+		const U32 rowSize = cubemap.front().GetRowByteSize(mip);
+		const U64 mipOffset = GFX::Surface::GetMipOffset(source.Size, source.Size, 1, cubemapFormat, mip, 0);
+
+		std::vector<Float4>& texels = source.Mips.at(mip);
+		texels.resize(static_cast<U64>(mipSize) * mipSize * 6);
+		Float4* destination = texels.data();
+		for (U8 face = 0; face < 6; ++face)
 		{
-			U16 arrayCount = 1;
-			U32 rowCount = batchSize;
-			while (rowCount > params.ConvolutionSize)
+			for (U32 y = 0; y < mipSize; ++y)
 			{
-				++arrayCount;
-				rowCount -= params.ConvolutionSize;
-			}
-			rowCount += rowOffset;
-			if (rowCount > params.ConvolutionSize)
-			{
-				++arrayCount;
-				rowCount -= params.ConvolutionSize;
+				const U8* row = faces.at(face) + mipOffset + static_cast<U64>(y) * rowSize;
+				for (U32 x = 0; x < mipSize; ++x, ++destination)
+				{
+					const U8* texel = row + static_cast<U64>(x) * cubemapPixelSize;
+					if (cubemapFp16)
+					{
+						*destination =
+						{
+							Math::FP16::DecodeFloat16(*reinterpret_cast<const U16*>(texel)),
+							Math::FP16::DecodeFloat16(*reinterpret_cast<const U16*>(texel + 2)),
+							Math::FP16::DecodeFloat16(*reinterpret_cast<const U16*>(texel + 4)),
+							0.0f
+						};
+					}
+					else
+					{
+						// Alpha can be ignored since only RGB is important
+						const Float3& color = *reinterpret_cast<const Float3*>(texel);
+						*destination = { color.x, color.y, color.z, 0.0f };
+					}
+				}
 			}
+		}
+	}
+	return source;
+}
 
-			workers.emplace_back(convolute, convolutionBuffer, arrayOffset, static_cast<U16>(arrayOffset + arrayCount), rowOffset, rowCount);
+PrefilterSamples GetPrefilterSamples(float roughness, const PrefilterSource& source, const ConvolutionParams& params) noexcept
+{
+	PrefilterSamples samples;
+	auto addSample = [&samples](float x, float y, float z, float weight, float sourceMip)
+		{
+			samples.DirX.emplace_back(x);
+			samples.DirY.emplace_back(y);
+			samples.DirZ.emplace_back(z);
+			samples.Weight.emplace_back(weight);
+			samples.SourceMip.emplace_back(sourceMip);
+			samples.TotalWeight += weight;
+		};
 
-			if (rowCount == params.ConvolutionSize)
-				rowCount = 0;
-			else
-				--arrayCount;
-			convolutionBuffer += arrayCount * sliceSize;
-			arrayOffset += arrayCount;
-			rowOffset = rowCount;
+	// Without roughness every sample is reflected along the normal
+	if (roughness == 0.0f)
+		addSample(0.0f, 0.0f, 1.0f, 1.0f, 0.0f);
+	else
+	{
+		const Vector normal = Math::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+		const Vector tan = Math::XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+		const Vector bitan = Math::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+		const float maxMip = static_cast<float>(source.Mips.size() - 1);
+		for (U32 i = 0; i < params.SamplesCount; ++i)
+		{
+			const Float2 Xi = Math::Light::HammersleySequence(i, params.SamplesCount);
+			const Vector H = Math::Light::ImportanceSampleGGX(Xi, roughness, normal, tan, bitan);
+			const float NdotH = std::max(Math::XMVectorGetZ(H), 0.0f);
+			Float3 L = {};
+			Math::XMStoreFloat3(&L, Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(Math::XMVectorReplicate(2.0f * NdotH), H, Math::XMVectorNegate(normal))));
+
+			if (L.z > 0.0f)
+			{
+				float sourceMip = 0.0f;
+				if (params.SampleMipAdjst)
+				{
+					const float pdf = (Math::Light::GeometrySchlickGGX(NdotH, roughness) * 0.25f) + 0.0001f;
+					const float mipLevel = 0.5f * std::log2((3.0f * static_cast<float>(source.Size * source.Size)) / (Math::PI2 * (static_cast<float>(params.SamplesCount) * pdf + 0.0001f)));
+					sourceMip = std::clamp(mipLevel, 0.0f, maxMip);
+				}
+				addSample(L.x, L.y, L.z, L.z, sourceMip);
+			}
 		}
-		convolute(convolutionBuffer, arrayOffset, 6, rowOffset, params.ConvolutionSize);
-		for (auto& worker : workers)
-			worker.join();
 	}
-	else
-		convolute(convolutionBuffer, 0, 6, 0, params.ConvolutionSize);
+
+	// Padding samples along the normal don't contribute to the result
+	while (samples.Weight.size() % PREFILTER_BATCH_SIZE)
+		addSample(0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+	return samples;
 }
 
-void ConvolutePrefiltered(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, ConvolutionParams& params) noexcept
+Vector SampleBilinear(const PrefilterSource& source, U16 mip, U32 face, float u, float v) noexcept
+{
+	const U32 size = std::max(source.Size >> mip, 1U);
+	const float x = u * static_cast<float>(size) - 0.5f;
+	const float y = v * static_cast<float>(size) - 0.5f;
+	const float xFloor = std::floor(x);
+	const float yFloor = std::floor(y);
+
+	const S32 maxCoord = static_cast<S32>(size - 1);
+	const S32 left = std::clamp(static_cast<S32>(xFloor), 0, maxCoord);
+	const S32 right = std::clamp(static_cast<S32>(xFloor) + 1, 0, maxCoord);
+	const S32 top = std::clamp(static_cast<S32>(yFloor), 0, maxCoord);
+	const S32 bottom = std::clamp(static_cast<S32>(yFloor) + 1, 0, maxCoord);
+
+	const Float4* faceTexels = source.Mips.at(mip).data() + static_cast<U64>(face) * size * size;
+	const Float4* topRow = faceTexels + static_cast<U64>(top) * size;
+	const Float4* bottomRow = faceTexels + static_cast<U64>(bottom) * size;
+
+	const Vector upper = Math::XMVectorLerp(Math::XMLoadFloat4(topRow + left), Math::XMLoadFloat4(topRow + right), x - xFloor);
+	const Vector lower = Math::XMVectorLerp(Math::XMLoadFloat4(bottomRow + left), Math::XMLoadFloat4(bottomRow + right), x - xFloor);
+	return Math::XMVectorLerp(upper, lower, y - yFloor);
+}
+
+void ConvolutePrefiltered(GFX::Surface& convolution, const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, const ConvolutionParams& params, const ToolRuntime& runtime) noexcept
 {
 	const bool convFp16 = Utils::GetChannelSize(convolution.GetFormat()) == 2;
 	const U8 pixelSize = convolution.GetPixelSize();
 	const U16 mipLevels = convolution.GetMipCount();
 
-	const PixelFormat cubemapFormat = cubemap.front().GetFormat();
-	const bool cubemapFp16 = Utils::GetChannelSize(cubemapFormat) == 2;
-	const U32 cubemapSize = cubemap.front().GetWidth();
-	const U32 cubemapRowSize = cubemap.front().GetRowByteSize();
-	const U32 cubemapPixelSize = cubemap.front().GetPixelSize();
-	const U16 cubemapMipLevels = cubemap.front().GetMipCount();
+	// Samples depend only on roughness so they are computed once per mip and rotated into frame of every texel
+	const PrefilterSource source = DecodePrefilterSource(faces, cubemap, params.SampleMipAdjst);
+	std::vector<PrefilterSamples> mipSamples;
+	mipSamples.reserve(mipLevels);
+	for (U16 mip = 0; mip < mipLevels; ++mip)
+		mipSamples.emplace_back(GetPrefilterSamples(static_cast<float>(mip) / static_cast<float>(std::max(mipLevels - 1U, 1U)), source, params));
 
-	auto convolute = [&](U16 startMip, U16 mipCount, U32 startRow, U32 rowCount)
+	auto convolute = [&](const ToolTile& tile)
 		{
-			U8* convolutionBuffer = convolution.GetBuffer();
-			for (U16 a = 0; a < 6; ++a)
-			{
-				const Math::CubemapFaceTraversalDesc& faceDesc = Math::CUBEMAP_FACES_INFO.at(a);
-				const Vector faceStart = Math::XMLoadFloat3(&faceDesc.StartPos);
-				const Vector xDir = Math::XMLoadFloat3(&faceDesc.DirX);
-				const Vector yDir = Math::XMLoadFloat3(&faceDesc.DirY);
-
-				for (U16 mip = startMip, endMip = startMip + mipCount; mip < endMip; ++mip)
-				{
-					if (mipCount == 1)
-						convolutionBuffer = convolution.GetImage(a, mip, 0);
+			U8* convolutionBuffer = convolution.GetImage(tile.Slice, tile.Level, 0);
+			const Math::CubemapFaceTraversalDesc& faceDesc = Math::CUBEMAP_FACES_INFO.at(tile.Slice);
+			const Vector faceStart = Math::XMLoadFloat3(&faceDesc.StartPos);
+			const Vector xDir = Math::XMLoadFloat3(&faceDesc.DirX);
+			const Vector yDir = Math::XMLoadFloat3(&faceDesc.DirY);
 
-					const float roughness = static_cast<float>(mip) / static_cast<float>(std::max(mipLevels - 1U, 1U));
-					const U64 sliceSize = convolution.GetSliceByteSize(mip);
-					const U32 rowSize = convolution.GetRowByteSize(mip);
+			const PrefilterSamples& samples = mipSamples.at(tile.Level);
+			const U32 rowSize = convolution.GetRowByteSize(tile.Level);
+			const U32 mipWidth = std::max(params.ConvolutionSize >> tile.Level, 1U);
 
-					const U32 mipWidth = std::max(params.ConvolutionSize >> mip, 1U);
-					const U32 mipHeight = mipCount == 1 ? startRow + rowCount : mipWidth;
+			for (U32 y = tile.Y; y < tile.Y + tile.Height; ++y)
+			{
+				const Vector yScale = Math::XMVectorReplicate((static_cast<float>(y) + 0.5f) / static_cast<float>(mipWidth));
+				const Vector rowPos = Math::XMVectorMultiplyAdd(yDir, yScale, faceStart);
 
-					for (U32 y = startRow; y < mipHeight; ++y)
+				for (U32 x = tile.X; x < tile.X + tile.Width; ++x)
+				{
+					const Vector xScale = Math::XMVectorReplicate((static_cast<float>(x) + 0.5f) / static_cast<float>(mipWidth));
+					const Vector direction = Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(xDir, xScale, rowPos));
+
+					// Same tangent frame as used by Math::Light::ImportanceSampleGGX()
+					const Vector up = std::abs(Math::XMVectorGetZ(direction)) < 0.999f ? Math::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : Math::XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+					const Vector tanVec = Math::XMVector3Normalize(Math::XMVector3Cross(up, direction));
+					Float3 tan = {}, bitan = {}, normal = {};
+					Math::XMStoreFloat3(&tan, tanVec);
+					Math::XMStoreFloat3(&bitan, Math::XMVector3Cross(direction, tanVec));
+					Math::XMStoreFloat3(&normal, direction);
+
+					Vector prefilteredColor = Math::XMVectorZero();
+					for (U64 i = 0; i < samples.Weight.size(); i += PREFILTER_BATCH_SIZE)
 					{
-						const Vector yScale = Math::XMVectorReplicate((static_cast<float>(y) + 0.5f) / static_cast<float>(mipWidth));
-						const Vector rowPos = Math::XMVectorMultiplyAdd(yDir, yScale, faceStart);
-
-						for (U32 x = 0; x < mipWidth; ++x)
-						{
-							const Vector xScale = Math::XMVectorReplicate((static_cast<float>(x) + 0.5f) / static_cast<float>(mipWidth));
-							const Vector direction = Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(xDir, xScale, rowPos));
-
-							Vector prefilteredColor = { 0.0f, 0.0f, 0.0f, 0.0f };
-							float totalWeight = 0.0f;
-							for (U32 i = 0; i < params.SamplesCount; ++i)
+						// Find face and UV for whole batch of samples at once
+						std::array<U32, PREFILTER_BATCH_SIZE> sampleFaces;
+						std::array<float, PREFILTER_BATCH_SIZE> sampleU, sampleV;
+#if __AVX2__
+						const __m256 localX = _mm256_loadu_ps(samples.DirX.data() + i);
+						const __m256 localY = _mm256_loadu_ps(samples.DirY.data() + i);
+						const __m256 localZ = _mm256_loadu_ps(samples.DirZ.data() + i);
+						auto toWorld = [&](float tanAxis, float bitanAxis, float normalAxis)
 							{
-								// L direction wrong in x
-								const Float2 Xi = Math::Light::HammersleySequence(i, params.SamplesCount);
-								const Vector H = Math::Light::ImportanceSampleGGX(Xi, roughness, direction);
-								const Vector NdotH = Math::XMVectorMax(Math::XMVector3Dot(direction, H), Math::XMVectorZero());
-								const Vector L = Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(Math::XMVectorReplicate(2.0f),
-									Math::XMVectorMultiply(NdotH, H), Math::XMVectorNegate(direction)));
-
-								const Vector NdotL = Math::XMVectorMax(Math::XMVector3Dot(direction, L), Math::XMVectorZero());
-								const float weight = Math::XMVectorGetX(NdotL);
-								if (weight > 0.0f)
-								{
-									Vector sample = {};
-									if (params.SampleMipAdjst && roughness != 0.0f)
-									{
-										U32 faceIndex = UINT32_MAX;
-										const Float2 sampleUV = Math::SampleCubemapUV(L, faceIndex);
-
-										const float pdf = (Math::Light::GeometrySchlickGGX(Math::XMVectorGetX(NdotH), roughness) * 0.25f) + 0.0001f;
-										const float mipLevel = 0.5f * std::log2((3.0f * static_cast<float>(cubemapSize * cubemapSize)) / (Math::PI2 * (static_cast<float>(params.SamplesCount) * pdf + 0.0001f)));
-
-										float mipIntegral = 0.0f;
-										const float factor = std::modf(mipLevel, &mipIntegral);
-										const U16 lowerMip = std::min(Utils::SafeCast<U16>(mipIntegral), cubemapMipLevels);
-										const U16 higherMip = std::min<U16>(lowerMip + 1U, cubemapMipLevels);
-
-										const U32 lowSize = std::max(cubemapSize >> lowerMip, 1U);
-										const UInt2 lowSampleCoord = { Utils::SafeCast<U32>(sampleUV.x * static_cast<float>(lowSize)), Utils::SafeCast<U32>(sampleUV.y * static_cast<float>(lowSize)) };
-
-										const U32 lowByteSize = cubemap.front().GetRowByteSize(lowerMip);
-										const U64 lowOffset = static_cast<U64>(lowSampleCoord.Y) * lowByteSize + static_cast<U64>(lowSampleCoord.X) * cubemapPixelSize;
-										U8* lowSampleFace = faces.at(faceIndex) + GFX::Surface::GetMipOffset(cubemapSize, cubemapSize, 1, cubemapFormat, lowerMip, 0);
-
-										Vector lowSample = {};
-										if (cubemapFp16)
-										{
-											lowSample = Math::XMVectorSet(
-												Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(lowSampleFace + lowOffset)),
-												Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(lowSampleFace + lowOffset + 2)),
-												Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(lowSampleFace + lowOffset + 4)),
-												0.0f);
-										}
-										else
-											lowSample = Math::XMLoadFloat3(reinterpret_cast<Float3*>(lowSampleFace + lowOffset));
-
-										if (lowerMip == higherMip)
-											sample = lowSample;
-										else
-										{
-											const U32 highSize = std::max(cubemapSize >> higherMip, 1U);
-											const UInt2 highSampleCoord = { Utils::SafeCast<U32>(sampleUV.x * static_cast<float>(highSize)), Utils::SafeCast<U32>(sampleUV.y * static_cast<float>(highSize)) };
-
-											const U32 highByteSize = cubemap.front().GetRowByteSize(higherMip);
-											const U64 highOffset = static_cast<U64>(highSampleCoord.Y) * highByteSize + static_cast<U64>(highSampleCoord.X) * cubemapPixelSize;
-											U8* highSampleFace = lowSampleFace + GFX::Surface::GetSliceByteSize(cubemapSize, cubemapSize, cubemapFormat, higherMip);
-
-											Vector highSample = {};
-											if (cubemapFp16)
-											{
-												highSample = Math::XMVectorSet(
-													Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(highSampleFace + highOffset)),
-													Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(highSampleFace + highOffset + 2)),
-													Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(highSampleFace + highOffset + 4)),
-													0.0f);
-											}
-											else
-												highSample = Math::XMLoadFloat3(reinterpret_cast<Float3*>(highSampleFace + highOffset));
-
-											sample = Math::XMVectorLerp(lowSample, highSample, factor);
-										}
-									}
-									else
-									{
-										UInt3 sampledFace = Math::SampleCubemap(L, cubemapSize);
-										U8* sampleFace = faces.at(sampledFace.Z);
-
-										const U64 sampleOffset = static_cast<U64>(sampledFace.Y) * cubemapRowSize + static_cast<U64>(sampledFace.X) * cubemapPixelSize;
-										if (cubemapFp16)
-										{
-											sample = Math::XMVectorSet(
-												Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset)),
-												Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset + 2)),
-												Math::FP16::DecodeFloat16(*reinterpret_cast<U16*>(sampleFace + sampleOffset + 4)),
-												0.0f);
-										}
-										else
-											sample = Math::XMLoadFloat3(reinterpret_cast<Float3*>(sampleFace + sampleOffset)); // Alpha can be ignored since only RGB is important
-									}
-
-									prefilteredColor = Math::XMVectorMultiplyAdd(sample, NdotL, prefilteredColor);
-									totalWeight += weight;
-								}
-							}
-
-							prefilteredColor = Math::XMVectorDivide(prefilteredColor, Math::XMVectorReplicate(totalWeight));
-
-							const U64 convolutionOffset = Utils::SafeCast<U64>(y) * rowSize + Utils::SafeCast<U64>(x) * pixelSize;
-							if (convFp16)
+								return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(localX, _mm256_set1_ps(tanAxis)),
+									_mm256_mul_ps(localY, _mm256_set1_ps(bitanAxis))), _mm256_mul_ps(localZ, _mm256_set1_ps(normalAxis)));
+							};
+						const __m256 sampleX = toWorld(tan.x, bitan.x, normal.x);
+						const __m256 sampleY = toWorld(tan.y, bitan.y, normal.y);
+						const __m256 sampleZ = toWorld(tan.z, bitan.z, normal.z);
+
+						// Same face selection as in Math::SampleCubemapUV()
+						const __m256 signMask = _mm256_set1_ps(-0.0f);
+						const __m256 absX = _mm256_andnot_ps(signMask, sampleX);
+						const __m256 absY = _mm256_andnot_ps(signMask, sampleY);
+						const __m256 absZ = _mm256_andnot_ps(signMask, sampleZ);
+						const __m256 majorY = _mm256_and_ps(_mm256_cmp_ps(absY, absX, _CMP_GE_OQ), _mm256_cmp_ps(absY, absZ, _CMP_GE_OQ));
+						const __m256 majorX = _mm256_andnot_ps(majorY, _mm256_and_ps(_mm256_cmp_ps(absX, absY, _CMP_GE_OQ), _mm256_cmp_ps(absX, absZ, _CMP_GE_OQ)));
+						const __m256 negativeX = _mm256_cmp_ps(sampleX, _mm256_setzero_ps(), _CMP_LT_OQ);
+						const __m256 negativeY = _mm256_cmp_ps(sampleY, _mm256_setzero_ps(), _CMP_LT_OQ);
+						const __m256 negativeZ = _mm256_cmp_ps(sampleZ, _mm256_setzero_ps(), _CMP_LT_OQ);
+
+						__m256 coordX = _mm256_blendv_ps(sampleX, _mm256_xor_ps(sampleX, signMask), negativeZ);
+						coordX = _mm256_blendv_ps(coordX, _mm256_blendv_ps(_mm256_xor_ps(sampleZ, signMask), sampleZ, negativeX), majorX);
+						coordX = _mm256_blendv_ps(coordX, sampleX, majorY);
+						const __m256 coordY = _mm256_blendv_ps(_mm256_xor_ps(sampleY, signMask), _mm256_blendv_ps(sampleZ, _mm256_xor_ps(sampleZ, signMask), negativeY), majorY);
+
+						const __m256 majorAxis = _mm256_blendv_ps(_mm256_blendv_ps(absZ, absX, majorX), absY, majorY);
+						const __m256 uvFactor = _mm256_div_ps(_mm256_set1_ps(0.5f), majorAxis);
+						_mm256_storeu_ps(sampleU.data(), _mm256_add_ps(_mm256_mul_ps(coordX, uvFactor), _mm256_set1_ps(0.5f)));
+						_mm256_storeu_ps(sampleV.data(), _mm256_add_ps(_mm256_mul_ps(coordY, uvFactor), _mm256_set1_ps(0.5f)));
+
+						// Faces ordered as +X, -X, +Y, -Y, +Z, -Z
+						const __m256 faceBase = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_set1_ps(4.0f), _mm256_setzero_ps(), majorX), _mm256_set1_ps(2.0f), majorY);
+						const __m256 negativeAxis = _mm256_blendv_ps(_mm256_blendv_ps(negativeZ, negativeX, majorX), negativeY, majorY);
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(sampleFaces.data()), _mm256_cvttps_epi32(_mm256_add_ps(faceBase, _mm256_and_ps(negativeAxis, _mm256_set1_ps(1.0f)))));
+#else
+						for (U32 j = 0; j < PREFILTER_BATCH_SIZE; ++j)
+						{
+							const float localX = samples.DirX.at(i + j);
+							const float localY = samples.DirY.at(i + j);
+							const float localZ = samples.DirZ.at(i + j);
+							const Vector L = Math::XMVectorSet(tan.x * localX + bitan.x * localY + normal.x * localZ,
+								tan.y * localX + bitan.y * localY + normal.y * localZ,
+								tan.z * localX + bitan.z * localY + normal.z * localZ, 0.0f);
+
+							const Float2 uv = Math::SampleCubemapUV(L, sampleFaces.at(j));
+							sampleU.at(j) = uv.x;
+							sampleV.at(j) = uv.y;
+						}
+#endif
+						for (U32 j = 0; j < PREFILTER_BATCH_SIZE; ++j)
+						{
+							const float weight = samples.Weight.at(i + j);
+							if (weight > 0.0f)
 							{
-								*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset) = Math::FP16::EncodeFloat16(Math::XMVectorGetX(prefilteredColor));
-								*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset + 2) = Math::FP16::EncodeFloat16(Math::XMVectorGetY(prefilteredColor));
-								*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset + 4) = Math::FP16::EncodeFloat16(Math::XMVectorGetZ(prefilteredColor));
-								*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset + 6) = Math::FP16::EncodeFloat16(0.0f);
+								const float sourceMip = samples.SourceMip.at(i + j);
+								const U16 lowerMip = static_cast<U16>(sourceMip);
+								const float factor = sourceMip - static_cast<float>(lowerMip);
+
+								Vector sample = SampleBilinear(source, lowerMip, sampleFaces.at(j), sampleU.at(j), sampleV.at(j));
+								if (factor > 0.0f)
+									sample = Math::XMVectorLerp(sample, SampleBilinear(source, lowerMip + 1, sampleFaces.at(j), sampleU.at(j), sampleV.at(j)), factor);
+								prefilteredColor = Math::XMVectorMultiplyAdd(sample, Math::XMVectorReplicate(weight), prefilteredColor);
 							}
-							else
-								Math::XMStoreFloat3(reinterpret_cast<Float3*>(convolutionBuffer + convolutionOffset), prefilteredColor);
 						}
 					}
 
-					if (mipCount != 1)
-						convolutionBuffer += sliceSize;
+					prefilteredColor = Math::XMVectorScale(prefilteredColor, 1.0f / samples.TotalWeight);
+
+					const U64 convolutionOffset = Utils::SafeCast<U64>(y) * rowSize + Utils::SafeCast<U64>(x) * pixelSize;
+					if (convFp16)
+					{
+						*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset) = Math::FP16::EncodeFloat16(Math::XMVectorGetX(prefilteredColor));
+						*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset + 2) = Math::FP16::EncodeFloat16(Math::XMVectorGetY(prefilteredColor));
+						*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset + 4) = Math::FP16::EncodeFloat16(Math::XMVectorGetZ(prefilteredColor));
+						*reinterpret_cast<U16*>(convolutionBuffer + convolutionOffset + 6) = Math::FP16::EncodeFloat16(0.0f);
+					}
+					else
+						Math::XMStoreFloat3(reinterpret_cast<Float3*>(convolutionBuffer + convolutionOffset), prefilteredColor);
 				}
 			}
 		};
 
-	if (params.Cores > 1)
-	{
-		struct ThreadTask
+	// Every mip have own precomputed samples so all of them can be processed at once, small mips are single tiles
+	std::vector<ToolTile> tiles;
+	for (U16 face = 0; face < 6; ++face)
+		for (U16 mip = 0; mip < mipLevels; ++mip)
 		{
-			U16 MipLevel;
-			U32 RowStart;
-			U32 RowCount;
-		};
+			const U32 mipSize = std::max(params.ConvolutionSize >> mip, 1U);
+			ToolRuntime::AddTiles(tiles, mipSize, mipSize, ToolRuntime::DEFAULT_TILE_SIZE, ToolRuntime::DEFAULT_TILE_SIZE, face, mip);
+		}
+	runtime.ForEachTile(tiles, convolute);
+}
 
-		std::vector<ThreadTask> tasks;
-		for (U16 mip = 0; mip < mipLevels; ++mip)
+std::array<float, SH_COEFFICIENTS_COUNT> GetSHBasis(const Vector& direction) noexcept
+{
+	const float x = Math::XMVectorGetX(direction);
+	const float y = Math::XMVectorGetY(direction);
+	const float z = Math::XMVectorGetZ(direction);
+	return
+	{
+		0.282095f,
+		0.488603f * y,
+		0.488603f * z,
+		0.488603f * x,
+		1.092548f * x * y,
+		1.092548f * y * z,
+		0.315392f * (3.0f * z * z - 1.0f),
+		1.092548f * x * z,
+		0.546274f * (x * x - y * y)
+	};
+}
+
+std::array<Float4, SH_COEFFICIENTS_COUNT> ProjectIrradianceSH(const std::vector<U8*>& faces, const std::vector<GFX::Surface>& cubemap, const ToolRuntime& runtime) noexcept
+{
+	const bool cubemapFp16 = Utils::GetChannelSize(cubemap.front().GetFormat()) == 2;
+	const U32 cubemapSize = cubemap.front().GetWidth();
+	const U32 cubemapRowSize = cubemap.front().GetRowByteSize();
+	const U32 cubemapPixelSize = cubemap.front().GetPixelSize();
+	const float texelArea = 1.0f / static_cast<float>(cubemapSize * cubemapSize);
+
+	// Every band of rows across all faces is summed separately, doubles keep precision over millions of texels.
+	// Bands are combined in order afterwards so result doesn't depend on number of threads
+	struct ProjectionSums
+	{
+		std::array<double, SH_COEFFICIENTS_COUNT * 3> Coefficients = {};
+		double SolidAngle = 0.0;
+	};
+	const U32 rowsCount = cubemapSize * 6;
+	const U32 bandsCount = Math::DivideRoundUp(rowsCount, SH_PROJECTION_BAND_ROWS);
+	std::vector<ProjectionSums> sums(bandsCount);
+
+	auto project = [&](U64 band)
 		{
-			U32 rowCount = std::max(params.ConvolutionSize >> mip, 1U);
-			// Don't subdivide for small mips too much
-			if (rowCount < 16)
-				tasks.emplace_back(mip, 0, rowCount);
-			else
+			ProjectionSums& bandSums = sums.at(band);
+			for (U32 row = Utils::SafeCast<U32>(band) * SH_PROJECTION_BAND_ROWS, endRow = std::min(row + SH_PROJECTION_BAND_ROWS, rowsCount); row < endRow; ++row)
 			{
-				U32 mipWorkers = std::clamp(params.Cores, 1U, rowCount);
-				U32 rowsPerTask = rowCount / mipWorkers;
-				ThreadTask task = { mip, 0, rowsPerTask };
+				const U32 face = row / cubemapSize;
+				const U32 y = row % cubemapSize;
+				const Math::CubemapFaceTraversalDesc& faceDesc = Math::CUBEMAP_FACES_INFO.at(face);
+				const Vector xDir = Math::XMLoadFloat3(&faceDesc.DirX);
+				const Vector yScale = Math::XMVectorReplicate((static_cast<float>(y) + 0.5f) / static_cast<float>(cubemapSize));
+				const Vector rowPos = Math::XMVectorMultiplyAdd(Math::XMLoadFloat3(&faceDesc.DirY), yScale, Math::XMLoadFloat3(&faceDesc.StartPos));
+				const U8* faceRow = faces.at(face) + static_cast<U64>(y) * cubemapRowSize;
 
-				while (rowCount > rowsPerTask)
+				for (U32 x = 0; x < cubemapSize; ++x)
 				{
-					tasks.emplace_back(task);
-					task.RowStart += rowsPerTask;
-					rowCount -= rowsPerTask;
+					const Vector xScale = Math::XMVectorReplicate((static_cast<float>(x) + 0.5f) / static_cast<float>(cubemapSize));
+					const Vector texelPos = Math::XMVectorMultiplyAdd(xDir, xScale, rowPos);
+
+					// Texel area projected onto unit sphere, faces of the cube lie at distance 0.5 from the center
+					const float invLength = Math::XMVectorGetX(Math::XMVector3ReciprocalLength(texelPos));
+					const float solidAngle = texelArea * 0.5f * invLength * invLength * invLength;
+					const std::array<float, SH_COEFFICIENTS_COUNT> basis = GetSHBasis(Math::XMVectorScale(texelPos, invLength));
+
+					const U8* texel = faceRow + static_cast<U64>(x) * cubemapPixelSize;
+					Float3 sample = {};
+					if (cubemapFp16)
+					{
+						sample.x = Math::FP16::DecodeFloat16(*reinterpret_cast<const U16*>(texel));
+						sample.y = Math::FP16::DecodeFloat16(*reinterpret_cast<const U16*>(texel + 2));
+						sample.z = Math::FP16::DecodeFloat16(*reinterpret_cast<const U16*>(texel + 4));
+					}
+					else
+						sample = *reinterpret_cast<const Float3*>(texel);
+
+					for (U8 i = 0; i < SH_COEFFICIENTS_COUNT; ++i)
+					{
+						const double weight = static_cast<double>(basis.at(i) * solidAngle);
+						bandSums.Coefficients.at(i * 3) += weight * sample.x;
+						bandSums.Coefficients.at(i * 3 + 1) += weight * sample.y;
+						bandSums.Coefficients.at(i * 3 + 2) += weight * sample.z;
+					}
+					bandSums.SolidAngle += solidAngle;
 				}
-				task.RowCount = rowCount;
-				tasks.emplace_back(task);
 			}
-		}
+		};
 
-		std::vector<std::thread> workers;
-		workers.reserve(params.Cores - 1);
-		auto workerFunc = [&](U32 id)
+	runtime.ForEach(bandsCount, project);
+
+	ProjectionSums total = {};
+	for (const ProjectionSums& bandSums : sums)
+	{
+		for (U8 i = 0; i < SH_COEFFICIENTS_COUNT * 3; ++i)
+			total.Coefficients.at(i) += bandSums.Coefficients.at(i);
+		total.SolidAngle += bandSums.SolidAngle;
+	}
+
+	// Texel solid angles don't sum exactly to whole sphere so they are renormalized.
+	// Convolution with cosine lobe scales bands by PI, 2PI/3 and PI/4, divided by PI like output of sampled convolution
+	constexpr std::array<double, 3> BAND_SCALES = { 1.0, 2.0 / 3.0, 0.25 };
+	const double sphereScale = 4.0 * M_PI / total.SolidAngle;
+	std::array<Float4, SH_COEFFICIENTS_COUNT> coefficients = {};
+	for (U8 i = 0; i < SH_COEFFICIENTS_COUNT; ++i)
+	{
+		const double scale = sphereScale * BAND_SCALES.at(i == 0 ? 0 : (i < 4 ? 1 : 2));
+		coefficients.at(i) =
+		{
+			static_cast<float>(total.Coefficients.at(i * 3) * scale),
+			static_cast<float>(total.Coefficients.at(i * 3 + 1) * scale),
+			static_cast<float>(total.Coefficients.at(i * 3 + 2) * scale),
+			0.0f
+		};
+	}
+	return coefficients;
+}
+
+void EvaluateIrradianceSH(GFX::Surface& convolution, const std::array<Float4, SH_COEFFICIENTS_COUNT>& coefficients, const ToolRuntime& runtime) noexcept
+{
+	const bool convFp16 = Utils::GetChannelSize(convolution.GetFormat()) == 2;
+	const U32 size = convolution.GetWidth();
+	const U32 rowSize = convolution.GetRowByteSize();
+	const U8 pixelSize = convolution.GetPixelSize();
+
+	auto evaluate = [&](const ToolTile& tile)
+		{
+			U8* image = convolution.GetImage(tile.Slice, 0, 0);
+			const Math::CubemapFaceTraversalDesc& faceDesc = Math::CUBEMAP_FACES_INFO.at(tile.Slice);
+			const Vector faceStart = Math::XMLoadFloat3(&faceDesc.StartPos);
+			const Vector xDir = Math::XMLoadFloat3(&faceDesc.DirX);
+			const Vector yDir = Math::XMLoadFloat3(&faceDesc.DirY);
+
+			for (U32 y = tile.Y; y < tile.Y + tile.Height; ++y)
 			{
-				for (U32 taskIdx = id; taskIdx < tasks.size(); taskIdx += params.Cores)
+				const Vector yScale = Math::XMVectorReplicate((static_cast<float>(y) + 0.5f) / static_cast<float>(size));
+				const Vector rowPos = Math::XMVectorMultiplyAdd(yDir, yScale, faceStart);
+
+				for (U32 x = tile.X; x < tile.X + tile.Width; ++x)
 				{
-					const auto& task = tasks.at(taskIdx);
-					convolute(task.MipLevel, 1, task.RowStart, task.RowCount);
+					const Vector xScale = Math::XMVectorReplicate((static_cast<float>(x) + 0.5f) / static_cast<float>(size));
+					const std::array<float, SH_COEFFICIENTS_COUNT> basis = GetSHBasis(Math::XMVector3Normalize(Math::XMVectorMultiplyAdd(xDir, xScale, rowPos)));
+
+					Vector irradiance = Math::XMVectorZero();
+					for (U8 i = 0; i < SH_COEFFICIENTS_COUNT; ++i)
+						irradiance = Math::XMVectorMultiplyAdd(Math::XMLoadFloat4(&coefficients.at(i)), Math::XMVectorReplicate(basis.at(i)), irradiance);
+					// Ringing of truncated series can produce negative values for very bright, small light sources
+					irradiance = Math::XMVectorMax(irradiance, Math::XMVectorZero());
+
+					const U64 convolutionOffset = Utils::SafeCast<U64>(y) * rowSize + Utils::SafeCast<U64>(x) * pixelSize;
+					if (convFp16)
+					{
+						*reinterpret_cast<U16*>(image + convolutionOffset) = Math::FP16::EncodeFloat16(Math::XMVectorGetX(irradiance));
+						*reinterpret_cast<U16*>(image + convolutionOffset + 2) = Math::FP16::EncodeFloat16(Math::XMVectorGetY(irradiance));
+						*reinterpret_cast<U16*>(image + convolutionOffset + 4) = Math::FP16::EncodeFloat16(Math::XMVectorGetZ(irradiance));
+						*reinterpret_cast<U16*>(image + convolutionOffset + 6) = Math::FP16::EncodeFloat16(0.0f);
+					}
+					else
+						Math::XMStoreFloat3(reinterpret_cast<Float3*>(image + convolutionOffset), irradiance);
 				}
-			};
-		for (U32 i = 1; i < params.Cores; ++i)
-			workers.emplace_back(workerFunc, i);
-		workerFunc(0);
+			}
+		};
 
-		for (auto& worker : workers)
-			worker.join();
-	}
-	else
-		convolute(0, mipLevels, 0, 0);
+	std::vector<ToolTile> tiles;
+	for (U16 face = 0; face < 6; ++face)
+		ToolRuntime::AddTiles(tiles, size, size, ToolRuntime::DEFAULT_TILE_SIZE, ToolRuntime::DEFAULT_TILE_SIZE, face);
+	runtime.ForEachTile(tiles, evaluate);
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include "MathExt.h"
+#include <vector>
+
+using namespace ZE;
+
+// Filtering used by both regular and streaming mip generation
+namespace MipFilter
+{
+	// Normalized half of symetric kernel for Kaiser, Lanczos and Gauss filters, empty for remaining ones.
+	// When filter parameter is 0 then it's set to default value for given filter
+	std::vector<float> GetCoeffs(Math::FilterType filter, U32 windowSize, float& coeffParam) noexcept;
+	// Expands symetric coefficients into taps for whole window so separable filters can be applied in 2 passes,
+	// center coefficient is repeated for even windows the same way as in Math::ApplyFilter()
+	std::vector<float> GetTaps(const std::vector<float>& coeffs, U32 windowSize) noexcept;
+
+	// Horizontal pass of separable filter, every output pixel gathers source pixels at it's precomputed column offsets
+	void FilterRow(const Float4* line, Float4* output, const U32* columnOffsets, const float* taps, U32 windowSize, U32 width) noexcept;
+	// Vertical pass of separable filter, adds weighted row of pixels to the output
+	void AccumulateRow(const Float4* row, Float4* output, float tap, U32 width) noexcept;
+}
\ No newline at end of file
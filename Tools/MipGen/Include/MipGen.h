@@ -0,0 +1,32 @@
+#pragma once
+#include "ToolRuntime.h"
+#include "MathExt.h"
+#include <string_view>
+
+using namespace ZE;
+
+enum ResultCode : int
+{
+	Success = 0,
+	NoSourceFile = -1,
+	CannotLoadFile = -2,
+	CannotSaveFile = -3,
+	CannotPerformOperation = -4,
+};
+
+struct MipParams
+{
+	std::string_view Source = "";
+	std::string_view OutFile = "";
+	U32 Cores = 1;
+	bool GammaCorrection = false;
+	bool SrcOriginalLayer = false;
+	bool Stream = false;
+	float AlphaTestTreshold = FLT_MAX;
+	float FilterCoeffParam = 0.0f;
+	U32 WindowSize = 2;
+	Math::FilterType Filter = Math::FilterType::Box;
+};
+
+// Generates all missing mips of the source texture and saves it to the output file
+ResultCode RunJob(MipParams& job, const ToolRuntime& runtime) noexcept;
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "MipFilter.h"
+#include "Intrinsics.h"
+
+namespace MipFilter
+{
+	std::vector<float> GetCoeffs(Math::FilterType filter, U32 windowSize, float& coeffParam) noexcept
+	{
+		std::vector<float> coeffs;
+		if (filter != Math::FilterType::Box && filter != Math::FilterType::GammaAverage && filter != Math::FilterType::Bilinear)
+		{
+			coeffs.resize((windowSize >> 1) + (windowSize & 1));
+			const U32 coeffSize = Utils::SafeCast<U32>(coeffs.size());
+
+			float coeffSum = 0.0f;
+			switch (filter)
+			{
+			case Math::FilterType::Kaiser:
+			{
+				if (coeffParam == 0.0f)
+					coeffParam = 7.64f;
+
+				for (U32 i = 0; i < coeffSize; ++i)
+				{
+					// Regular Kaiser window reaches 1 at length / 2 so need to scale it correctly
+					const float k = Math::Kaiser(static_cast<float>(i + coeffSize), coeffParam, static_cast<float>(coeffSize * 2));
+					coeffs.at(i) = k;
+					coeffSum += k;
+				}
+				break;
+			}
+			case Math::FilterType::Lanczos:
+			{
+				for (U32 i = 0; i < coeffSize; ++i)
+				{
+					const float l = Math::Lanczos(static_cast<float>(i), static_cast<float>(coeffSize));
+					coeffs.at(i) = l;
+					coeffSum += l;
+				}
+				break;
+			}
+			case Math::FilterType::Gauss:
+			{
+				if (coeffParam == 0.0f)
+					coeffParam = 2.6f;
+
+				for (U32 i = 0; i < coeffSize; ++i)
+				{
+					const float g = Math::Gauss(static_cast<float>(i), coeffParam);
+					coeffs.at(i) = g;
+					coeffSum += g;
+				}
+				break;
+			}
+			default:
+			break;
+			}
+
+			// Normalize filter coefficients, symetric kernel requires doubling the sum
+			// but just for even windows, odd windows have center coeff counted once
+			coeffSum *= 2.0f;
+			if (windowSize & 1)
+				coeffSum -= coeffs.front();
+
+			for (float& coeff : coeffs)
+				coeff /= coeffSum;
+		}
+		return coeffs;
+	}
+
+	std::vector<float> GetTaps(const std::vector<float>& coeffs, U32 windowSize) noexcept
+	{
+		std::vector<float> taps;
+		if (coeffs.size())
+		{
+			taps.reserve(windowSize);
+			const S32 lastCoeff = Utils::SafeCast<S32>(coeffs.size()) - 1;
+			for (S32 i = -lastCoeff; i <= lastCoeff; ++i)
+			{
+				taps.emplace_back(coeffs.at(std::abs(i)));
+				if (i == 0 && (windowSize & 1) == 0)
+					taps.emplace_back(coeffs.front());
+			}
+		}
+		return taps;
+	}
+
+	void FilterRow(const Float4* line, Float4* output, const U32* columnOffsets, const float* taps, U32 windowSize, U32 width) noexcept
+	{
+		const float* source = &line->x;
+		float* destination = &output->x;
+		U32 x = 0;
+#if __AVX2__
+		// Pair of output pixels processed at once, every tap loads 2 source pixels
+		for (; x + 1 < width; x += 2)
+		{
+			const U32* columnsA = columnOffsets + static_cast<U64>(x) * windowSize;
+			const U32* columnsB = columnsA + windowSize;
+			__m256 sum = _mm256_setzero_ps();
+			for (U32 i = 0; i < windowSize; ++i)
+			{
+				const __m256 pixels = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(source + columnsA[i] * 4)), _mm_loadu_ps(source + columnsB[i] * 4), 1);
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(pixels, _mm256_set1_ps(taps[i])));
+			}
+			_mm256_storeu_ps(destination + x * 4, sum);
+		}
+#endif
+		for (; x < width; ++x)
+		{
+			const U32* columns = columnOffsets + static_cast<U64>(x) * windowSize;
+#if __AVX2__ || __SSE2__ || _M_X64
+			__m128 sum = _mm_setzero_ps();
+			for (U32 i = 0; i < windowSize; ++i)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + columns[i] * 4), _mm_set1_ps(taps[i])));
+			_mm_storeu_ps(destination + x * 4, sum);
+#else
+			Float4 sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (U32 i = 0; i < windowSize; ++i)
+			{
+				const Float4& pixel = line[columns[i]];
+				sum.x += pixel.x * taps[i];
+				sum.y += pixel.y * taps[i];
+				sum.z += pixel.z * taps[i];
+				sum.w += pixel.w * taps[i];
+			}
+			output[x] = sum;
+#endif
+		}
+	}
+
+	void AccumulateRow(const Float4* row, Float4* output, float tap, U32 width) noexcept
+	{
+		const float* source = &row->x;
+		float* destination = &output->x;
+		const U64 count = static_cast<U64>(width) * 4;
+		U64 i = 0;
+#if __AVX2__
+		const __m256 weight = _mm256_set1_ps(tap);
+		for (; i + 8 <= count; i += 8)
+			_mm256_storeu_ps(destination + i, _mm256_add_ps(_mm256_loadu_ps(destination + i), _mm256_mul_ps(_mm256_loadu_ps(source + i), weight)));
+#endif
+#if __AVX2__ || __SSE2__ || _M_X64
+		for (; i < count; i += 4)
+			_mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(destination + i), _mm_mul_ps(_mm_loadu_ps(source + i), _mm_set1_ps(tap))));
+#else
+		for (; i < count; ++i)
+			destination[i] += source[i] * tap;
+#endif
+	}
+}
\ No newline at end of file
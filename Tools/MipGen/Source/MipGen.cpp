@@ -0,0 +1,710 @@
+#include "MipGen.h"
+#include "GFX/Surface.h"
+#include "DDS/Utils.h"
+#include "MipFilter.h"
+
+struct Sample
+{
+	union
+	{
+		S8 SInt8;
+		S16 SInt16;
+		S32 SInt32;
+		U32 UInt;
+		float Float;
+	} RGBA[4];
+};
+
+// State of single mip level generated in streaming mode
+struct StreamLevel
+{
+	U32 Width;
+	U32 Height;
+	U32 SrcWidth;
+	U32 SrcHeight;
+	U32 RowSize;
+	U32 BandRows;
+	U64 FileOffset;
+	// Source rows already passed to the level and next output row waiting for it's window to be complete
+	U32 ReceivedRows;
+	U32 NextRow;
+	// First output row currently held in the band
+	U32 BandStart;
+	std::vector<U32> ColumnOffsets;
+	std::vector<U32> WindowRows;
+	// Last source row passed to the level, converted to floats
+	std::vector<Float4> Line;
+	// Ring of horizontally filtered source rows, every row is kept at slot equal to it's index modulo window size
+	std::vector<Float4> FilteredRows;
+	std::vector<U32> FilteredRowIndices;
+	std::vector<Float4> MipRow;
+	// Output rows waiting to be written to the file
+	std::vector<U8> Band;
+};
+
+// Number of rows in single band of mip level processed as one unit of work
+constexpr U32 MIP_TILE_ROWS = 32;
+
+// Generates mips without loading whole texture, source is read in bands and every row is pushed through all mip levels at once
+ResultCode RunStreamJob(const MipParams& job, const std::vector<float>& filterTaps) noexcept;
+bool SeekFile(FILE* file, U64 offset) noexcept;
+Sample GetPixelSample(U8* memory, U8 channelSize, U8 channelCount, bool gammaCorrection) noexcept;
+Float4 ConvertToFloat(const Sample& pixel, PixelFormat format, U8 channelCount) noexcept;
+Sample ConvertToSourceFormat(const Float4& val, PixelFormat format, U8 channelCount, bool gammaCorrection) noexcept;
+void StorePixel(U8* pixelAddress, Float4 mipVal, const MipParams& job, PixelFormat format, U8 channelCount, U8 channelSize) noexcept;
+
+ResultCode RunJob(MipParams& job, const ToolRuntime& runtime) noexcept
+{
+	if (job.WindowSize < 2)
+	{
+		job.WindowSize = 2;
+		Logger::Warning("Window size cannot be less than 2, overriding specified value.");
+	}
+	else if (job.WindowSize != 2 && job.Filter == Math::FilterType::Bilinear)
+	{
+		job.WindowSize = 2;
+		Logger::Warning("Bilinear filter always uses window size of 2, overriding specified value.");
+	}
+
+	// Create filter coefficients if needed and taps for whole window used by separable filters
+	const std::vector<float> filterCoeffs = MipFilter::GetCoeffs(job.Filter, job.WindowSize, job.FilterCoeffParam);
+	const std::vector<float> filterTaps = MipFilter::GetTaps(filterCoeffs, job.WindowSize);
+
+	if (job.Stream)
+		return RunStreamJob(job, filterTaps);
+
+	GFX::Surface surface;
+	if (!surface.Load(job.Source, false, true))
+	{
+		Logger::Error("Cannot load file \"" + std::string(job.Source) + "\"!");
+		return ResultCode::CannotLoadFile;
+	}
+	if (surface.GetMipCount() == 1)
+	{
+		Logger::Error("Source texture must have at least 2 mip levels to generate missing mips!");
+		return ResultCode::CannotPerformOperation;
+	}
+
+	const U8 channelCount = Utils::GetChannelCount(surface.GetFormat());
+	const PixelFormat format = Utils::GetSingleChannelFormat(surface.GetFormat());
+	const U8 pixelSize = surface.GetPixelSize();
+	const U8 channelSize = pixelSize / channelCount;
+	const S32 halfWindow = Utils::SafeCast<S32>(job.WindowSize) >> 1;
+
+	// Generates rows in range [Y, Y + Height) of single array slice and mip level, for every depth slice
+	auto generate = [&](const ToolTile& tile)
+		{
+			// Scratch buffers for separable filters: source row converted to floats, horizontally filtered source rows
+			// (every row is filtered only once for all output rows using it) and currently accumulated output row
+			std::vector<Float4> line;
+			std::vector<Float4> filteredRows;
+			std::vector<U32> filteredRowIndices;
+			std::vector<Float4> mipRow;
+			std::vector<U32> columnOffsets;
+
+			const U16 mip = tile.Level;
+			const U16 srcMip = job.SrcOriginalLayer ? 0 : static_cast<U16>(mip - 1);
+			const U32 srcWidth = std::max(surface.GetWidth() >> srcMip, 1U);
+			const U32 srcHeight = std::max(surface.GetHeight() >> srcMip, 1U);
+			const U32 mipWidth = std::max(surface.GetWidth() >> mip, 1U);
+			const U16 mipDepth = static_cast<U16>(std::max(surface.GetDepth() >> mip, 1));
+			const U32 endRow = tile.Y + tile.Height;
+
+			const U64 srcRowSize = surface.GetRowByteSize(srcMip);
+			const U64 rowSize = surface.GetRowByteSize(mip);
+			const U32 mipDiff = 1 << (mip - srcMip);
+
+			if (filterTaps.size())
+			{
+				// Sampling points are the same for every row
+				columnOffsets.resize(static_cast<U64>(mipWidth) * job.WindowSize);
+				U32 maxColumn = 0;
+				for (U32 x = 0, i = 0; x < mipWidth; ++x)
+				{
+					const S32 baseX = Utils::SafeCast<S32>(x * mipDiff) + 1;
+					for (S32 j = -halfWindow - (job.WindowSize & 1); j < halfWindow; ++j, ++i)
+					{
+						columnOffsets.at(i) = Math::MirrorCoord(baseX + j, Utils::SafeCast<S32>(srcWidth));
+						maxColumn = std::max(maxColumn, columnOffsets.at(i));
+					}
+				}
+				line.resize(maxColumn + 1);
+				filteredRows.resize(static_cast<U64>(mipWidth) * job.WindowSize);
+				mipRow.resize(mipWidth);
+			}
+
+			for (U16 d = 0; d < mipDepth; ++d)
+			{
+				U8* srcBuffer = surface.GetImage(tile.Slice, srcMip, d);
+				U8* mipGenBuffer = surface.GetImage(tile.Slice, mip, d);
+
+				if (filterTaps.size())
+				{
+					filteredRowIndices.assign(job.WindowSize, UINT32_MAX);
+					for (U32 y = tile.Y; y < endRow; ++y)
+					{
+						std::fill(mipRow.begin(), mipRow.end(), Float4(0.0f, 0.0f, 0.0f, 0.0f));
+
+						const S32 baseY = Utils::SafeCast<S32>(y * mipDiff) + 1;
+						for (S32 i = -halfWindow - (job.WindowSize & 1), tap = 0; i < halfWindow; ++i, ++tap)
+						{
+							// Rows of the window come from continuous range so they never evict each other from the cache
+							const U32 row = Math::MirrorCoord(baseY + i, Utils::SafeCast<S32>(srcHeight));
+							const U32 slot = row % job.WindowSize;
+							Float4* filteredRow = filteredRows.data() + static_cast<U64>(slot) * mipWidth;
+							if (filteredRowIndices.at(slot) != row)
+							{
+								filteredRowIndices.at(slot) = row;
+								U8* srcRow = srcBuffer + row * srcRowSize;
+								for (U32 x = 0; x < line.size(); ++x)
+									line.at(x) = ConvertToFloat(GetPixelSample(srcRow + static_cast<U64>(x) * pixelSize, channelSize, channelCount, job.GammaCorrection), format, channelCount);
+								MipFilter::FilterRow(line.data(), filteredRow, columnOffsets.data(), filterTaps.data(), job.WindowSize, mipWidth);
+							}
+							MipFilter::AccumulateRow(filteredRow, mipRow.data(), filterTaps.at(tap), mipWidth);
+						}
+
+						U8* mipGenRow = mipGenBuffer + rowSize * y;
+						for (U32 x = 0; x < mipWidth; ++x)
+							StorePixel(mipGenRow + static_cast<U64>(x) * pixelSize, mipRow.at(x), job, format, channelCount, channelSize);
+					}
+					continue;
+				}
+
+				for (U32 y = tile.Y; y < endRow; ++y)
+				{
+					// Generate row sampling points
+					std::vector<U32> rowOffsets;
+					rowOffsets.reserve(job.WindowSize);
+
+					const S32 baseY = Utils::SafeCast<S32>(y * mipDiff) + 1;
+					for (S32 i = -halfWindow - (job.WindowSize & 1); i < halfWindow; ++i)
+						rowOffsets.emplace_back(Math::MirrorCoord(Utils::SafeCast<S32>(baseY) + i, Utils::SafeCast<S32>(srcHeight)));
+
+					const U64 offset = rowSize * y;
+					for (U32 x = 0; x < mipWidth; ++x)
+					{
+						// Generate column sampling points
+						std::vector<U32> columnOffsets;
+						columnOffsets.reserve(job.WindowSize);
+
+						const S32 baseX = Utils::SafeCast<S32>(x * mipDiff) + 1;
+						for (S32 i = -halfWindow - (job.WindowSize & 1); i < halfWindow; ++i)
+							columnOffsets.emplace_back(Math::MirrorCoord(Utils::SafeCast<S32>(baseX) + i, Utils::SafeCast<S32>(srcWidth)));
+
+						// Generate samples inside window
+						std::vector<Float4> samples;
+						samples.reserve(static_cast<U64>(job.WindowSize) * job.WindowSize);
+						for (U64 rowOffset : rowOffsets)
+						{
+							for (U32 colOffset : columnOffsets)
+							{
+								Sample sample = GetPixelSample(srcBuffer + colOffset * pixelSize + rowOffset * srcRowSize, channelSize, channelCount, job.GammaCorrection);
+								// Convert to float for processing
+								samples.emplace_back(ConvertToFloat(sample, format, channelCount));
+							}
+						}
+
+						Float4 mipVal = {};
+						Math::XMStoreFloat4(&mipVal, Math::ApplyFilter(job.Filter, samples, 0.5f, 0.5f, &filterCoeffs));
+						StorePixel(mipGenBuffer + static_cast<U64>(x) * pixelSize + offset, mipVal, job, format, channelCount, channelSize);
+					}
+				}
+			}
+		};
+
+	// Mips are split into bands of full rows so separable filters can reuse horizontally filtered rows inside the band
+	auto addMipTiles = [&](std::vector<ToolTile>& tiles, U16 mip)
+		{
+			const U32 mipWidth = std::max(surface.GetWidth() >> mip, 1U);
+			const U32 mipHeight = std::max(surface.GetHeight() >> mip, 1U);
+			for (U16 a = 0; a < surface.GetArraySize(); ++a)
+				ToolRuntime::AddTiles(tiles, mipWidth, mipHeight, mipWidth, MIP_TILE_ROWS, a, mip);
+		};
+
+	std::vector<ToolTile> tiles;
+	if (job.SrcOriginalLayer)
+	{
+		// All mips are computed from the first one so they can be processed at once
+		for (U16 mip = 1; mip < surface.GetMipCount(); ++mip)
+			addMipTiles(tiles, mip);
+		runtime.ForEachTile(tiles, generate);
+	}
+	else
+	{
+		// Every mip reads the previous one so they have to be finished in order
+		for (U16 mip = 1; mip < surface.GetMipCount(); ++mip)
+		{
+			tiles.clear();
+			addMipTiles(tiles, mip);
+			runtime.ForEachTile(tiles, generate);
+		}
+	}
+
+	if (surface.Save(job.OutFile))
+	{
+		Logger::Info("Saved texture to file \"" + std::string(job.OutFile) + "\"");
+		return ResultCode::Success;
+	}
+	Logger::Error("Error saving to \"" + std::string(job.OutFile) + "\"!");
+	return ResultCode::CannotSaveFile;
+}
+
+ResultCode RunStreamJob(const MipParams& job, const std::vector<float>& filterTaps) noexcept
+{
+	// Rows of source texture read at once and maximal size of output rows gathered by single mip level before writing them
+	constexpr U64 SOURCE_BAND_SIZE = 16ULL << 20;
+	constexpr U64 MIP_BAND_SIZE = 1ULL << 20;
+
+	if (job.SrcOriginalLayer)
+		Logger::Warning("Streaming mode always generates mips from previous level, ignoring source original layer option.");
+	if (job.Cores > 1)
+		Logger::Warning("Streaming mode processes texture on single thread, ignoring number of cores.");
+
+	FILE* source = fopen(job.Source.data(), "rb");
+	if (!source)
+	{
+		Logger::Error("Cannot open file \"" + std::string(job.Source) + "\"!");
+		return ResultCode::CannotLoadFile;
+	}
+	DDS::FileData srcData = {};
+	if (DDS::ParseFileHeader(source, srcData) != DDS::FileResult::Ok)
+	{
+		fclose(source);
+		Logger::Error("Cannot parse file \"" + std::string(job.Source) + "\", streaming mode requires DDS texture!");
+		return ResultCode::CannotLoadFile;
+	}
+	const U64 srcDataOffset = static_cast<U64>(ftell(source));
+
+	const U16 mipCount = Math::GetMipLevels(srcData.Width, srcData.Height);
+	if (Utils::IsCompressedFormat(srcData.Format) || mipCount == 1)
+	{
+		fclose(source);
+		Logger::Error("Source texture must be uncompressed and have at least 2 mip levels to generate missing mips!");
+		return ResultCode::CannotPerformOperation;
+	}
+
+	// Source cannot be overwritten while it's still read, result is moved in it's place at the end
+	std::error_code errorCode;
+	const bool inPlace = std::filesystem::equivalent(job.Source, job.OutFile, errorCode);
+	const std::string outFile = std::string(job.OutFile) + (inPlace ? ".stream" : "");
+	FILE* output = fopen(outFile.c_str(), "wb");
+	if (!output)
+	{
+		fclose(source);
+		Logger::Error("Cannot open file \"" + outFile + "\"!");
+		return ResultCode::CannotSaveFile;
+	}
+
+	const DDS::SurfaceData destData = { srcData.Format, srcData.Alpha, srcData.Width, srcData.Height, srcData.Depth, mipCount, srcData.ArraySize, nullptr };
+	const U8 channelCount = Utils::GetChannelCount(srcData.Format);
+	const PixelFormat format = Utils::GetSingleChannelFormat(srcData.Format);
+	const U8 pixelSize = Utils::GetFormatBitCount(srcData.Format) / 8;
+	const U8 channelSize = pixelSize / channelCount;
+	const S32 halfWindow = Utils::SafeCast<S32>(job.WindowSize) >> 1;
+
+	// Remaining filters average whole window so they can be applied as separable ones with uniform taps,
+	// for gamma average samples are squared before filtering and final sum is scaled after taking square root
+	std::vector<float> taps = filterTaps;
+	if (taps.empty())
+		taps.assign(job.WindowSize, job.Filter == Math::FilterType::GammaAverage ? 1.0f : 1.0f / static_cast<float>(job.WindowSize));
+	const float gammaAverageScale = 1.0f / static_cast<float>(job.WindowSize * job.WindowSize);
+
+	// Memory used by levels is fixed for whole texture, only sliding window of rows is kept for every level
+	std::vector<StreamLevel> levels(mipCount - 1);
+	for (U16 mip = 1; mip < mipCount; ++mip)
+	{
+		StreamLevel& level = levels.at(mip - 1);
+		level.SrcWidth = std::max(srcData.Width >> (mip - 1), 1U);
+		level.SrcHeight = std::max(srcData.Height >> (mip - 1), 1U);
+		level.Width = std::max(srcData.Width >> mip, 1U);
+		level.Height = std::max(srcData.Height >> mip, 1U);
+
+		U32 rowCount = 0;
+		DDS::GetSurfaceInfo(level.Width, level.Height, srcData.Format, level.RowSize, rowCount);
+		level.BandRows = Utils::SafeCast<U32>(std::clamp<U64>(MIP_BAND_SIZE / level.RowSize, 1, level.Height));
+
+		level.ColumnOffsets.resize(static_cast<U64>(level.Width) * job.WindowSize);
+		for (U32 x = 0, i = 0; x < level.Width; ++x)
+		{
+			const S32 baseX = Utils::SafeCast<S32>(x * 2) + 1;
+			for (S32 j = -halfWindow - (job.WindowSize & 1); j < halfWindow; ++j, ++i)
+				level.ColumnOffsets.at(i) = Math::MirrorCoord(baseX + j, Utils::SafeCast<S32>(level.SrcWidth));
+		}
+		level.WindowRows.resize(job.WindowSize);
+		level.Line.resize(level.SrcWidth);
+		level.FilteredRows.resize(static_cast<U64>(level.Width) * job.WindowSize);
+		level.MipRow.resize(level.Width);
+		level.Band.resize(static_cast<U64>(level.BandRows) * level.RowSize);
+	}
+
+	U64 activeLevels = 0;
+	auto writeBand = [&](StreamLevel& level, U32 rowCount) -> bool
+		{
+			return SeekFile(output, level.FileOffset + static_cast<U64>(level.BandStart) * level.RowSize)
+				&& fwrite(level.Band.data(), static_cast<U64>(rowCount) * level.RowSize, 1, output) == 1;
+		};
+
+	// Filters row present in the line of the level and produces all output rows that have complete window,
+	// every new output row is passed down to the next level
+	auto feedRow = [&](auto& feedRow, U64 levelIndex) -> bool
+		{
+			StreamLevel& level = levels.at(levelIndex);
+			const U32 srcRow = level.ReceivedRows++;
+			const U32 srcSlot = srcRow % job.WindowSize;
+			if (job.Filter == Math::FilterType::GammaAverage)
+			{
+				for (Float4& pixel : level.Line)
+					pixel = { pixel.x * pixel.x, pixel.y * pixel.y, pixel.z * pixel.z, pixel.w * pixel.w };
+			}
+			MipFilter::FilterRow(level.Line.data(), level.FilteredRows.data() + static_cast<U64>(srcSlot) * level.Width, level.ColumnOffsets.data(), taps.data(), job.WindowSize, level.Width);
+			level.FilteredRowIndices.at(srcSlot) = srcRow;
+
+			while (level.NextRow < level.Height)
+			{
+				// Window spans at most window size rows so none of them is evicted from the ring before it's complete
+				U32 lastRow = 0;
+				const S32 baseY = Utils::SafeCast<S32>(level.NextRow * 2) + 1;
+				for (S32 i = -halfWindow - (job.WindowSize & 1), tap = 0; i < halfWindow; ++i, ++tap)
+				{
+					level.WindowRows.at(tap) = Math::MirrorCoord(baseY + i, Utils::SafeCast<S32>(level.SrcHeight));
+					lastRow = std::max(lastRow, level.WindowRows.at(tap));
+				}
+				if (lastRow >= level.ReceivedRows)
+					break;
+
+				std::fill(level.MipRow.begin(), level.MipRow.end(), Float4(0.0f, 0.0f, 0.0f, 0.0f));
+				for (U32 tap = 0; tap < job.WindowSize; ++tap)
+				{
+					const U32 slot = level.WindowRows.at(tap) % job.WindowSize;
+					ZE_ASSERT(level.FilteredRowIndices.at(slot) == level.WindowRows.at(tap), "Source row already evicted from the window!");
+					MipFilter::AccumulateRow(level.FilteredRows.data() + static_cast<U64>(slot) * level.Width, level.MipRow.data(), taps.at(tap), level.Width);
+				}
+				if (job.Filter == Math::FilterType::GammaAverage)
+				{
+					for (Float4& pixel : level.MipRow)
+						pixel = { std::sqrt(pixel.x) * gammaAverageScale, std::sqrt(pixel.y) * gammaAverageScale, std::sqrt(pixel.z) * gammaAverageScale, std::sqrt(pixel.w) * gammaAverageScale };
+				}
+				else if (job.Filter == Math::FilterType::Bilinear)
+				{
+					for (Float4& pixel : level.MipRow)
+						pixel = { std::abs(pixel.x), std::abs(pixel.y), std::abs(pixel.z), std::abs(pixel.w) };
+				}
+
+				const U32 bandRow = level.NextRow++ - level.BandStart;
+				U8* mipRow = level.Band.data() + static_cast<U64>(bandRow) * level.RowSize;
+				for (U32 x = 0; x < level.Width; ++x)
+					StorePixel(mipRow + static_cast<U64>(x) * pixelSize, level.MipRow.at(x), job, format, channelCount, channelSize);
+
+				// Next level reads back stored row so it's source is the same as when generating from whole texture in memory
+				if (levelIndex + 1 < activeLevels)
+				{
+					StreamLevel& nextLevel = levels.at(levelIndex + 1);
+					for (U32 x = 0; x < level.Width; ++x)
+						nextLevel.Line.at(x) = ConvertToFloat(GetPixelSample(mipRow + static_cast<U64>(x) * pixelSize, channelSize, channelCount, job.GammaCorrection), format, channelCount);
+					if (!feedRow(feedRow, levelIndex + 1))
+						return false;
+				}
+
+				if (bandRow + 1 == level.BandRows || level.NextRow == level.Height)
+				{
+					if (!writeBand(level, bandRow + 1))
+						return false;
+					level.BandStart = level.NextRow;
+				}
+			}
+			return true;
+		};
+
+	auto processTexture = [&]() -> ResultCode
+		{
+			if (DDS::EncodeFileHeader(output, destData) != DDS::FileResult::Ok)
+				return ResultCode::CannotSaveFile;
+			const U64 destDataOffset = static_cast<U64>(ftell(output));
+
+			U32 srcRowSize = 0, srcRowCount = 0;
+			DDS::GetSurfaceInfo(srcData.Width, srcData.Height, srcData.Format, srcRowSize, srcRowCount);
+			const U32 bandRows = Utils::SafeCast<U32>(std::clamp<U64>(SOURCE_BAND_SIZE / srcRowSize, 1, srcRowCount));
+			std::vector<U8> band(static_cast<U64>(bandRows) * srcRowSize);
+
+			// Every depth slice of every array element is processed separately as single pass over rows of it's top level
+			for (U16 a = 0; a < srcData.ArraySize; ++a)
+			{
+				for (U16 d = 0; d < srcData.Depth; ++d)
+				{
+					activeLevels = 0;
+					for (U16 mip = 1; mip < mipCount && d < std::max(srcData.Depth >> mip, 1); ++mip)
+					{
+						StreamLevel& level = levels.at(activeLevels++);
+						level.FileOffset = destDataOffset + DDS::GetImageFileOffset(destData.Width, destData.Height, destData.Depth, destData.MipCount, srcData.Format, a, mip, d);
+						level.ReceivedRows = 0;
+						level.NextRow = 0;
+						level.BandStart = 0;
+						level.FilteredRowIndices.assign(job.WindowSize, UINT32_MAX);
+					}
+
+					const U64 destOffset = destDataOffset + DDS::GetImageFileOffset(destData.Width, destData.Height, destData.Depth, destData.MipCount, srcData.Format, a, 0, d);
+					if (!SeekFile(source, srcDataOffset + DDS::GetImageFileOffset(srcData.Width, srcData.Height, srcData.Depth, srcData.MipCount, srcData.Format, a, 0, d)))
+						return ResultCode::CannotLoadFile;
+
+					for (U32 row = 0; row < srcRowCount; row += bandRows)
+					{
+						const U32 rowCount = std::min(bandRows, srcRowCount - row);
+						const U64 bandSize = static_cast<U64>(rowCount) * srcRowSize;
+						if (fread(band.data(), bandSize, 1, source) != 1)
+							return ResultCode::CannotLoadFile;
+
+						// Top level is copied without changes
+						if (!SeekFile(output, destOffset + static_cast<U64>(row) * srcRowSize) || fwrite(band.data(), bandSize, 1, output) != 1)
+							return ResultCode::CannotSaveFile;
+
+						for (U32 i = 0; i < rowCount && activeLevels; ++i)
+						{
+							U8* srcRow = band.data() + static_cast<U64>(i) * srcRowSize;
+							StreamLevel& level = levels.front();
+							for (U32 x = 0; x < level.SrcWidth; ++x)
+								level.Line.at(x) = ConvertToFloat(GetPixelSample(srcRow + static_cast<U64>(x) * pixelSize, channelSize, channelCount, job.GammaCorrection), format, channelCount);
+							if (!feedRow(feedRow, 0))
+								return ResultCode::CannotSaveFile;
+						}
+					}
+				}
+			}
+			return ResultCode::Success;
+		};
+
+	ResultCode result = processTexture();
+	fclose(source);
+	if (fclose(output) != 0 && result == ResultCode::Success)
+		result = ResultCode::CannotSaveFile;
+
+	if (inPlace)
+	{
+		if (result == ResultCode::Success)
+		{
+			std::filesystem::rename(outFile, job.OutFile, errorCode);
+			if (errorCode)
+				result = ResultCode::CannotSaveFile;
+		}
+		if (result != ResultCode::Success)
+			std::filesystem::remove(outFile, errorCode);
+	}
+
+	switch (result)
+	{
+	case ResultCode::Success:
+	{
+		Logger::Info("Saved texture to file \"" + std::string(job.OutFile) + "\"");
+		break;
+	}
+	case ResultCode::CannotLoadFile:
+	{
+		Logger::Error("Error reading from \"" + std::string(job.Source) + "\"!");
+		break;
+	}
+	default:
+	{
+		Logger::Error("Error saving to \"" + std::string(job.OutFile) + "\"!");
+		break;
+	}
+	}
+	return result;
+}
+
+bool SeekFile(FILE* file, U64 offset) noexcept
+{
+#if _ZE_PLATFORM_WINDOWS
+	return _fseeki64(file, static_cast<S64>(offset), SEEK_SET) == 0;
+#else
+	return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+Sample GetPixelSample(U8* memory, U8 channelSize, U8 channelCount, bool gammaCorrection) noexcept
+{
+	Sample pixelValue = {};
+	pixelValue.RGBA[0].UInt = 0;
+	pixelValue.RGBA[1].UInt = 0;
+	pixelValue.RGBA[2].UInt = 0;
+	pixelValue.RGBA[3].UInt = 0;
+
+	for (U8 i = 0; i < channelCount; ++i)
+	{
+		for (U8 j = 0; j < channelSize; ++j)
+			pixelValue.RGBA[i].UInt |= static_cast<U32>(memory[j]) << (j * 8);
+		memory += channelSize;
+	}
+	return pixelValue;
+}
+
+Float4 ConvertToFloat(const Sample& pixel, PixelFormat format, U8 channelCount) noexcept
+{
+	Sample val = {};
+	switch (format)
+	{
+	default:
+	ZE_ENUM_UNHANDLED();
+	case PixelFormat::Unknown:
+	ZE_FAIL("Unsupported pixel format for float convertion!");
+	[[fallthrough]];
+	case PixelFormat::R32_Float:
+	{
+		std::memcpy(&val, &pixel, sizeof(Sample));
+		break;
+	}
+	case PixelFormat::R32_UInt:
+	case PixelFormat::R16_UInt:
+	case PixelFormat::R8_UInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].UInt);
+		break;
+	}
+	case PixelFormat::R32_SInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].SInt32);
+		break;
+	}
+	case PixelFormat::R16_SInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].SInt16);
+		break;
+	}
+	case PixelFormat::R8_SInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].SInt8);
+		break;
+	}
+	case PixelFormat::R16_UNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].UInt) / UINT16_MAX;
+		break;
+	}
+	case PixelFormat::R8_UNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].UInt) / UINT8_MAX;
+		break;
+	}
+	case PixelFormat::R16_SNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].SInt16) / INT16_MAX;
+		break;
+	}
+	case PixelFormat::R8_SNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = static_cast<float>(pixel.RGBA[i].UInt) / INT8_MAX;
+		break;
+	}
+	case PixelFormat::R16_Float:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			val.RGBA[i].Float = Math::FP16::DecodeFloat16(static_cast<U16>(pixel.RGBA[i].UInt));
+		break;
+	}
+	}
+	return { val.RGBA[0].Float, val.RGBA[1].Float, val.RGBA[2].Float, val.RGBA[3].Float };
+}
+
+Sample ConvertToSourceFormat(const Float4& val, PixelFormat format, U8 channelCount, bool gammaCorrection) noexcept
+{
+	Sample pixel = {};
+	pixel.RGBA[0].Float = val.x;
+	pixel.RGBA[1].Float = val.y;
+	pixel.RGBA[2].Float = val.z;
+	pixel.RGBA[3].Float = val.w;
+	switch (format)
+	{
+	default:
+	ZE_ENUM_UNHANDLED();
+	case PixelFormat::Unknown:
+	ZE_FAIL("Unsupported pixel format for converting from float!");
+	[[fallthrough]];
+	case PixelFormat::R32_Float:
+	break;
+	case PixelFormat::R32_UInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].UInt = static_cast<U32>(std::clamp(static_cast<U64>(pixel.RGBA[i].Float), 0ULL, static_cast<U64>(UINT32_MAX)));
+		break;
+	}
+	case PixelFormat::R16_UInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].UInt = static_cast<U32>(std::clamp(static_cast<U64>(pixel.RGBA[i].Float), 0ULL, static_cast<U64>(UINT16_MAX)));
+		break;
+	}
+	case PixelFormat::R8_UInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].UInt = static_cast<U32>(std::clamp(static_cast<U64>(pixel.RGBA[i].Float), 0ULL, static_cast<U64>(UINT8_MAX)));
+		break;
+	}
+	case PixelFormat::R32_SInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].SInt32 = static_cast<S32>(std::clamp(static_cast<S64>(pixel.RGBA[i].Float), static_cast<S64>(INT32_MIN), static_cast<S64>(INT32_MAX)));
+		break;
+	}
+	case PixelFormat::R16_SInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].SInt16 = static_cast<S16>(std::clamp(static_cast<S64>(pixel.RGBA[i].Float), static_cast<S64>(INT16_MIN), static_cast<S64>(INT16_MAX)));
+		break;
+	}
+	case PixelFormat::R8_SInt:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].SInt8 = static_cast<S8>(std::clamp(static_cast<S64>(pixel.RGBA[i].Float), static_cast<S64>(INT8_MIN), static_cast<S64>(INT8_MAX)));
+		break;
+	}
+	case PixelFormat::R16_UNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].UInt = static_cast<U32>(pixel.RGBA[i].Float * UINT16_MAX);
+		break;
+	}
+	case PixelFormat::R8_UNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].UInt = static_cast<U32>(pixel.RGBA[i].Float * UINT8_MAX);
+		break;
+	}
+	case PixelFormat::R16_SNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].SInt16 = static_cast<S16>(pixel.RGBA[i].Float * INT16_MAX);
+		break;
+	}
+	case PixelFormat::R8_SNorm:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].SInt8 = static_cast<S8>(pixel.RGBA[i].Float * INT8_MAX);
+		break;
+	}
+	case PixelFormat::R16_Float:
+	{
+		for (U8 i = 0; i < channelCount; ++i)
+			pixel.RGBA[i].UInt = Math::FP16::EncodeFloat16(pixel.RGBA[i].Float);
+		break;
+	}
+	}
+	return pixel;
+}
+
+void StorePixel(U8* pixelAddress, Float4 mipVal, const MipParams& job, PixelFormat format, U8 channelCount, U8 channelSize) noexcept
+{
+	// https://asawicki.info/articles/alpha_test.php5
+	if (channelCount == 4 && job.AlphaTestTreshold != FLT_MAX)
+		mipVal.w = std::max(mipVal.w, (mipVal.w + 2.0f * job.AlphaTestTreshold) / 3.0f);
+
+	// Convert back to original format
+	Sample pixel = ConvertToSourceFormat(mipVal, format, channelCount, job.GammaCorrection);
+	for (U8 i = 0; i < channelCount; ++i)
+		std::memcpy(pixelAddress + i * channelSize, &pixel.RGBA[i].UInt, channelSize);
+}
\ No newline at end of file
@@ -26,8 +26,8 @@ struct JobParams
 	bool Bilinear = false;
 };
 
-ResultCode ProcessJsonCommand(const json::json& command) noexcept;
-ResultCode RunJob(const JobParams& job) noexcept;
+ResultCode ProcessJsonCommand(const json::json& command, JobParams& params) noexcept;
+ResultCode RunJob(const JobParams& job, const ToolRuntime& runtime) noexcept;
 
 int main(int argc, char* argv[])
 {
@@ -43,6 +43,9 @@ int main(int argc, char* argv[])
 	parser.AddString("json", "", 'j');
 	parser.Parse(argc, argv);
 
+	// Jobs from JSON batch file are run together with the one from command line, JSON data have to outlive them
+	std::vector<JobParams> jobs;
+	json::json jsonArray;
 	std::string_view json = parser.GetString("json");
 	if (!json.empty())
 	{
@@ -54,22 +57,22 @@ int main(int argc, char* argv[])
 		}
 		else
 		{
-			json::json jsonArray;
 			fin >> jsonArray;
-			ResultCode retCode = ResultCode::Success;
 			if (jsonArray.is_array())
 			{
 				for (const auto& item : jsonArray)
 				{
-					retCode = ProcessJsonCommand(item);
+					ResultCode retCode = ProcessJsonCommand(item, jobs.emplace_back());
 					if (retCode != ResultCode::Success)
 						return retCode;
 				}
 			}
 			else
-				retCode = ProcessJsonCommand(jsonArray);
-			if (retCode != ResultCode::Success)
-				return retCode;
+			{
+				ResultCode retCode = ProcessJsonCommand(jsonArray, jobs.emplace_back());
+				if (retCode != ResultCode::Success)
+					return retCode;
+			}
 		}
 	}
 
@@ -77,28 +80,41 @@ int main(int argc, char* argv[])
 	params.Source = parser.GetString("source");
 	if (params.Source.empty())
 	{
-		if (!json.empty())
-			return ResultCode::Success;
-		Logger::Error("No source file specified!");
-		return ResultCode::NoSourceFile;
+		if (json.empty())
+		{
+			Logger::Error("No source file specified!");
+			return ResultCode::NoSourceFile;
+		}
+	}
+	else
+	{
+		params.OutFile = parser.GetString("out");
+		if (params.OutFile.empty())
+			params.OutFile = params.Source;
+		params.Cores = parser.GetNumber("cores");
+		params.NoAlpha = parser.GetOption("no-alpha");
+		params.FlipY = parser.GetOption("flip-y");
+		params.HdriCubemap = parser.GetOption("hdri-cubemap");
+		params.Fp16 = parser.GetOption("fp16");
+		params.Bilinear = parser.GetOption("bilinear");
+		jobs.emplace_back(params);
 	}
 
-	params.OutFile = parser.GetString("out");
-	if (params.OutFile.empty())
-		params.OutFile = params.Source;
-	params.Cores = parser.GetNumber("cores");
-	params.NoAlpha = parser.GetOption("no-alpha");
-	params.FlipY = parser.GetOption("flip-y");
-	params.HdriCubemap = parser.GetOption("hdri-cubemap");
-	params.Fp16 = parser.GetOption("fp16");
-	params.Bilinear = parser.GetOption("bilinear");
-
-	return RunJob(params);
+	U32 cores = parser.GetNumber("cores");
+	std::vector<ToolJobFiles> jobFiles;
+	jobFiles.reserve(jobs.size());
+	for (const JobParams& job : jobs)
+	{
+		cores = std::max(cores, job.Cores);
+		jobFiles.push_back({ { job.Source }, { job.OutFile } });
+	}
+
+	ToolRuntime runtime(cores);
+	return runtime.RunBatch(jobFiles, [&](U64 i) { return RunJob(jobs.at(i), runtime); });
 }
 
-ResultCode ProcessJsonCommand(const json::json& command) noexcept
+ResultCode ProcessJsonCommand(const json::json& command, JobParams& params) noexcept
 {
-	JobParams params = {};
 	if (command.contains("source"))
 		params.Source = command["source"].get<std::string_view>();
 	else
@@ -124,11 +140,10 @@ ResultCode ProcessJsonCommand(const json::json& command) noexcept
 		params.Fp16 = command["fp16"].get<bool>();
 	if (command.contains("bilinear"))
 		params.Bilinear = command["bilinear"].get<bool>();
-
-	return RunJob(params);
+	return ResultCode::Success;
 }
 
-ResultCode RunJob(const JobParams& job) noexcept
+ResultCode RunJob(const JobParams& job, const ToolRuntime& runtime) noexcept
 {
 	// Early out if nothing to do
 	if (!job.NoAlpha && !job.FlipY && !job.HdriCubemap)
@@ -174,7 +189,7 @@ ResultCode RunJob(const JobParams& job) noexcept
 
 		GFX::Surface cubemap(surface.GetWidth() / 2, surface.GetHeight(), 1, 1, 6, job.Fp16 ? PixelFormat::R16G16B16A16_Float : PixelFormat::R32G32B32_Float, false);
 
-		TexOps::ConvertToCubemap(surface, cubemap, job.Cores, job.Bilinear, job.Fp16);
+		TexOps::ConvertToCubemap(surface, cubemap, runtime, job.Bilinear, job.Fp16);
 		Logger::Info("Converted to 6-faced cubemap");
 		saved = cubemap.Save(job.OutFile);
 	}
@@ -193,7 +208,7 @@ ResultCode RunJob(const JobParams& job) noexcept
 			return ResultCode::CannotPerformOperation;
 		}
 
-		TexOps::SimpleProcess(surface, job.Cores, job.NoAlpha, job.FlipY);
+		TexOps::SimpleProcess(surface, runtime, job.NoAlpha, job.FlipY);
 
 		if (job.NoAlpha)
 			Logger::Info("Alpha channel reseted.");